@@ -187,12 +187,27 @@ LOCAL_SRC_FILES := \
         dex2c/DtcDexLiveWeb.cpp \
         dex2c/DtcDexMethod.cpp \
         dex2c/DtcDexcode.cpp \
+        dex2c/DtcDexInsnTable.cpp \
+        dex2c/DtcDexOpcode.cpp \
         dex2c/DtcCExpression.cpp \
         dex2c/DtcCStatement.cpp \
         dex2c/DtcCSymbol.cpp \
+        dex2c/DtcCSymbolTable.cpp \
         dex2c/DtcCBasicBlock.cpp \
         dex2c/DtcCMethod.cpp \
+        dex2c/DtcCodeBuffer.cpp \
 	dex2c/DtcDebug.cpp \
+        dex2c/DtcNativeAssembler.cpp \
+        dex2c/DtcNativeEmitter.cpp \
+        dex2c/DtcThreadPool.cpp \
+        dex2c/DtcArena.cpp \
+        dex2c/DtcCompilerContext.cpp \
+        dex2c/DtcProfiler.cpp \
+        dex2c/DtcRuntime.cpp \
+        dex2c/DtcBridge.cpp \
+        dex2c/DtcCallCell.cpp \
+        dex2c/DtcStats.cpp \
+        dex2c/DtcOutcome.cpp \
         dex2c/DtcNode.cpp 
 
 # TODO: this is the wrong test, but what's the right one?
@@ -0,0 +1,180 @@
+/*********************************************************************
+*   DtcArena.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <pthread.h>
+
+#include "DtcArena.h"
+
+///////////////////////////////////////////////////////////////////////
+// Static Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+// The key of the arena bound to each thread
+static pthread_key_t s_nArenaKey;
+static pthread_once_t s_nArenaKeyOnce = PTHREAD_ONCE_INIT;
+
+// The tags in front of the objects telling where they are allocated
+#define DTC_ARENA_TAG_HEAP		0x48454150
+#define DTC_ARENA_TAG_ARENA		0x4152454E
+
+static void
+CreateArenaKey() {
+
+	pthread_key_create(&s_nArenaKey, NULL);
+}
+
+///////////////////////////////////////////////////////////////////////
+// DtcArena Class Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcArena::DtcArena() {
+
+	m_rChunkList.clear();
+	m_rLargeList.clear();
+
+	m_nChunk = 0;
+	m_nOffset = 0;
+}
+
+DtcArena::~DtcArena() {
+
+	Reset();
+
+	for(uint32_t i = 0; i < m_rChunkList.size(); i++) {
+		free(m_rChunkList[i]);
+	}
+
+	m_rChunkList.clear();
+}
+
+/**
+ * This function will return the arena bound to the calling thread.
+ *
+ * @return the arena (NULL if no arena is bound)
+ */
+DtcArena *
+DtcArena::GetCurrent() {
+
+	pthread_once(&s_nArenaKeyOnce, CreateArenaKey);
+
+	return (DtcArena *)pthread_getspecific(s_nArenaKey);
+}
+
+/**
+ * This function will bind the given arena to the calling thread.
+ *
+ * @param pArena the arena (NULL to allocate from the heap)
+ */
+void
+DtcArena::SetCurrent(DtcArena *pArena) {
+
+	pthread_once(&s_nArenaKeyOnce, CreateArenaKey);
+
+	pthread_setspecific(s_nArenaKey, pArena);
+}
+
+/**
+ * This function will allocate a block of memory from the arena.
+ *
+ * @param nSize the size of the block in bytes
+ * @return the address of the block (NULL if out of memory)
+ */
+void *
+DtcArena::Alloc(size_t nSize) {
+
+	nSize = (nSize + DTC_ARENA_ALIGN - 1) & ~(size_t)(DTC_ARENA_ALIGN - 1);
+
+	if(nSize > DTC_ARENA_CHUNK_SIZE) {
+
+		uint8_t *block = (uint8_t *)malloc(nSize);
+
+		if(block != NULL) m_rLargeList.push_back(block);
+
+		return block;
+	}
+
+	// Move to the next chunk, which is allocated only once over the resets
+	if(m_nChunk >= m_rChunkList.size() || m_nOffset + nSize > DTC_ARENA_CHUNK_SIZE) {
+
+		if(m_nChunk < m_rChunkList.size()) m_nChunk++;
+
+		if(m_nChunk == m_rChunkList.size()) {
+
+			uint8_t *chunk = (uint8_t *)malloc(DTC_ARENA_CHUNK_SIZE);
+
+			if(chunk == NULL) return NULL;
+
+			m_rChunkList.push_back(chunk);
+		}
+
+		m_nOffset = 0;
+	}
+
+	void *block = m_rChunkList[m_nChunk] + m_nOffset;
+	m_nOffset += nSize;
+
+	return block;
+}
+
+/**
+ * This function will release all the blocks allocated from the arena at once.
+ * The chunks are kept to be reused by the next compilation.
+ */
+void
+DtcArena::Reset() {
+
+	for(uint32_t i = 0; i < m_rLargeList.size(); i++) {
+		free(m_rLargeList[i]);
+	}
+
+	m_rLargeList.clear();
+
+	m_nChunk = 0;
+	m_nOffset = 0;
+}
+
+///////////////////////////////////////////////////////////////////////
+// DtcArenaObject Class Definition
+///////////////////////////////////////////////////////////////////////
+
+void *
+DtcArenaObject::operator new(size_t nSize) throw() {
+
+	DtcArena *arena = DtcArena::GetCurrent();
+	uint32_t *block = NULL;
+
+	// The tag keeps the alignment of the object
+	if(arena != NULL && (block = (uint32_t *)arena->Alloc(nSize + DTC_ARENA_ALIGN)) != NULL) {
+		block[0] = DTC_ARENA_TAG_ARENA;
+	}
+	else if((block = (uint32_t *)malloc(nSize + DTC_ARENA_ALIGN)) != NULL) {
+		block[0] = DTC_ARENA_TAG_HEAP;
+	}
+	else {
+		DTC_ERROR(DEX2C_TAG, "DtcArenaObject - Invalid memory allocation");
+		return NULL;
+	}
+
+	return (uint8_t *)block + DTC_ARENA_ALIGN;
+}
+
+void
+DtcArenaObject::operator delete(void *pPtr) {
+
+	if(pPtr == NULL) return;
+
+	uint32_t *block = (uint32_t *)((uint8_t *)pPtr - DTC_ARENA_ALIGN);
+
+	if(block[0] == DTC_ARENA_TAG_HEAP) {
+		free(block);
+	}
+}
@@ -0,0 +1,104 @@
+/*********************************************************************
+*   DtcArena.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_ARENA_H_
+#define _DTC_ARENA_H_
+
+#include "DtcCommon.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+#define DTC_ARENA_CHUNK_SIZE		(64 * 1024)
+#define DTC_ARENA_ALIGN			8
+
+typedef vector<uint8_t *> DtcArenaChunkList_t;
+
+///////////////////////////////////////////////////////////////////////
+// DtcArena Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+class DtcArena {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The chunks allocated so far, which are kept across the resets
+	DtcArenaChunkList_t m_rChunkList;
+
+	// The blocks larger than a chunk, which are freed at the reset
+	DtcArenaChunkList_t m_rLargeList;
+
+	// The index of the current chunk and the offset in it
+	uint32_t m_nChunk;
+	uint32_t m_nOffset;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcArena();
+
+	virtual ~DtcArena();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the number of the bytes reserved by the arena.
+	 *
+	 * @return the number of the bytes
+	 */
+	inline uint32_t GetCapacity()	{ return (uint32_t)m_rChunkList.size() * DTC_ARENA_CHUNK_SIZE;	}
+
+	static DtcArena *GetCurrent();
+
+	static void SetCurrent(DtcArena *pArena);
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	void *Alloc(size_t nSize);
+
+	void Reset();
+};
+
+///////////////////////////////////////////////////////////////////////
+// DtcArenaObject Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * The IR classes derived from this class are allocated from the arena bound to the
+ * calling thread, or from the heap if no arena is bound. Deleting an object allocated
+ * from an arena runs its destructor only, and the memory is reclaimed at the reset.
+ * The allocation never throws but yields NULL without running the constructor, since
+ * the VM is built without exceptions, so the result of new must be checked.
+ */
+class DtcArenaObject {
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	static void *operator new(size_t nSize) throw();
+
+	static void operator delete(void *pPtr);
+};
+
+#endif
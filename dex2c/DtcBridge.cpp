@@ -0,0 +1,219 @@
+/*********************************************************************
+*   DtcBridge.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include "DtcBridge.h"
+#include "DtcProfiler.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// The entry stub shared by the methods having the same number of the argument words,
+// which loads the words from the ins of the new frame into the argument registers of
+// the C function installed as the compiled code of the method
+typedef s8 (*DtcEntryStub_t)(const u4 *pIns, void *pFunc);
+
+// The OSR entry of a method taking the frame and the dex pc of a loop header
+typedef s8 (*DtcOsrFunc_t)(u4 *pFp, u4 nPc);
+
+///////////////////////////////////////////////////////////////////////
+// Macro Definition
+///////////////////////////////////////////////////////////////////////
+
+// The parameter types of the C function taking the given number of the argument words
+#define DTC_WORDS_0		void
+#define DTC_WORDS_1		u4
+#define DTC_WORDS_2		DTC_WORDS_1, u4
+#define DTC_WORDS_3		DTC_WORDS_2, u4
+#define DTC_WORDS_4		DTC_WORDS_3, u4
+#define DTC_WORDS_5		DTC_WORDS_4, u4
+#define DTC_WORDS_6		DTC_WORDS_5, u4
+#define DTC_WORDS_7		DTC_WORDS_6, u4
+#define DTC_WORDS_8		DTC_WORDS_7, u4
+
+// The argument words taken from the ins of the frame
+#define DTC_INS_0
+#define DTC_INS_1		pIns[0]
+#define DTC_INS_2		DTC_INS_1, pIns[1]
+#define DTC_INS_3		DTC_INS_2, pIns[2]
+#define DTC_INS_4		DTC_INS_3, pIns[3]
+#define DTC_INS_5		DTC_INS_4, pIns[4]
+#define DTC_INS_6		DTC_INS_5, pIns[5]
+#define DTC_INS_7		DTC_INS_6, pIns[6]
+#define DTC_INS_8		DTC_INS_7, pIns[7]
+
+#define DEFINE_ENTRY_STUB(N)								\
+static s8													\
+EntryStub##N(const u4 *pIns, void *pFunc) {					\
+	return ((s8 (*)(DTC_WORDS_##N))pFunc)(DTC_INS_##N);		\
+}
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/*
+ * The entry stubs, which are shared by all the compiled methods instead of a stub
+ * emitted for each method, since the C functions take every argument as a word
+ */
+DEFINE_ENTRY_STUB(0)
+DEFINE_ENTRY_STUB(1)
+DEFINE_ENTRY_STUB(2)
+DEFINE_ENTRY_STUB(3)
+DEFINE_ENTRY_STUB(4)
+DEFINE_ENTRY_STUB(5)
+DEFINE_ENTRY_STUB(6)
+DEFINE_ENTRY_STUB(7)
+DEFINE_ENTRY_STUB(8)
+
+/**
+ * This function will return the hotness counter of the given method, which is hashed
+ * by its address in the same way as the ARM mterp.
+ *
+ * @param pMethod the method
+ * @param nKind the kind of the counter
+ * @return the counter
+ */
+static inline u2 *
+GetCounter(const Method *pMethod, DtcHotKind_t nKind) {
+
+	uintptr_t addr = (uintptr_t)pMethod;
+	uint32_t index = (uint32_t)(((addr ^ (addr >> 12)) >> 2) & (DTC_PROF_SIZE - 1));
+
+	return &gDtcProfCounters[nKind * DTC_PROF_SIZE + index];
+}
+
+///////////////////////////////////////////////////////////////////////
+// Static Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+// The entry stubs indexed by the number of the argument words (insSize) of the callee
+static const DtcEntryStub_t s_pEntryStubs[DTC_ENTRY_MAX_INS + 1] = {
+	EntryStub0, EntryStub1, EntryStub2, EntryStub3, EntryStub4,
+	EntryStub5, EntryStub6, EntryStub7, EntryStub8
+};
+
+///////////////////////////////////////////////////////////////////////
+// Global Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will run the compiled code of the given method on the new frame set up
+ * by the interpreter. The stub of the number of the argument words is tail-called, and
+ * only the methods having at most DTC_ENTRY_MAX_INS words are entered by the interpreter.
+ * The ARM mterp calls it from .LdtcExecuteCompiledCode.
+ *
+ * @param pNewFp the new frame holding the arguments in its last registers
+ * @param pMethod the compiled callee
+ * @return the value returned by the compiled code
+ */
+extern "C" s8
+dtcEnterCompiledCode(u4 *pNewFp, const Method *pMethod) {
+
+	const u4 *ins = pNewFp + pMethod->registersSize - pMethod->insSize;
+
+	return s_pEntryStubs[pMethod->insSize](ins, pMethod->compiledCode);
+}
+
+/**
+ * This function will be called by the interpreter on an invocation of a non-native
+ * method after the save area of the new frame is set up. A compiled callee is run on
+ * the new frame through the entry stub of its number of the argument words, and the invocation of any other callee is
+ * counted in its hotness counter.
+ *
+ * @param pSelf the running thread
+ * @param pMethod the callee
+ * @param pNewFp the new frame holding the arguments
+ * @param ppResumePc the pc where the interpreter resumes the callee (output)
+ * @return how the interpreter continues
+ */
+extern "C" DtcBridgeResult_t
+dtcInvokeMethod(Thread *pSelf, Method *pMethod, u4 *pNewFp, const u2 **ppResumePc) {
+
+	void *entry = pMethod->compiledCode;
+
+	// The compiler thread publishes the flag after the code, so a target without any
+	// code is only marked by hand and interpreted until it becomes hot
+	if((pMethod->accessFlags & ACC_COMPILE_TARGET) == 0 || entry == NULL) {
+
+		u2 *counter = GetCounter(pMethod, DTC_HOT_INVOKE);
+
+		if(--*counter == 0) {
+			dtcProfileHotMethod(pMethod, counter);
+		}
+
+		return DTC_BRIDGE_INTERPRET;
+	}
+
+	StackSaveArea *saveArea = SAVEAREA_FROM_FP(pNewFp);
+
+	// The compiled code sets currentPc of the new frame only when it deoptimizes
+	pSelf->interpSave.curFrame = pNewFp;
+	saveArea->xtra.currentPc = NULL;
+
+	s8 result = dtcEnterCompiledCode(pNewFp, pMethod);
+
+	if(saveArea->xtra.currentPc != NULL) {
+
+		// A callee deoptimizing in a direct call leaves its frame on top of the new frame,
+		// and the interpreter resumes the top frame, which returns to the others in turn
+		*ppResumePc = SAVEAREA_FROM_FP(pSelf->interpSave.curFrame)->xtra.currentPc;
+		return DTC_BRIDGE_RESUME;
+	}
+
+	pSelf->interpSave.retval.j = result;
+	pSelf->interpSave.curFrame = saveArea->prevFrame;
+
+	return DTC_BRIDGE_RETURNED;
+}
+
+/**
+ * This function will be called by the interpreter on a backward branch. The branch is
+ * counted in the backward branch counter of the method, and the loop continues in the
+ * compiled code if the counter expires at a loop header having an OSR entry.
+ *
+ * @param pSelf the running thread
+ * @param pMethod the running method
+ * @param pFp the frame of the method
+ * @param pPc the target of the branch
+ * @param ppResumePc the pc where the interpreter resumes the method (output)
+ * @return how the interpreter continues
+ */
+extern "C" DtcBridgeResult_t
+dtcBranchBackward(Thread *pSelf, Method *pMethod, u4 *pFp, const u2 *pPc,
+	const u2 **ppResumePc) {
+
+	u2 *counter = GetCounter(pMethod, DTC_HOT_BRANCH);
+
+	if(--*counter != 0) return DTC_BRIDGE_INTERPRET;
+
+	void *entry = dtcProfileHotLoop(pMethod, counter, pPc);
+
+	if(entry == NULL) return DTC_BRIDGE_INTERPRET;
+
+	StackSaveArea *saveArea = SAVEAREA_FROM_FP(pFp);
+
+	saveArea->xtra.currentPc = NULL;
+
+	s8 result = ((DtcOsrFunc_t)entry)(pFp, (u4)(pPc - pMethod->insns));
+
+	if(saveArea->xtra.currentPc != NULL) {
+
+		*ppResumePc = SAVEAREA_FROM_FP(pSelf->interpSave.curFrame)->xtra.currentPc;
+		return DTC_BRIDGE_RESUME;
+	}
+
+	// The compiled code has finished the method, which the interpreter returns from
+	pSelf->interpSave.retval.j = result;
+
+	return DTC_BRIDGE_RETURNED;
+}
@@ -0,0 +1,81 @@
+/*********************************************************************
+*   DtcBridge.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_BRIDGE_H_
+#define _DTC_BRIDGE_H_
+
+#include "DtcCommon.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// The results of the bridge, which tell the interpreter how to continue
+typedef enum {
+
+	// The callee is not compiled, so the interpreter runs it on the new frame
+	DTC_BRIDGE_INTERPRET = 0,
+
+	// The compiled code has returned and the return value is in interpSave.retval
+	DTC_BRIDGE_RETURNED,
+
+	// The compiled code has deoptimized, so the interpreter resumes at the returned pc on
+	// interpSave.curFrame, throwing the pending exception if any. It is the frame given to
+	// the bridge unless a callee has deoptimized in a direct call from the compiled code,
+	// where it is the frame of the callee running the method of its save area
+	DTC_BRIDGE_RESUME
+
+} DtcBridgeResult_t;
+
+///////////////////////////////////////////////////////////////////////
+// Global Function Declaration
+///////////////////////////////////////////////////////////////////////
+
+// The entry of the compiled code on the new frame, which the ARM mterp calls
+extern "C" s8 dtcEnterCompiledCode(u4 *pNewFp, const Method *pMethod);
+
+/*
+ * The invoke bridge in C, which does the same as .LdtcInvokeMethod and .LdtcEnterOsr
+ * of the ARM mterp for the interpreters without any dex2c hook in assembly, i.e. the
+ * x86 mterp and the portable interpreter (InterpC-allstubs). Both are called with the
+ * plain C calling convention, so the x86 mterp could call them like the other C helpers.
+ *
+ * The bridge is not wired yet: no interpreter calls dtcInvokeMethod or dtcBranchBackward,
+ * so only the ARM mterp runs the compiled code, and the other interpreters neither count
+ * the hotness nor enter any compiled method. The sketches below show where the hooks go.
+ *
+ * The invoke hook goes where the interpreter has set up the save area of the new frame
+ * and is about to switch to a non-native callee, e.g. in the invokeMethod target of the
+ * portable interpreter:
+ *
+ *     switch(dtcInvokeMethod(self, methodToCall, newFp, &resumePc)) {
+ *     case DTC_BRIDGE_RETURNED:  FINISH(3);                   the caller continues
+ *     case DTC_BRIDGE_RESUME:    switch to self->interpSave.curFrame at resumePc
+ *     default:                   switch to the callee at its first instruction
+ *     }
+ *
+ * and the loop hook goes on the backward branches, before the trace JIT profiles them:
+ *
+ *     switch(dtcBranchBackward(self, curMethod, fp, pc, &resumePc)) {
+ *     case DTC_BRIDGE_RETURNED:  GOTO_returnFromMethod();
+ *     case DTC_BRIDGE_RESUME:    switch to self->interpSave.curFrame at resumePc, and
+ *                                throw the pending exception if any
+ *     default:                   keep interpreting the loop
+ *     }
+ */
+extern "C" DtcBridgeResult_t dtcInvokeMethod(Thread *pSelf, Method *pMethod, u4 *pNewFp,
+	const u2 **ppResumePc);
+
+extern "C" DtcBridgeResult_t dtcBranchBackward(Thread *pSelf, Method *pMethod, u4 *pFp,
+	const u2 *pPc, const u2 **ppResumePc);
+
+#endif
@@ -17,7 +17,20 @@
 // Static Function Definition
 ///////////////////////////////////////////////////////////////////////
 
-static DtcCIdExpr *NewVarExpr(DtcCSymbolTable_t &rSymbolTable, DtcDexLiveWeb *pWeb);
+static DtcCVarSymbol *NewVarSymbol(DtcCSymbolTable &rSymbolTable, DtcDexLiveWeb *pWeb);
+
+static DtcCIdExpr *NewVarExpr(DtcCSymbolTable &rSymbolTable, DtcDexLiveWeb *pWeb);
+
+static DtcCHelperStmt *NewHelperStmt(DtcCSymbolTable &rSymbolTable, DtcDexcode &rCode,
+	DtcDexLiveWebTable_t &rBlockWebs);
+
+static const Method *FindDirectCallee(const Method *pMethod, DtcDexcode &rCode);
+
+static DtcCInvokeStmt *NewInvokeStmt(DtcCSymbolTable &rSymbolTable, DtcDexcode &rCode,
+	const Method *pCallee, DtcDexLiveWebTable_t &rBlockWebs);
+
+// The dex pc of no instruction
+#define DTC_NO_PC						0xFFFFFFFF
 
 ///////////////////////////////////////////////////////////////////////
 // Constructor & Destructor Definition
@@ -38,10 +51,16 @@ DtcCBasicBlock::DtcCBasicBlock(DtcDexBasicBlock *pDexBasicBlock) {
 	m_pDexBasicBlock = pDexBasicBlock;
 
 	m_rStmtList.clear();
+	m_rExitWebs.clear();
 }
 
 DtcCBasicBlock::~DtcCBasicBlock() {
-	delete m_pDexBasicBlock;
+
+	// The dex basic block is owned by the dex method
+	for(uint32_t i = 0; i < m_rStmtList.size(); i++) {
+		delete m_rStmtList[i];
+	}
+
 	m_rStmtList.clear();
 }
 
@@ -49,6 +68,20 @@ DtcCBasicBlock::~DtcCBasicBlock() {
 // Member Function Definition
 ///////////////////////////////////////////////////////////////////////
 
+/**
+ * This function will return the variable symbol of a live web, which is interned by
+ * the symbol table, so the references to a variable share a single symbol.
+ *
+ * @param rSymbolTable a symbol table
+ * @param pWeb a live web
+ * @return the canonical variable symbol
+ */
+static DtcCVarSymbol *
+NewVarSymbol(DtcCSymbolTable &rSymbolTable, DtcDexLiveWeb *pWeb) {
+
+	return rSymbolTable.Intern(pWeb);
+}
+
 /**
  * This funciton will be used to simply the process making a new ID expression
  * from a live web.
@@ -58,33 +91,163 @@ DtcCBasicBlock::~DtcCBasicBlock() {
  * @return a new ID expression
  */
 static DtcCIdExpr *
-NewVarExpr(DtcCSymbolTable_t &rSymbolTable, DtcDexLiveWeb *pWeb) {
+NewVarExpr(DtcCSymbolTable &rSymbolTable, DtcDexLiveWeb *pWeb) {
 
 	if(pWeb == NULL) return NULL;
 
-	DtcCVarSymbol *sym = new DtcCVarSymbol(pWeb);			
+	return new DtcCIdExpr(NewVarSymbol(rSymbolTable, pWeb));	
+}
+
+/**
+ * This function will lower a dex instruction into a call to the runtime helper, which
+ * executes the instruction on the frame of the interpreter.
+ *
+ * @param rSymbolTable a symbol table
+ * @param rCode the dex code to be lowered
+ * @param rBlockWebs the latest webs of the registers in the block before the instruction
+ * @return a new helper statement
+ */
+static DtcCHelperStmt *
+NewHelperStmt(DtcCSymbolTable &rSymbolTable, DtcDexcode &rCode, DtcDexLiveWebTable_t &rBlockWebs) {
+
+	DtcCHelperStmt *stmt = new DtcCHelperStmt(rCode.GetInsnIndex(), rBlockWebs);
+
+	const DtcDexOpcodeInfo_t *info = rCode.GetInfo();
+
+	// The use web is the destination register written from the result of the
+	// previous instruction, which is kept by the helper like the interpreter
+	if(info->nFlags & DTC_OPF_MOVE_RESULT) {
+
+		if(rCode.GetUseCount() > 0) stmt->AppendLoad(NewVarSymbol(rSymbolTable, rCode.GetUseWeb(0)));
+		return stmt;
+	}
+
+	// The def web of an instruction leaving a result belongs to the following 
+	// move-result, which loads it
+	bool_t loadDefs = (info->nFlags & DTC_OPF_RESULT) ? FALSE : TRUE;
+
+	int32_t wideRegnum = -2;
+
+	for(uint32_t i = 0; i < rCode.GetUseCount(); i++) {
+
+		DtcDexLiveWeb *web = rCode.GetUseWeb(i);
+
+		// The high half of a wide argument is stored with its low half
+		if(web->GetRegnum() == wideRegnum + 1) continue;
+
+		if(web->GetDataType() == J_LONG || web->GetDataType() == J_DOUBLE) {
+			wideRegnum = web->GetRegnum();
+		}
+
+		stmt->AppendUse(NewVarSymbol(rSymbolTable, web));
+	}
+
+	for(uint32_t i = 0; loadDefs == TRUE && i < rCode.GetDefCount(); i++) {
+		stmt->AppendLoad(NewVarSymbol(rSymbolTable, rCode.GetDefWeb(i)));
+	}
+
+	return stmt;
+}
+
+/**
+ * This function will return the callee of an invoke-static or invoke-direct, which can
+ * be called directly by the compiled code. The callee must be resolved already, since
+ * the translation never resolves anything, and a static callee must have its class
+ * initialized, since the direct call skips the initialization check of the interpreter.
+ *
+ * @param pMethod the method being translated (NULL for the ahead-of-time translation)
+ * @param rCode the dex code of the invoke
+ * @return the callee (NULL if the invoke is left to the helper)
+ */
+static const Method *
+FindDirectCallee(const Method *pMethod, DtcDexcode &rCode) {
+
+	// The methods translated ahead of time do not know the addresses of the callees
+	if(pMethod == NULL) return NULL;
+
+	const Method *callee = dvmDexGetResolvedMethod(pMethod->clazz->pDvmDex, rCode.GetVB());
+
+	if(callee == NULL || dvmIsNativeMethod(callee) || dvmIsAbstractMethod(callee)) return NULL;
+
+	if(dvmIsStaticMethod(callee) && !dvmIsClassInitialized(callee->clazz)) return NULL;
+
+	// The argument words must fill the ins of the callee exactly
+	if(callee->insSize != rCode.GetVA()) return NULL;
+
+	return callee;
+}
+
+/**
+ * This function will lower an invoke into a direct call to the C function of the callee,
+ * which falls back to the runtime helper while the callee is not installed.
+ *
+ * @param rSymbolTable a symbol table
+ * @param rCode the dex code of the invoke
+ * @param pCallee the callee
+ * @param rBlockWebs the latest webs of the registers in the block before the instruction
+ * @return a new invoke statement (NULL if the arguments do not match the ins of the callee)
+ */
+static DtcCInvokeStmt *
+NewInvokeStmt(DtcCSymbolTable &rSymbolTable, DtcDexcode &rCode, const Method *pCallee,
+	DtcDexLiveWebTable_t &rBlockWebs) {
+
+	vector<DtcCVarSymbol *> args;
 
-	if(rSymbolTable.count(sym->GetNameString()) == 0) {			
-		rSymbolTable[sym->GetNameString()] = sym;		
-	}													
+	uint32_t nwords = 0;
+	int32_t wideRegnum = -2;
 
-	return new DtcCIdExpr(sym);	
+	// A wide argument is passed in two words from a single variable
+	for(uint32_t i = 0; i < rCode.GetUseCount(); i++) {
+
+		DtcDexLiveWeb *web = rCode.GetUseWeb(i);
+
+		if(web->GetRegnum() == wideRegnum + 1) continue;
+
+		if(web->GetDataType() == J_LONG || web->GetDataType() == J_DOUBLE) {
+			wideRegnum = web->GetRegnum();
+			nwords += 2;
+		}
+		else {
+			nwords += 1;
+		}
+
+		args.push_back(NewVarSymbol(rSymbolTable, web));
+	}
+
+	if(nwords != pCallee->insSize) return NULL;
+
+	DtcCInvokeStmt *stmt = new DtcCInvokeStmt(rCode.GetInsnIndex(), rBlockWebs, pCallee, 
+		dtcGetCallCell(pCallee));
+
+	for(uint32_t i = 0; i < args.size(); i++) {
+		stmt->AppendUse(args[i]);
+	}
+
+	if(!dvmIsStaticMethod(pCallee)) stmt->SetThis(args[0]);
+
+	return stmt;
 }
 
 /**
  * This function will translate a Dex basic block into a C basic block.
  *
+ * @param rSymbolTable a symbol table
+ * @param pMethod the method being translated (NULL for the ahead-of-time translation)
  * @return error information
  */
 DtcError_t
-DtcCBasicBlock::Translate(DtcCSymbolTable_t &rSymbolTable) {
+DtcCBasicBlock::Translate(DtcCSymbolTable &rSymbolTable, const Method *pMethod) {
 
-	DtcDexcode *code = NULL;
 	DtcCStatement *stmt = NULL;
-	DecodedInstruction *codeInfo = NULL;
-	
-	DtcDexcodeList_t::iterator iter;
-	DtcDexcodeList_t &codes = m_pDexBasicBlock->GetDexcodes();
+	DtcCDeoptStmt *guard = NULL;
+	DtcCCallExpr *callExpr = NULL;
+
+	// The latest webs of the registers referred so far, which tell the deoptimization
+	// points the types of the registers having several C variables
+	DtcDexLiveWebTable_t blockWebs;
+
+	// The move-result whose result is assigned by the direct call of the invoke
+	uint32_t fusedResultPc = DTC_NO_PC;
 
 	m_rStmtList.clear();
 
@@ -92,8 +255,8 @@ DtcCBasicBlock::Translate(DtcCSymbolTable_t &rSymbolTable) {
 	// Macros for simply building up the C IR 
 	///////////////////////////////////////////////////////////////////////	
 
-#define DEF_WEB(INDEX)					code->GetDefWeb(INDEX)
-#define USE_WEB(INDEX)					code->GetUseWeb(INDEX)
+#define DEF_WEB(INDEX)					code.GetDefWeb(INDEX)
+#define USE_WEB(INDEX)					code.GetUseWeb(INDEX)
 
 #define NEW_VAR_EXPR(WEB)				NewVarExpr(rSymbolTable, WEB)
 #define NEW_FUNC_EXPR(NAME)			(new DtcCIdExpr(new DtcCFuncSymbol(NAME)))
@@ -101,31 +264,45 @@ DtcCBasicBlock::Translate(DtcCSymbolTable_t &rSymbolTable) {
 #define NEW_LABEL_EXPR(LABEL)			(new DtcCIdExpr(new DtcCLabelSymbol(LABEL)))
 
 	// Translate each dex code into a C statement IR
-	for(iter = codes.begin(); iter != codes.end(); iter++) {
+	for(uint32_t n = 0; n < m_pDexBasicBlock->GetDexcodeCount(); n++) {
 
-		codeInfo = (code = *iter)->GetDecodedInfo();
+		DtcDexcode code = m_pDexBasicBlock->GetDexcode(n);
 
-		switch(codeInfo->opcode) {
+		switch(code.GetOpcode()) {
 
 			// kFmt21s
 			case OP_CONST_WIDE_16: {
 
+				// The literal is sign-extended to 64 bits, and vB holds its low word
 				DtcDexLiveWeb *web = DEF_WEB(0);
+				uint32_t high = ((s4) code.GetVB() < 0) ? 0xFFFFFFFF : 0;
 				stmt = new DtcCAssignStmt(
 					NEW_VAR_EXPR(DEF_WEB(0)),
-					NEW_CONST_EXPR(web->GetDataType(), 0, codeInfo->vB));
+					NEW_CONST_EXPR(web->GetDataType(), high, code.GetVB()));
 				break;
 			}
 
 			// kFmt12x
-			case OP_INT_TO_DOUBLE: {
-
-				stmt = new DtcCAssignStmt(
-					NEW_VAR_EXPR(DEF_WEB(0)),
-					new DtcCUnaryExpr(DTC_C_EXPR_UNARY_I2D, 
-						NEW_VAR_EXPR(USE_WEB(0))));
-				break;
-			}
+#define case_OP_CONVERT(OPCODE, OP)								\
+			case OP_##OPCODE:									\
+				stmt = new DtcCAssignStmt(					\
+					NEW_VAR_EXPR(DEF_WEB(0)),			\
+					new DtcCUnaryExpr(DTC_C_EXPR_UNARY_##OP,	\
+						NEW_VAR_EXPR(USE_WEB(0))));		\
+				break
+
+			case_OP_CONVERT(INT_TO_LONG, I2J);
+			case_OP_CONVERT(INT_TO_FLOAT, I2F);
+			case_OP_CONVERT(INT_TO_DOUBLE, I2D);
+			case_OP_CONVERT(LONG_TO_INT, J2I);
+			case_OP_CONVERT(LONG_TO_FLOAT, J2F);
+			case_OP_CONVERT(LONG_TO_DOUBLE, J2D);
+			case_OP_CONVERT(FLOAT_TO_INT, F2I);
+			case_OP_CONVERT(FLOAT_TO_LONG, F2J);
+			case_OP_CONVERT(FLOAT_TO_DOUBLE, F2D);
+			case_OP_CONVERT(DOUBLE_TO_INT, D2I);
+			case_OP_CONVERT(DOUBLE_TO_LONG, D2J);
+			case_OP_CONVERT(DOUBLE_TO_FLOAT, D2F);
 
 			// kFmt23x
 #define case_OP_BINARY_ARITH(OP)							\
@@ -152,11 +329,38 @@ DtcCBasicBlock::Translate(DtcCSymbolTable_t &rSymbolTable) {
 						NEW_VAR_EXPR(USE_WEB(1))));		\
 				break													
 
+			// kFmt23x, where the integer division by zero throws, so it is left to the
+			// interpreter by a guard on the cold path
+#define case_OP_BINARY_DIVIDE(OP)							\
+			case OP_##OP##_INT:							\
+			case OP_##OP##_LONG:							\
+				for(uint32_t i = 0; i < code.GetUseCount(); i++) {	\
+					DtcDexLiveWeb *web = USE_WEB(i);		\
+					if(web != NULL) blockWebs[web->GetRegnum()] = web;	\
+				}											\
+				guard = new DtcCDeoptStmt(code.GetInsnIndex(), blockWebs);	\
+				guard->SetCondExpr(new DtcCBinaryExpr(		\
+					DTC_C_EXPR_BINARY_EQ,					\
+					NEW_VAR_EXPR(USE_WEB(1)),				\
+					NEW_CONST_EXPR(J_INT, 0, 0)));			\
+				m_rStmtList.push_back(guard);				\
+				/* Fall through */							\
+			case OP_##OP##_FLOAT:							\
+			case OP_##OP##_DOUBLE: 						\
+				stmt = new DtcCAssignStmt(					\
+					NEW_VAR_EXPR(DEF_WEB(0)),			\
+					new DtcCBinaryExpr(						\
+						DTC_C_EXPR_BINARY_##OP,			\
+						NEW_VAR_EXPR(USE_WEB(0)),		\
+						NEW_VAR_EXPR(USE_WEB(1))));		\
+				break
+
 			case_OP_BINARY_ARITH(ADD);
 			case_OP_BINARY_ARITH(SUB);
 			case_OP_BINARY_ARITH(MUL);
-			case_OP_BINARY_ARITH(DIV);
-			case_OP_BINARY_ARITH(REM);
+
+			case_OP_BINARY_DIVIDE(DIV);
+			case_OP_BINARY_DIVIDE(REM);
 			
 			case_OP_BINARY_BITWISE(AND);
 			case_OP_BINARY_BITWISE(OR);
@@ -165,93 +369,234 @@ DtcCBasicBlock::Translate(DtcCSymbolTable_t &rSymbolTable) {
 			case_OP_BINARY_BITWISE(SHR);			
 			case_OP_BINARY_BITWISE(USHR);			
 
-			// kFmt23x
-			case OP_CMPG_DOUBLE: {
+			// kFmt23x, which call the helpers treating NaN as Java does
+#define case_OP_COMPARE(OPCODE, HELPER)						\
+			case OP_##OPCODE:									\
+				callExpr = new DtcCCallExpr(NEW_FUNC_EXPR(HELPER));	\
+				callExpr->AppendFuncParam(NEW_VAR_EXPR(USE_WEB(0)));	\
+				callExpr->AppendFuncParam(NEW_VAR_EXPR(USE_WEB(1)));	\
+				stmt = new DtcCAssignStmt(NEW_VAR_EXPR(DEF_WEB(0)), callExpr);	\
+				break
+
+			case_OP_COMPARE(CMPL_FLOAT, "dtc_cmpl_float");
+			case_OP_COMPARE(CMPG_FLOAT, "dtc_cmpg_float");
+			case_OP_COMPARE(CMPL_DOUBLE, "dtc_cmpl_double");
+			case_OP_COMPARE(CMPG_DOUBLE, "dtc_cmpg_double");
+			case_OP_COMPARE(CMP_LONG, "dtc_cmp_long");
+				
+			// kFmt22t
+#define case_OP_IF_TEST(OP)									\
+			case OP_IF_##OP:									\
+				stmt = new DtcCBranchStmt(							\
+					new DtcCBinaryExpr(								\
+						DTC_C_EXPR_BINARY_##OP,					\
+						NEW_VAR_EXPR(USE_WEB(0)),				\
+						NEW_VAR_EXPR(USE_WEB(1))),				\
+					NEW_LABEL_EXPR(code.GetInsnIndex() + (int32_t)code.GetVC()));	\
+				break
 
-				DtcCCallExpr *callExpr = new DtcCCallExpr(NEW_FUNC_EXPR("cmpg_double"));
+			// kFmt21t
+#define case_OP_IF_TESTZ(OP)									\
+			case OP_IF_##OP##Z:									\
+				stmt = new DtcCBranchStmt(							\
+					new DtcCBinaryExpr(								\
+						DTC_C_EXPR_BINARY_##OP,					\
+						NEW_VAR_EXPR(USE_WEB(0)),				\
+						NEW_CONST_EXPR(J_INT, 0, 0)),				\
+					NEW_LABEL_EXPR(code.GetInsnIndex() + (int32_t)code.GetVB()));	\
+				break
+
+			case_OP_IF_TEST(EQ);
+			case_OP_IF_TEST(NE);
+			case_OP_IF_TEST(LT);
+			case_OP_IF_TEST(GE);
+			case_OP_IF_TEST(GT);
+			case_OP_IF_TEST(LE);
+
+			case_OP_IF_TESTZ(EQ);
+			case_OP_IF_TESTZ(NE);
+			case_OP_IF_TESTZ(LT);
+			case_OP_IF_TESTZ(GE);
+			case_OP_IF_TESTZ(GT);
+			case_OP_IF_TESTZ(LE);
+
+			// kFmt10t, kFmt20t, kFmt30t
+			case OP_GOTO: case OP_GOTO_16: case OP_GOTO_32: {
+
+				uint32_t targetAddress = code.GetInsnIndex() + (int32_t)code.GetVA();
+
+				stmt = new DtcCBranchStmt(NULL, NEW_LABEL_EXPR(targetAddress));
+				break;
+			}
 
-				callExpr->AppendFuncParam(NEW_VAR_EXPR(USE_WEB(0)));
-				callExpr->AppendFuncParam(NEW_VAR_EXPR(USE_WEB(1)));
-				
-				stmt = new DtcCAssignStmt(NEW_VAR_EXPR(DEF_WEB(0)), callExpr);
+			// kFmt10x
+			case OP_RETURN_VOID_BARRIER:
+
+				// The stores of the constructor must be visible before the object is published
+				m_rStmtList.push_back(new DtcCAssignStmt(NULL, 
+					new DtcCCallExpr(NEW_FUNC_EXPR("__sync_synchronize"))));
+
+				// Fall through
+			case OP_RETURN_VOID: {
+
+				stmt = new DtcCReturnStmt(NULL);
 				break;
 			}
-				
-			// kFmt21t
-			case OP_IF_GEZ: {
 
-				uint32_t targetAddress = code->GetInsnIndex() + (int32_t)codeInfo->vB;
+			// kFmt11x
+			case OP_RETURN: case OP_RETURN_WIDE: case OP_RETURN_OBJECT: {
 
-				stmt = new DtcCBranchStmt(
-					new DtcCBinaryExpr(
-						DTC_C_EXPR_BINARY_GE,
-						NEW_VAR_EXPR(USE_WEB(0)),
-						NEW_CONST_EXPR(J_INT, 0, 0)),
-					NEW_LABEL_EXPR(targetAddress));
-				
+				stmt = new DtcCReturnStmt(NEW_VAR_EXPR(USE_WEB(0)));
 				break;
 			}
 
-			// kFmt21c
-			case OP_NEW_INSTANCE: {
+			// kFmt10x
+			case OP_NOP: {
+
+				stmt = NULL;
+				break;
+			}
+
+			// The switches and the breakpoints are left to the interpreter, which resumes
+			// at the instruction with the registers stored into the frame
+			case OP_PACKED_SWITCH: case OP_SPARSE_SWITCH: case OP_BREAKPOINT: {
+
+				for(uint32_t i = 0; i < code.GetUseCount(); i++) {
+					DtcDexLiveWeb *web = USE_WEB(i);
+					if(web != NULL) blockWebs[web->GetRegnum()] = web;
+				}
+
+				m_rStmtList.push_back(new DtcCDeoptStmt(code.GetInsnIndex(), blockWebs));
+				m_rExitWebs = blockWebs;
+				return DTC_SUCCESS;
+			}
+
+			// The invokes of the callees known at the translation call their C functions
+			// directly once they are installed
+			case OP_INVOKE_STATIC: case OP_INVOKE_STATIC_RANGE:
+			case OP_INVOKE_DIRECT: case OP_INVOKE_DIRECT_RANGE: {
+
+				for(uint32_t i = 0; i < code.GetUseCount(); i++) {
+					DtcDexLiveWeb *web = USE_WEB(i);
+					if(web != NULL) blockWebs[web->GetRegnum()] = web;
+				}
+
+				const Method *callee = FindDirectCallee(pMethod, code);
+				DtcCInvokeStmt *invoke = NULL;
+
+				if(callee != NULL) invoke = NewInvokeStmt(rSymbolTable, code, callee, blockWebs);
 
-				DtcCCallExpr *callExpr = new DtcCCallExpr(NEW_FUNC_EXPR("new_instance"));
+				if(invoke == NULL) {
+					stmt = NewHelperStmt(rSymbolTable, code, blockWebs);
+					break;
+				}
+
+				// The following move-result takes the C return value of the direct call
+				if(n + 1 < m_pDexBasicBlock->GetDexcodeCount()) {
+
+					DtcDexcode next = m_pDexBasicBlock->GetDexcode(n + 1);
 
-				// The constant expression must be replaced with the type string from the type index.
-				callExpr->AppendFuncParam(NEW_CONST_EXPR(J_INT, 0, codeInfo->vB));
+					if((next.GetInfo()->nFlags & DTC_OPF_MOVE_RESULT) && next.GetUseCount() > 0) {
+
+						invoke->SetResult(NewVarSymbol(rSymbolTable, next.GetUseWeb(0)), 
+							next.GetInsnIndex());
+						fusedResultPc = next.GetInsnIndex();
+					}
+				}
 
-				stmt = new DtcCAssignStmt(NEW_VAR_EXPR(DEF_WEB(0)), callExpr);
+				stmt = invoke;
 				break;
-			}			
+			}
 
-			// kFmt35c
-			case OP_INVOKE_DIRECT: {
+			case OP_MOVE_RESULT: case OP_MOVE_RESULT_WIDE: case OP_MOVE_RESULT_OBJECT: {
 
-				DtcCCallExpr *callExpr = new DtcCCallExpr(NEW_FUNC_EXPR("invoke_direct"));
+				if(code.GetInsnIndex() == fusedResultPc) {
+					stmt = NULL;
+					break;
+				}
 
-				// The constant expression must be replaced with the type string from the type index.
-				callExpr->AppendFuncParam(NEW_CONST_EXPR(J_INT, 0, codeInfo->vB));
+				for(uint32_t i = 0; i < code.GetUseCount(); i++) {
+					DtcDexLiveWeb *web = USE_WEB(i);
+					if(web != NULL) blockWebs[web->GetRegnum()] = web;
+				}
 
-				// Function arguments
-				for(uint32_t i = 0; i < (int32_t)codeInfo->vA; i++) {
-					callExpr->AppendFuncParam(NEW_VAR_EXPR(USE_WEB(i)));
+				stmt = NewHelperStmt(rSymbolTable, code, blockWebs);
+				break;
+			}
+
+			// The instructions without any inline lowering are executed by the runtime
+			// helper with the same semantics as the interpreter
+			default: {
+
+				for(uint32_t i = 0; i < code.GetUseCount(); i++) {
+					DtcDexLiveWeb *web = USE_WEB(i);
+					if(web != NULL) blockWebs[web->GetRegnum()] = web;
 				}
-				
-				stmt = new DtcCAssignStmt(NEW_VAR_EXPR(DEF_WEB(0)), callExpr);
+
+				stmt = NewHelperStmt(rSymbolTable, code, blockWebs);
 				break;
-			}				
+			}
+		}
 
-			default:
-				return DTC_SUCCESS;
+		if(stmt != NULL) m_rStmtList.push_back(stmt);
+
+		// The definitions follow the uses of an instruction
+		for(uint32_t i = 0; i < code.GetUseCount(); i++) {
+			DtcDexLiveWeb *web = USE_WEB(i);
+			if(web != NULL) blockWebs[web->GetRegnum()] = web;
 		}
 
-		m_rStmtList.push_back(stmt);
+		for(uint32_t i = 0; i < code.GetDefCount(); i++) {
+			DtcDexLiveWeb *web = DEF_WEB(i);
+			if(web != NULL) blockWebs[web->GetRegnum()] = web;
+		}
 	}
 
+	m_rExitWebs = blockWebs;
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will translate the block into the stub of an exit from the compiled
+ * region. The stub stores the registers into the frame and resumes the interpreter at
+ * the start of the block, which is not compiled.
+ *
+ * @param rBlockWebs the latest webs of the registers on the edges entering the block
+ * @return error information
+ */
+DtcError_t
+DtcCBasicBlock::TranslateExit(DtcDexLiveWebTable_t &rBlockWebs) {
+
+	m_rStmtList.clear();
+
+	m_rStmtList.push_back(new DtcCDeoptStmt(m_pDexBasicBlock->GetStartAddress(), rBlockWebs));
+
+	m_rExitWebs = rBlockWebs;
+
 	return DTC_SUCCESS;
 }
 
 /**
  * This function will print out the whole code of the translated basic block.
  *
- * @param pOut output stream
+ * @param rOut output buffer
  */
 void
-DtcCBasicBlock::Write(ostream &pOut) {
+DtcCBasicBlock::Write(DtcCodeBuffer &rOut) {
 
-	char buf[STR_LEN];
-	sprintf(buf, ".L%08X:\n", m_pDexBasicBlock->GetStartAddress());	
-	pOut << buf;
+	rOut << 'L';
+	rOut.AppendHex(m_pDexBasicBlock->GetStartAddress(), 8) << ":\n";
 
 	DtcCStmtList_t::iterator iter;
 	
 	for(iter = m_rStmtList.begin(); iter != m_rStmtList.end(); iter++) {
 
-		pOut << *iter << '\n';
+		rOut << *iter << '\n';
 	}
 }
 
-ostream &operator << (ostream &pOut, DtcCBasicBlock *pBlock) {
-	pBlock->Write(pOut);
-	return pOut;
+DtcCodeBuffer &operator << (DtcCodeBuffer &rOut, DtcCBasicBlock *pBlock) {
+	pBlock->Write(rOut);
+	return rOut;
 }
@@ -18,6 +18,7 @@
 #include "DtcCStatement.h"
 #include "DtcCExpression.h"
 #include "DtcCSymbol.h"
+#include "DtcCSymbolTable.h"
 
 ///////////////////////////////////////////////////////////////////////
 // User-defined Type Definition
@@ -25,8 +26,6 @@
 
 typedef vector<DtcCStatement *> DtcCStmtList_t;
 
-typedef map<const char *, DtcCSymbol *> DtcCSymbolTable_t;
-
 ///////////////////////////////////////////////////////////////////////
 // DtcCBasicBlock Class Declaration
 ///////////////////////////////////////////////////////////////////////
@@ -43,6 +42,9 @@ private :
 	// A list of the C statements
 	DtcCStmtList_t m_rStmtList;
 
+	// The latest webs of the registers referred by the block at its end
+	DtcDexLiveWebTable_t m_rExitWebs;
+
 public :
 	///////////////////////////////////////////////////////////////////
 	// Constructor & Destructor Declaration
@@ -52,15 +54,42 @@ public :
 	
 	virtual ~DtcCBasicBlock();
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the dex basic block translated into this block.
+	 *
+	 * @return the dex basic block
+	 */
+	inline DtcDexBasicBlock *GetDexBasicBlock()	{ return m_pDexBasicBlock;	}
+
+	/**
+	 * This function will return the list of the C statements.
+	 *
+	 * @return the list of the C statements
+	 */
+	inline DtcCStmtList_t &GetStmtList()		{ return m_rStmtList;		}
+
+	/**
+	 * This function will return the latest webs of the registers at the end of the block.
+	 *
+	 * @return the table of the webs indexed by the register numbers
+	 */
+	inline DtcDexLiveWebTable_t &GetExitWebs()	{ return m_rExitWebs;		}
+
 	///////////////////////////////////////////////////////////////////
 	// Membuer Function Declaration
 	///////////////////////////////////////////////////////////////////
 
-	DtcError_t Translate(DtcCSymbolTable_t &rSymbolTable);
+	DtcError_t Translate(DtcCSymbolTable &rSymbolTable, const Method *pMethod);
+
+	DtcError_t TranslateExit(DtcDexLiveWebTable_t &rBlockWebs);
 	
-	void Write(ostream &pOut);
+	void Write(DtcCodeBuffer &rOut);
 
-	friend ostream &operator << (ostream &pOut, DtcCBasicBlock *pBlock);	
+	friend DtcCodeBuffer &operator << (DtcCodeBuffer &rOut, DtcCBasicBlock *pBlock);	
 };
 
 #endif
@@ -72,6 +72,68 @@ GetCExprString(DtcCExprType_t nType) {
 	return exprTypeString[nType];
 };
 
+/**
+ * This function will return the data type of an operand, which decides the helper
+ * computing the expression.
+ *
+ * @param pExpr the operand expression
+ * @return the data type of the operand (J_UNKNOWN if it is not a variable or a constant)
+ */
+static DtcDexDataType_t
+GetOperandType(DtcCExpression *pExpr) {
+
+	if(pExpr == NULL || pExpr->GetType() != DTC_C_EXPR_ID) return J_UNKNOWN;
+
+	DtcCSymbol *sym = ((DtcCIdExpr *)pExpr)->GetSymbol();
+
+	switch(sym->GetType()) {
+		case DTC_C_SYM_VAR:
+			return ((DtcCVarSymbol *)sym)->GetWeb()->GetDataType();
+		case DTC_C_SYM_CONST:
+			return ((DtcCConstSymbol *)sym)->GetDataType();
+		default:
+			return J_UNKNOWN;
+	}
+}
+
+/**
+ * This function will return the helper of dtc_runtime.h computing the expression with 
+ * the semantics of Java, for the expressions whose C operators differ from Java. The
+ * narrow and unknown integers are computed as int.
+ *
+ * @param nType the type of the expression
+ * @param nDataType the data type of the (first) operand
+ * @return the name of the helper (NULL if the C operator does the same as Java)
+ */
+static const char *
+GetHelperName(DtcCExprType_t nType, DtcDexDataType_t nDataType) {
+
+	bool_t wide = (nDataType == J_LONG) ? TRUE : FALSE;
+
+	switch(nType) {
+		case DTC_C_EXPR_UNARY_F2I:	return "dtc_f2i";
+		case DTC_C_EXPR_UNARY_F2J:	return "dtc_f2l";
+		case DTC_C_EXPR_UNARY_D2I:	return "dtc_d2i";
+		case DTC_C_EXPR_UNARY_D2J:	return "dtc_d2l";
+
+		case DTC_C_EXPR_BINARY_DIV:
+			if(nDataType == J_FLOAT || nDataType == J_DOUBLE) return NULL;
+			return wide ? "dtc_div_long" : "dtc_div_int";
+
+		case DTC_C_EXPR_BINARY_REM:
+			if(nDataType == J_FLOAT) return "dtc_rem_float";
+			if(nDataType == J_DOUBLE) return "dtc_rem_double";
+			return wide ? "dtc_rem_long" : "dtc_rem_int";
+
+		case DTC_C_EXPR_BINARY_SHL:	return wide ? "dtc_shl_long" : "dtc_shl_int";
+		case DTC_C_EXPR_BINARY_SHR:	return wide ? "dtc_shr_long" : "dtc_shr_int";
+		case DTC_C_EXPR_BINARY_USHR:	return wide ? "dtc_ushr_long" : "dtc_ushr_int";
+
+		default:
+			return NULL;
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////
 // DtcCExpression Class Definition
 ///////////////////////////////////////////////////////////////////////
@@ -85,9 +147,9 @@ DtcCExpression::~DtcCExpression() {
 	// Do nothing
 }
 
-ostream &operator << (ostream &pOut, DtcCExpression *pExpr) {
-	pExpr->Write(pOut);
-	return pOut;
+DtcCodeBuffer &operator << (DtcCodeBuffer &rOut, DtcCExpression *pExpr) {
+	pExpr->Write(rOut);
+	return rOut;
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -102,15 +164,18 @@ DtcCIdExpr::DtcCIdExpr(DtcCSymbol *pSymbol /* = NULL */)
 
 DtcCIdExpr::~DtcCIdExpr(void) {
 
-	delete m_pSymbol;
+	// The variable symbols are owned by the symbol table
+	if(m_pSymbol != NULL && m_pSymbol->GetType() != DTC_C_SYM_VAR) {
+		delete m_pSymbol;
+	}
 }
 
 void 
-DtcCIdExpr::Write( ostream &o ) {
+DtcCIdExpr::Write(DtcCodeBuffer &rOut) {
 
 	if(m_pSymbol != NULL) {
 		
-		o << m_pSymbol;
+		rOut << m_pSymbol;
 	}
 }
 
@@ -131,20 +196,28 @@ DtcCUnaryExpr::~DtcCUnaryExpr() {
 }
 
 void
-DtcCUnaryExpr::Write(ostream &pOut) {
+DtcCUnaryExpr::Write(DtcCodeBuffer &rOut) {
+
+	const char *helper = GetHelperName(m_nType, GetOperandType(m_pExpr));
+
+	if(helper != NULL) {
+
+		rOut << helper << '(' << m_pExpr << ')';
+		return;
+	}
 	
 	if(m_pExpr->GetType() != DTC_C_EXPR_ID) {
 		
-		pOut << "( ";
+		rOut << "( ";
 	}
 
-	pOut << GetCExprString(m_nType);
+	rOut << GetCExprString(m_nType);
 
-	pOut << m_pExpr;
+	rOut << m_pExpr;
 
 	if(m_pExpr->GetType() != DTC_C_EXPR_ID) {
 
-		pOut << " )";
+		rOut << " )";
 	}
 }
 
@@ -168,15 +241,23 @@ DtcCBinaryExpr::~DtcCBinaryExpr(void) {
 }
 
 void
-DtcCBinaryExpr::Write(ostream &pOut) {
+DtcCBinaryExpr::Write(DtcCodeBuffer &rOut) {
 
 	if(m_pLhsExpr == NULL || m_pRhsExpr == NULL) {
 		
-		pOut << "INVALID BINARY OP: " << GetCExprString(m_nType) << ends; 
+		rOut << "INVALID BINARY OP: " << GetCExprString(m_nType);
+		return;
+	}
+
+	const char *helper = GetHelperName(m_nType, GetOperandType(m_pLhsExpr));
+
+	if(helper != NULL) {
+
+		rOut << helper << '(' << m_pLhsExpr << ", " << m_pRhsExpr << ')';
 		return;
 	}
 	
-	pOut << m_pLhsExpr << " " << GetCExprString(m_nType) << " " << m_pRhsExpr;
+	rOut << m_pLhsExpr << " " << GetCExprString(m_nType) << " " << m_pRhsExpr;
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -191,24 +272,30 @@ DtcCCallExpr::DtcCCallExpr(DtcCIdExpr *pIdExpr)
 
 DtcCCallExpr::~DtcCCallExpr() {
 
+	DtcCExprList_t::iterator iter;
+
+	for(iter = m_rParamExprList.begin(); iter != m_rParamExprList.end(); iter++) {
+		delete *iter;
+	}
+
 	delete m_pIdExpr;
 }
 
 void
-DtcCCallExpr::Write(ostream &pOut) {
+DtcCCallExpr::Write(DtcCodeBuffer &rOut) {
 
-	pOut << m_pIdExpr << '(';
+	rOut << m_pIdExpr << '(';
 
 	DtcCExprList_t::iterator iter;
 
 	for(iter = m_rParamExprList.begin(); iter != m_rParamExprList.end(); ) {
 
-		pOut << *iter;
+		rOut << *iter;
 
 		iter++;
 
-		if(iter != m_rParamExprList.end())	pOut << ", ";
+		if(iter != m_rParamExprList.end())	rOut << ", ";
 	}
 
-	pOut << ')';
+	rOut << ')';
 }
@@ -14,6 +14,7 @@
 #define _DTC_C_EXPRESSION_H_
 
 #include "DtcCommon.h"
+#include "DtcArena.h"
 #include "DtcCSymbol.h"
 
 class DtcCExpression;
@@ -77,7 +78,7 @@ typedef vector<DtcCExpression*> DtcCExprList_t;
 // DtcCExpression Class Declaration
 ///////////////////////////////////////////////////////////////////////
 
-class DtcCExpression {
+class DtcCExpression : public DtcArenaObject {
 
 protected:
 	///////////////////////////////////////////////////////////////////
@@ -117,9 +118,9 @@ public:
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	virtual void Write(ostream &pOut) = 0;
+	virtual void Write(DtcCodeBuffer &rOut) = 0;
 
-	friend ostream &operator << (ostream &pOut, DtcCExpression *pExpr);
+	friend DtcCodeBuffer &operator << (DtcCodeBuffer &rOut, DtcCExpression *pExpr);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -159,7 +160,7 @@ public:
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	virtual void Write(ostream &pOut);
+	virtual void Write(DtcCodeBuffer &rOut);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -185,11 +186,22 @@ public:
 
 	virtual ~DtcCUnaryExpr();
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the operand expression of the unary expression.
+	 *
+	 * @return the operand expression
+	 */
+	inline DtcCExpression *GetExpr()			{ return m_pExpr;		}
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	virtual void Write(ostream &pOut);
+	virtual void Write(DtcCodeBuffer &rOut);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -239,7 +251,7 @@ public:
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	virtual void Write(ostream &pOut);
+	virtual void Write(DtcCodeBuffer &rOut);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -272,6 +284,20 @@ public:
 	// Accessor & Mutator Declaration/Definition
 	///////////////////////////////////////////////////////////////////
 
+	/**
+	 * This function will return the function ID expression of the call expression.
+	 *
+	 * @return the function ID expression
+	 */
+	inline DtcCIdExpr *GetIdExpr()				{ return m_pIdExpr;		}
+
+	/**
+	 * This function will return the list of the function parameter expressions.
+	 *
+	 * @return the list of the parameter expressions
+	 */
+	inline DtcCExprList_t &GetFuncParams()		{ return m_rParamExprList;	}
+
 	/**
 	 * This function will be used to append a function parameter expression to 
 	 * the call expression.
@@ -286,7 +312,7 @@ public:
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	virtual void Write(ostream &pOut);
+	virtual void Write(DtcCodeBuffer &rOut);
 };
 
 #endif
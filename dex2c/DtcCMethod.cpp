@@ -10,8 +10,58 @@
 *   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
 **********************************************************************/
 
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+
 #include "DtcCMethod.h"
 
+///////////////////////////////////////////////////////////////////////
+// Static Function Declaration
+///////////////////////////////////////////////////////////////////////
+
+static void TranslateBlocksTask(void *pArg);
+
+static bool CompareBlockAddress(DtcCBasicBlock *pLhs, DtcCBasicBlock *pRhs);
+
+///////////////////////////////////////////////////////////////////////
+// Static Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+// The helpers of dtc_runtime.h as a string written into the generated code
+#define DTC_RUNTIME_SOURCE(...)		#__VA_ARGS__
+
+static const char s_pRuntimeSource[] =
+#include "dtc_runtime.h"
+;
+
+#undef DTC_RUNTIME_SOURCE
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// A chunk of the basic blocks translated by a task of the thread pool
+typedef struct {
+
+	// The translated C basic blocks in the order of the dex blocks
+	DtcCBasicBlockList_t rBlockList;
+
+	// The symbol table local to the task, which is merged at the end
+	DtcCSymbolTable rSymbolTable;
+
+	// The resolved method (NULL for the methods translated ahead of time)
+	const Method *pMethod;
+
+	// The number of the blocks translated successfully
+	uint32_t nTranslated;
+
+	// The error of the first block failed in the chunk
+	DtcError_t nError;
+
+} DtcCBlockChunk_t;
+
 ///////////////////////////////////////////////////////////////////////
 // Constructor & Destructor Definition
 ///////////////////////////////////////////////////////////////////////
@@ -29,15 +79,32 @@ DtcCMethod::DtcCMethod(DtcDexMethod *pDexMethod) {
 
 	m_pDexMethod = pDexMethod;
 
+	// The address of the resolved method makes the function name unique, and 
+	// the dex method index is used for the methods translated ahead of time
+	if(pDexMethod != NULL && pDexMethod->GetMethod() != NULL) {
+		sprintf(m_pFuncName, "dtc_%lx", (unsigned long)pDexMethod->GetMethod());
+	}
+	else {
+		sprintf(m_pFuncName, "dtc_m%x", (pDexMethod != NULL) ? pDexMethod->GetDexMethodIndex() : 0);
+	}
+
+	sprintf(m_pOsrFuncName, "%s_osr", m_pFuncName);
+
 	// Initialize the internal data 
 	m_rBasicBlockList.clear();
-	m_rSymbolTable.clear();
+	m_rSymbolTable.Clear();
 }
 
 DtcCMethod::~DtcCMethod() {
 
+	for(uint32_t i = 0; i < m_rBasicBlockList.size(); i++) {
+		delete m_rBasicBlockList[i];
+	}
+
 	m_rBasicBlockList.clear();
-	m_rSymbolTable.clear();
+
+	// The symbols are deleted after the expressions referring to them
+	m_rSymbolTable.Clear();
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -45,12 +112,14 @@ DtcCMethod::~DtcCMethod() {
 ///////////////////////////////////////////////////////////////////////
 
 /**
- * This function will translate all the Dex basic blocks into C basic blocks.
+ * This function will translate all the Dex basic blocks into C basic blocks. Only the
+ * blocks in the region are translated if a region of the method is selected.
  *
+ * @param pPool the thread pool translating the basic blocks of a large method in parallel
  * @return error information
  */
 DtcError_t
-DtcCMethod::Translate() {
+DtcCMethod::Translate(DtcThreadPool *pPool /* = NULL */) {
 
 	DTC_DEBUG(DEX2C_TAG, "DtcCMethod->Translate Invoked...");
 	
@@ -63,7 +132,7 @@ DtcCMethod::Translate() {
 
 #if defined(INCLUDE_DEPRECATED)
 
-	m_rSymbolTable.clear();
+	m_rSymbolTable.Clear();
 
 	// Register the symbols of the local variable array to the symbol table
 	DtcDexLiveWebTable_t::iterator lwiter;
@@ -71,16 +140,7 @@ DtcCMethod::Translate() {
 
 	for(lwiter = localVarTable.begin(); lwiter != localVarTable.end(); lwiter++) {
 
-		DtcDexLiveWeb *web = lwiter->second;
-
-		strstream o;
-		o << web << ends;
-		const char *symname = o.str();
-
-		if(m_rSymbolTable.count(symname) == 0) {
-			
-			m_rSymbolTable[symname] = web;
-		}
+		m_rSymbolTable.Intern(lwiter->second);
 	}
 
 #endif
@@ -88,67 +148,663 @@ DtcCMethod::Translate() {
 	// Perform the Dex-to-C translation for each of the basic blocks in the method
 	DtcDexBasicBlockTable_t::iterator bbiter;
 	DtcDexBasicBlockTable_t &dexBlocks = m_pDexMethod->GetBasicBlocks();
+	DtcDexBasicBlockList_t regionBlocks;
 
 	for(bbiter = dexBlocks.begin(); bbiter != dexBlocks.end(); bbiter++) {
+
+		if(m_pDexMethod->IsInRegion(bbiter->first)) regionBlocks.push_back(bbiter->second);
+	}
+
+	if(pPool != NULL && regionBlocks.size() >= DTC_PARALLEL_BLOCK_THRESHOLD) {
+		return TranslateInParallel(pPool, regionBlocks);
+	}
+
+	for(uint32_t i = 0; i < regionBlocks.size(); i++) {
 	
-		DtcCBasicBlock *cBlock = new DtcCBasicBlock(bbiter->second);
+		DtcCBasicBlock *cBlock = new DtcCBasicBlock(regionBlocks[i]);
 
-		if((error = cBlock->Translate(m_rSymbolTable)) != DTC_SUCCESS) {
-			break;
+		// A block left untranslated would make its predecessors jump to nowhere
+		if((error = cBlock->Translate(m_rSymbolTable, m_pDexMethod->GetMethod())) != DTC_SUCCESS) {
+			delete cBlock;
+			return error;
 		}
 
 		m_rBasicBlockList.push_back(cBlock);
 	}
 
+	if((error = TranslateRegionExits()) != DTC_SUCCESS) {
+		return error;
+	}
+
+	return ResolveDeoptPoints();
+}
+
+/**
+ * This function will translate the basic blocks in parallel. Each task translates a 
+ * chunk of the blocks with its own symbol table, and the results are merged in the
+ * order of the blocks, so the output is the same as the one of the serial translation.
+ *
+ * @param pPool the thread pool
+ * @param rDexBlocks the dex basic blocks to be translated in the order of the addresses
+ * @return error information
+ */
+DtcError_t
+DtcCMethod::TranslateInParallel(DtcThreadPool *pPool, DtcDexBasicBlockList_t &rDexBlocks) {
+
+	DTC_DEBUG(DEX2C_TAG, "DtcCMethod->TranslateInParallel Invoked...");
+
+	DtcError_t error;
+
+	uint32_t nchunks = (rDexBlocks.size() + DTC_PARALLEL_BLOCK_CHUNK - 1) / DTC_PARALLEL_BLOCK_CHUNK;
+
+	// The chunks must not move while the tasks are running
+	vector<DtcCBlockChunk_t> chunks(nchunks);
+
+	uint32_t next = 0;
+
+	for(uint32_t i = 0; i < nchunks; i++) {
+
+		for(uint32_t j = 0; j < DTC_PARALLEL_BLOCK_CHUNK && next < rDexBlocks.size(); j++) {
+
+			chunks[i].rBlockList.push_back(new DtcCBasicBlock(rDexBlocks[next++]));
+		}
+
+		chunks[i].nTranslated = 0;
+		chunks[i].nError = DTC_SUCCESS;
+		chunks[i].pMethod = m_pDexMethod->GetMethod();
+	}
+
+	DtcTaskGroup_t group = { 0 };
+
+	for(uint32_t i = 0; i < nchunks; i++) {
+		pPool->Submit(TranslateBlocksTask, &chunks[i], &group);
+	}
+
+	pPool->Wait(&group);
+
+	// Merge the results, stopping at the first block failed as the serial translation does
+	DtcError_t failed = DTC_SUCCESS;
+
+	for(uint32_t i = 0; i < nchunks; i++) {
+
+		DtcCBlockChunk_t &chunk = chunks[i];
+
+		if(failed == DTC_SUCCESS) {
+			m_rSymbolTable.Merge(chunk.rSymbolTable);
+		}
+
+		for(uint32_t j = 0; j < chunk.rBlockList.size(); j++) {
+
+			if(failed == DTC_SUCCESS && j < chunk.nTranslated) {
+				m_rBasicBlockList.push_back(chunk.rBlockList[j]);
+			}
+			else {
+				delete chunk.rBlockList[j];
+			}
+		}
+
+		if(failed == DTC_SUCCESS && chunk.nError != DTC_SUCCESS) failed = chunk.nError;
+	}
+
+	// A block left untranslated would make its predecessors jump to nowhere
+	if(failed != DTC_SUCCESS) {
+		return failed;
+	}
+
+	if((error = TranslateRegionExits()) != DTC_SUCCESS) {
+		return error;
+	}
+
+	return ResolveDeoptPoints();
+}
+
+/**
+ * This function will add the stubs of the exits from the region, one for each block
+ * outside the region entered by a translated block. The latest webs of the registers
+ * on the edges entering the block are merged for the deoptimization point of the stub,
+ * and a register having different webs on the edges is left unknown.
+ *
+ * @return error information
+ */
+DtcError_t
+DtcCMethod::TranslateRegionExits() {
+
+	if(m_pDexMethod->HasRegion() == FALSE) return DTC_SUCCESS;
+
+	map<uint32_t, DtcDexLiveWebTable_t> exitWebs;
+	map<uint32_t, DtcDexLiveWebTable_t>::iterator exitIter;
+
+	DtcCtrlDataTable_t &succTable = m_pDexMethod->GetSuccBlocks();
+	DtcDexBasicBlockTable_t &dexBlocks = m_pDexMethod->GetBasicBlocks();
+
+	for(uint32_t i = 0; i < m_rBasicBlockList.size(); i++) {
+
+		DtcCBasicBlock *block = m_rBasicBlockList[i];
+		DtcDexLiveWebTable_t &blockWebs = block->GetExitWebs();
+		DtcCtrlDataTable_t::iterator succIter = succTable.find(block->GetDexBasicBlock()->GetStartAddress());
+
+		if(succIter == succTable.end()) continue;
+
+		DtcCtrlDataEntry_t::iterator targetIter;
+
+		for(targetIter = succIter->second.begin(); targetIter != succIter->second.end(); targetIter++) {
+
+			if(m_pDexMethod->IsInRegion(*targetIter)) continue;
+
+			if((exitIter = exitWebs.find(*targetIter)) == exitWebs.end()) {
+				exitWebs[*targetIter] = blockWebs;
+				continue;
+			}
+
+			DtcDexLiveWebTable_t &webs = exitIter->second;
+			DtcDexLiveWebTable_t::iterator webIter = webs.begin();
+
+			while(webIter != webs.end()) {
+
+				DtcDexLiveWebTable_t::iterator found = blockWebs.find(webIter->first);
+
+				if(found == blockWebs.end() || 
+					found->second->GetDataType() != webIter->second->GetDataType()) {
+					webs.erase(webIter++);
+				}
+				else {
+					webIter++;
+				}
+			}
+		}
+	}
+
+	for(exitIter = exitWebs.begin(); exitIter != exitWebs.end(); exitIter++) {
+
+		DtcCBasicBlock *stub = new DtcCBasicBlock(dexBlocks[exitIter->first]);
+
+		stub->TranslateExit(exitIter->second);
+
+		m_rBasicBlockList.push_back(stub);
+	}
+
+	// The blocks are written in the order of the addresses to keep the fall-through edges
+	sort(m_rBasicBlockList.begin(), m_rBasicBlockList.end(), CompareBlockAddress);
+
+	DTC_DEBUG(DEX2C_TAG, "TranslateRegionExits - %d exits", exitWebs.size());
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will decide the C variables stored into the frame at each of the 
+ * deoptimization points. The registers are kept in the C variables all through the
+ * method, and only the ones live at the point are stored, i.e. the ones read by the
+ * interpreter after it resumes. A register having only one C variable is stored as it is,
+ * and a register having several ones is stored as the type of the latest web in the
+ * block. The method is not compiled if the type of such a register is unknown at a point,
+ * because the interpreter must not resume with a wrong value in the frame. The live
+ * references of a helper call are stored before the call as well, which is a safepoint.
+ *
+ * @return error information
+ */
+DtcError_t
+DtcCMethod::ResolveDeoptPoints() {
+
+	m_pDexMethod->ResolveLiveRegisters();
+
+	// The C variables of each register, indexed by the data type
+	map<uint16_t, map<uint32_t, DtcCVarSymbol *> > regVars;
+
+	for(uint32_t i = 0; i < m_rSymbolTable.GetSize(); i++) {
+
+		DtcCVarSymbol *sym = m_rSymbolTable.GetSymbol(i);
+		DtcDexLiveWeb *web = sym->GetWeb();
+
+		if(web->GetRegnum() >= m_pDexMethod->GetRegistersSize()) continue;
+
+		regVars[web->GetRegnum()].insert(make_pair((uint32_t)web->GetDataType(), sym));
+	}
+
+	DtcCBasicBlockList_t::iterator bbIter;
+
+	for(bbIter = m_rBasicBlockList.begin(); bbIter != m_rBasicBlockList.end(); bbIter++) {
+
+		DtcCStmtList_t &stmts = (*bbIter)->GetStmtList();
+
+		for(uint32_t i = 0; i < stmts.size(); i++) {
+
+			// A helper call deoptimizes when the interpreter takes over the instruction
+			if(stmts[i]->GetType() != DTC_C_STMT_DEOPT && stmts[i]->GetType() != DTC_C_STMT_HELPER) {
+				continue;
+			}
+
+			DtcCDeoptStmt *deopt = (DtcCDeoptStmt *)stmts[i];
+			DtcDexLiveWebTable_t &blockWebs = deopt->GetBlockWebs();
+
+			DtcLiveRegs_t live;
+
+			m_pDexMethod->GetLiveRegisters(deopt->GetDexPc(), live);
+
+			map<uint16_t, map<uint32_t, DtcCVarSymbol *> >::iterator regIter;
+
+			// The second register of a pair stored as a whole
+			int32_t pairReg = -1;
+
+			for(regIter = regVars.begin(); regIter != regVars.end(); regIter++) {
+
+				if(live[regIter->first] == false || regIter->first == pairReg) continue;
+
+				map<uint32_t, DtcCVarSymbol *> &vars = regIter->second;
+				DtcCVarSymbol *sym = NULL;
+
+				if(vars.size() == 1) {
+					sym = vars.begin()->second;
+				}
+				else {
+
+					DtcDexLiveWebTable_t::iterator webIter = blockWebs.find(regIter->first);
+
+					if(webIter == blockWebs.end() || vars.count(webIter->second->GetDataType()) == 0) {
+
+						DTC_ERROR(DEX2C_TAG, "ResolveDeoptPoints - Ambiguous type of v%d at 0x%04X", 
+							regIter->first, deopt->GetDexPc());
+						return DTC_ERROR_DEOPT_AMBIGUOUS;
+					}
+
+					sym = vars[webIter->second->GetDataType()];
+				}
+
+				deopt->AppendStore(sym);
+
+				DtcDexDataType_t type = sym->GetWeb()->GetDataType();
+
+				if(type == J_LONG || type == J_DOUBLE) pairReg = regIter->first + 1;
+
+				if(stmts[i]->GetType() != DTC_C_STMT_HELPER) continue;
+
+				// The references not in the frame are invisible to the collector
+				DtcCHelperStmt *helper = (DtcCHelperStmt *)stmts[i];
+				vector<DtcCVarSymbol *> &uses = helper->GetUseList();
+
+				if((type == J_OBJECT || type == J_UNKNOWN) && 
+					find(uses.begin(), uses.end(), sym) == uses.end()) {
+					helper->AppendSpill(sym);
+				}
+			}
+		}
+	}
+
 	return DTC_SUCCESS;
 }
 
 /**
- * This function will print out the prologue code of the translated method.
+ * This function will print out the declarations shared by all the methods of a translation unit.
+ *
+ * @param rOut output buffer
+ */
+void
+DtcCMethod::WriteHeader(DtcCodeBuffer &rOut) {
+
+	rOut << 
+		"#include <stdint.h>\n"
+		"\n"
+		"typedef unsigned char j_boolean;\n"
+		"typedef unsigned char j_byte;\n"
+		"typedef unsigned short j_char;\n"
+		"typedef short j_short;\n"
+		"typedef int j_int;\n"
+		"typedef long long j_long;\n"
+		"typedef float j_float;\n"
+		"typedef double j_double;\n"
+		"typedef void * j_object;\n"
+		"\n"
+		"#define DTC_ARG(TYPE, W) \\\n"
+		"    ({ union { uint64_t w; TYPE v; } u_ = { (uint64_t)(W) }; u_.v; })\n"
+		"#define DTC_ARG_WIDE(TYPE, LO, HI) \\\n"
+		"    ({ union { uint64_t w; TYPE v; } u_ = { ((uint64_t)(HI) << 32) | (LO) }; u_.v; })\n"
+		"\n"
+		"/* The pc given to the body of a method having OSR entries on the method entry */\n"
+		"#define DTC_METHOD_ENTRY 0xFFFFFFFFu\n"
+		"\n"
+		"/* The stores of the C variables into the frame of the interpreter at a deoptimization */\n"
+		"#define DTC_STORE(FP, R, TYPE, V) \\\n"
+		"    do { union { uint32_t w; TYPE v; } u_; u_.w = 0; u_.v = (V); (FP)[R] = u_.w; } while(0)\n"
+		"#define DTC_STORE_WIDE(FP, R, TYPE, V) \\\n"
+		"    do { union { uint64_t w; TYPE v; } u_; u_.v = (V); \\\n"
+		"        (FP)[R] = (uint32_t)u_.w; (FP)[(R) + 1] = (uint32_t)(u_.w >> 32); } while(0)\n"
+		"\n"
+		"/* The bits of a value returned in the 64-bit return value like JValue */\n"
+		"#define DTC_RET(TYPE, V) \\\n"
+		"    ({ union { uint64_t w; TYPE v; } u_; u_.w = 0; u_.v = (V); (j_long)u_.w; })\n"
+		"\n"
+		"/* The words of a value passed to a direct call like the registers of the frame */\n"
+		"#define DTC_LO(TYPE, V) ((uint32_t)DTC_RET(TYPE, V))\n"
+		"#define DTC_HI(TYPE, V) ((uint32_t)((uint64_t)DTC_RET(TYPE, V) >> 32))\n"
+		"\n"
+		"/* The call cell of a callee, which is bound when the callee is installed */\n"
+		"struct dtc_cell { void * volatile direct; };\n"
+		"\n"
+		"extern uint32_t *dtc_frame(void);\n"
+		"extern j_int dtc_execute(uint32_t *fp, uint32_t pc);\n"
+		"extern j_long dtc_deoptimize(uint32_t *fp, uint32_t pc);\n"
+		"extern uint32_t *dtc_push_frame(uint32_t *fp, const void *callee, uint32_t pc);\n"
+		"extern j_int dtc_pop_frame(uint32_t *fp, j_long result);\n"
+		"\n";
+
+	// The helpers with the semantics of Java, which are on a single line
+	rOut << s_pRuntimeSource << "\n";
+}
+
+/**
+ * This function will build a shared object from the given C translation unit with the
+ * external C compiler. The compiler is executed directly with the argument vector, so
+ * no shell ever parses the paths. The failure to start the compiler is told apart from
+ * the failure of the compilation, since no translation unit can be built without it.
+ *
+ * @param pLibPath the path of the shared object
+ * @param pSrcPath the path of the C translation unit
+ * @return error information (DTC_ERROR_BATCH_NO_COMPILER if the compiler cannot run)
+ */
+DtcError_t
+DtcCMethod::BuildSharedObject(const char *pLibPath, const char *pSrcPath) {
+
+	const char *argv[] = { DTC_CC_ARGS, "-o", pLibPath, pSrcPath, NULL };
+
+	// The child writes the error of exec into the pipe, which is closed by a successful exec
+	int fds[2];
+
+	if(pipe(fds) != 0) {
+		return DTC_ERROR_BATCH_NO_COMPILER;
+	}
+
+	fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+	pid_t pid = fork();
+
+	if(pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return DTC_ERROR_BATCH_NO_COMPILER;
+	}
+
+	if(pid == 0) {
+
+		close(fds[0]);
+		execvp(argv[0], (char * const *)argv);
+
+		int err = errno;
+
+		write(fds[1], &err, sizeof(err));
+		_exit(127);
+	}
+
+	close(fds[1]);
+
+	int err = 0;
+	ssize_t count;
+
+	while((count = read(fds[0], &err, sizeof(err))) < 0 && errno == EINTR);
+
+	close(fds[0]);
+
+	int status = -1;
+
+	while(waitpid(pid, &status, 0) < 0 && errno == EINTR);
+
+	if(count > 0) {
+		DTC_ERROR(DEX2C_TAG, "BuildSharedObject - Cannot execute %s (%s)", argv[0], strerror(err));
+		return DTC_ERROR_BATCH_NO_COMPILER;
+	}
+
+	if(status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		return DTC_ERROR_BATCH_COMPILATION;
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will print out the prologue code of the translated method. A method
+ * having loops is emitted as a body taking the frame of the interpreter, so that the
+ * interpreter can enter the body at the loop headers as well as at the method entry.
+ *
+ * @param rOut output buffer
+ */
+void
+DtcCMethod::WritePrologue(DtcCodeBuffer &rOut) {
+
+	uint16_t nins = m_pDexMethod->GetInsSize();
+
+	rOut << "/* " << m_pDexMethod->GetName() << " */\n";
+
+	if(GetOsrFuncName() != NULL) {
+
+		rOut << "static j_long " << m_pFuncName << "_body(uint32_t *fp, uint32_t pc) {\n";
+
+		WriteVarLoads(rOut, TRUE, TRUE);
+
+		// The method entry outside the region is left to the interpreter
+		if(m_pDexMethod->IsInRegion(0) == FALSE) {
+			rOut << "    if(pc == DTC_METHOD_ENTRY) return dtc_deoptimize(dtc_frame(), 0);\n";
+		}
+
+		// Only the registers live at a loop header are taken from the frame
+		DtcAddressSet_t::iterator iter;
+		DtcAddressSet_t &headers = m_pDexMethod->GetLoopHeaders();
+
+		rOut << "    if(pc != DTC_METHOD_ENTRY) {\n";
+		rOut << "    switch(pc) {\n";
+
+		for(iter = headers.begin(); iter != headers.end(); iter++) {
+
+			DtcLiveRegs_t live;
+
+			m_pDexMethod->GetLiveRegisters(*iter, live);
+
+			rOut << "    case 0x";
+			rOut.AppendHex(*iter, 4) << ":\n";
+
+			WriteVarLoads(rOut, FALSE, TRUE, &live);
+
+			rOut << "    goto L";
+			rOut.AppendHex(*iter, 8) << ";\n";
+		}
+
+		// A pc which is not a compiled loop header resumes in the interpreter, whose
+		// frame is still untouched here
+		rOut << "    default: return dtc_deoptimize(fp, pc);\n    }\n    }\n";
+		return;
+	}
+
+	// The incoming arguments are passed as 32-bit words like the Dalvik frame
+	rOut << "j_long " << m_pFuncName << "(";
+
+	for(uint16_t i = 0; i < nins; i++) {
+
+		rOut << (i == 0 ? "" : ", ") << "uint32_t in" << i;
+	}
+
+	rOut << (nins == 0 ? "void" : "") << ") {\n";
+
+	WriteVarLoads(rOut, TRUE, FALSE);
+}
+
+/**
+ * This function will print out the declarations of the C variables and the loads of
+ * their values from the incoming argument words or the frame of the interpreter.
  *
- * @param pOut output stream
+ * @param rOut output buffer
+ * @param bArgsOnly load the arguments only, and declare all the variables
+ * @param bFromFrame load the values from the frame instead of the argument words
+ * @param pLiveRegs the registers to be loaded (NULL for all the registers)
  */
 void
-DtcCMethod::WritePrologue(ostream &pOut) {
+DtcCMethod::WriteVarLoads(DtcCodeBuffer &rOut, bool_t bArgsOnly, bool_t bFromFrame, 
+	DtcLiveRegs_t *pLiveRegs /* = NULL */) {
 
-	pOut << "Method Prologue [" << m_pDexMethod->GetName() << "] -------------\n";
+	uint16_t nregs = m_pDexMethod->GetRegistersSize();
+	uint16_t nins = m_pDexMethod->GetInsSize();
+
+	// The symbol table keeps a single symbol for each of the C variables
+	for(uint32_t i = 0; i < m_rSymbolTable.GetSize(); i++) {
+
+		DtcCVarSymbol *sym = m_rSymbolTable.GetSymbol(i);
+		DtcDexLiveWeb *web = sym->GetWeb();
+
+		uint16_t regnum = web->GetRegnum();
+
+		const char *type = sym->GetTypeString();
+
+		if(bArgsOnly == TRUE) {
+			rOut << "    " << (type != NULL ? type : "uint32_t") << " " << sym << ";\n";
+		}
+
+		// Only the arguments are initialized on the method entry
+		if(bArgsOnly == TRUE && regnum < nregs - nins) continue;
+
+		if(regnum >= nregs) continue;
+
+		if(pLiveRegs != NULL && (*pLiveRegs)[regnum] == false) continue;
+
+		// The word of the register in the frame or in the argument words
+		char lo[STR_LEN], hi[STR_LEN];
+		DtcCodeBuffer loBuf(lo, STR_LEN), hiBuf(hi, STR_LEN);
+
+		if(bFromFrame == TRUE) {
+			loBuf << "fp[" << (int32_t)regnum << ']';
+			hiBuf << "fp[" << (int32_t)(regnum + 1) << ']';
+		}
+		else {
+			loBuf << "in" << (int32_t)(regnum - (nregs - nins));
+			hiBuf << "in" << (int32_t)(regnum - (nregs - nins) + 1);
+		}
+
+		loBuf.GetString();
+		hiBuf.GetString();
+
+		switch(web->GetDataType()) {
+			case J_LONG:
+			case J_DOUBLE:
+				if(regnum + 1 < nregs) {
+					rOut << "    " << sym << " = DTC_ARG_WIDE(" << type << ", " 
+						<< lo << ", " << hi << ");\n";
+				}
+				break;
+			case J_FLOAT:
+			case J_OBJECT:
+				rOut << "    " << sym << " = DTC_ARG(" << type << ", " << lo << ");\n";
+				break;
+			default:
+				rOut << "    " << sym << " = (" << (type != NULL ? type : "uint32_t") 
+					<< ")" << lo << ";\n";
+				break;
+		}
+	}
 }
 
 /**
- * This function will print out the epilogue code of the translated method.
+ * This function will print out the epilogue code of the translated method. The entries
+ * calling the body are emitted for a method having loops.
  *
- * @param pOut output stream
+ * @param rOut output buffer
  */
 void
-DtcCMethod::WriteEpilogue(ostream &pOut) {
+DtcCMethod::WriteEpilogue(DtcCodeBuffer &rOut) {
+
+	rOut << "    return 0;\n}\n";
 
-	pOut << "Method Epilogue -----------------------------\n";
+	if(GetOsrFuncName() == NULL) return;
+
+	uint16_t nregs = m_pDexMethod->GetRegistersSize();
+	uint16_t nins = m_pDexMethod->GetInsSize();
+
+	// The method entry builds a frame from the incoming argument words
+	rOut << "j_long " << m_pFuncName << "(";
+
+	for(uint16_t i = 0; i < nins; i++) {
+
+		rOut << (i == 0 ? "" : ", ") << "uint32_t in" << i;
+	}
+
+	rOut << (nins == 0 ? "void" : "") << ") {\n";
+	rOut << "    uint32_t fp[" << (nregs > 0 ? nregs : 1) << "];\n";
+
+	for(uint16_t i = 0; i < nins; i++) {
+
+		rOut << "    fp[" << (nregs - nins + i) << "] = in" << i << ";\n";
+	}
+
+	rOut << "    return " << m_pFuncName << "_body(fp, DTC_METHOD_ENTRY);\n}\n";
+
+	// The OSR entry takes the frame of the interpreter and the dex pc of a loop header
+	rOut << "j_long " << m_pOsrFuncName << "(uint32_t *fp, uint32_t pc) {\n";
+	rOut << "    return " << m_pFuncName << "_body(fp, pc);\n}\n";
 }
 
 /**
  * This function will print out the whole code, including prologue, epilogue, and body, of the translated method.
  *
- * @param pOut output stream
+ * @param rOut output buffer
  */
 void
-DtcCMethod::Write(ostream &pOut) {
+DtcCMethod::Write(DtcCodeBuffer &rOut) {
 
 	// Prologue
-	WritePrologue(pOut);
+	WritePrologue(rOut);
 
 	// Body
 	DtcCBasicBlockList_t::iterator iter;
 
 	for(iter = m_rBasicBlockList.begin(); iter != m_rBasicBlockList.end(); iter++) {
 
-		pOut << *iter;
+		rOut << *iter;
 	}
 
 	// Epilogue
-	WriteEpilogue(pOut);
+	WriteEpilogue(rOut);
+}
+
+DtcCodeBuffer &operator << (DtcCodeBuffer &rOut, DtcCMethod *pMethod) {
+	pMethod->Write(rOut);
+	return rOut;
 }
 
-ostream &operator << (ostream &pOut, DtcCMethod *pMethod) {
-	pMethod->Write(pOut);
-	return pOut;
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will translate a chunk of the basic blocks. It runs on the threads 
+ * of the pool.
+ *
+ * @param pArg the chunk of the basic blocks
+ */
+static void
+TranslateBlocksTask(void *pArg) {
+
+	DtcCBlockChunk_t *chunk = (DtcCBlockChunk_t *)pArg;
+
+	// Allocate from the heap rather than the arena bound to the running thread
+	DtcArena *arena = DtcArena::GetCurrent();
+	DtcArena::SetCurrent(NULL);
+
+	for(uint32_t i = 0; i < chunk->rBlockList.size(); i++) {
+
+		chunk->nError = chunk->rBlockList[i]->Translate(chunk->rSymbolTable, chunk->pMethod);
+
+		if(chunk->nError != DTC_SUCCESS) break;
+
+		chunk->nTranslated++;
+	}
+
+	DtcArena::SetCurrent(arena);
+}
+
+/**
+ * This function will compare the start addresses of the given basic blocks.
+ *
+ * @param pLhs a basic block
+ * @param pRhs another basic block
+ * @return true if the first block precedes the second one
+ */
+static bool
+CompareBlockAddress(DtcCBasicBlock *pLhs, DtcCBasicBlock *pRhs) {
+
+	return pLhs->GetDexBasicBlock()->GetStartAddress() < pRhs->GetDexBasicBlock()->GetStartAddress();
 }
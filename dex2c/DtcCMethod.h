@@ -23,6 +23,10 @@
 
 typedef vector<DtcCBasicBlock *> DtcCBasicBlockList_t;
 
+class DtcCMethod;
+
+typedef vector<DtcCMethod *> DtcCMethodList_t;
+
 ///////////////////////////////////////////////////////////////////////
 // DtcCMethod Class Declaration
 ///////////////////////////////////////////////////////////////////////
@@ -41,7 +45,13 @@ private :
 	DtcCBasicBlockList_t m_rBasicBlockList;
 
 	// The table of the symbols used in the generated C method
-	DtcCSymbolTable_t m_rSymbolTable;
+	DtcCSymbolTable m_rSymbolTable;
+
+	// The name of the generated C function
+	char m_pFuncName[STR_LEN];
+
+	// The name of the entry taking the frame of the interpreter at a loop header
+	char m_pOsrFuncName[STR_LEN];
 
 public :
 	///////////////////////////////////////////////////////////////////
@@ -52,23 +62,72 @@ public :
 	
 	virtual ~DtcCMethod();
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the dex method to be translated.
+	 *
+	 * @return the dex method
+	 */
+	inline DtcDexMethod *GetDexMethod()			{ return m_pDexMethod;		}
+
+	/**
+	 * This function will return the list of the translated C basic blocks.
+	 *
+	 * @return the list of the C basic blocks
+	 */
+	inline DtcCBasicBlockList_t &GetBasicBlocks()	{ return m_rBasicBlockList;	}
+
+	/**
+	 * This function will return the name of the generated C function taking the argument
+	 * words, which is installed as the compiled code of the method and entered by the
+	 * interpreter through the shared entry stub of its number of the words.
+	 *
+	 * @return the function name, which is unique in the running process
+	 */
+	inline const char *GetFuncName()				{ return m_pFuncName;		}
+
+	/**
+	 * This function will return the name of the OSR entry of the generated C code.
+	 *
+	 * @return the function name (NULL if the method does not have any loop)
+	 */
+	inline const char *GetOsrFuncName() {
+		return m_pDexMethod->GetLoopHeaders().empty() ? NULL : m_pOsrFuncName;
+	}
+
 	///////////////////////////////////////////////////////////////////
 	// Member Function Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	DtcError_t Translate();
+	DtcError_t Translate(DtcThreadPool *pPool = NULL);
+
+	static void WriteHeader(DtcCodeBuffer &rOut);
+
+	static DtcError_t BuildSharedObject(const char *pLibPath, const char *pSrcPath);
 
 private:
 
-	void WritePrologue(ostream &pOut);
+	DtcError_t TranslateInParallel(DtcThreadPool *pPool, DtcDexBasicBlockList_t &rDexBlocks);
+
+	DtcError_t TranslateRegionExits();
+
+	DtcError_t ResolveDeoptPoints();
+
+	void WritePrologue(DtcCodeBuffer &rOut);
+
+	void WriteEpilogue(DtcCodeBuffer &rOut);
 
-	void WriteEpilogue(ostream &pOut);
+	void WriteVarLoads(DtcCodeBuffer &rOut, bool_t bArgsOnly, bool_t bFromFrame, 
+		DtcLiveRegs_t *pLiveRegs = NULL);
 
 public:
 	
-	void Write(ostream &pOut);
+	void Write(DtcCodeBuffer &rOut);
 	
-	friend ostream &operator << (ostream &pOut, DtcCMethod *pMethod);
+	friend DtcCodeBuffer &operator << (DtcCodeBuffer &rOut, DtcCMethod *pMethod);
 
 };
 
@@ -17,21 +17,120 @@
 ///////////////////////////////////////////////////////////////////////
 
 /**
- * This function will put the space to the output stream as many as 
+ * This function will put the space to the output buffer as many as 
  * 4 times of the given indent number.
  *
- * @param pOut output stream
+ * @param rOut output buffer
  * @param nIndent the number of the indent to be inserted.
  */
 static void 
-InsertIndentSpace(ostream &pOut, uint32_t nIndent) {
+InsertIndentSpace(DtcCodeBuffer &rOut, uint32_t nIndent) {
 
 #define DTC_TAB_CHAR	((char)(' '))
 #define DTC_TAB_STRING	((char *)("    "))
+#define DTC_TAB_WIDTH	4
 
-	for(uint32_t i = 0; i < nIndent; i++ ) {
-		
-		pOut << DTC_TAB_STRING;
+	static const char spaces[] = "                                ";
+
+	uint32_t length = nIndent * DTC_TAB_WIDTH;
+
+	// The spaces of the indents are copied at once
+	while(length > 0) {
+
+		uint32_t chunk = (length < sizeof(spaces) - 1) ? length : sizeof(spaces) - 1;
+
+		rOut.Append(spaces, chunk);
+		length -= chunk;
+	}
+}
+
+/**
+ * This function will put the store of a variable into the frame of the interpreter
+ * to the output buffer.
+ *
+ * @param rOut output buffer
+ * @param pSym the variable symbol
+ */
+static void
+WriteStore(DtcCodeBuffer &rOut, DtcCVarSymbol *pSym) {
+
+	DtcDexLiveWeb *web = pSym->GetWeb();
+	const char *type = pSym->GetTypeString();
+
+	switch(web->GetDataType()) {
+		case J_LONG:
+		case J_DOUBLE:
+			rOut << "DTC_STORE_WIDE(fp_, " << web->GetRegnum() << ", " << type << ", " 
+				<< pSym << ");\n";
+			break;
+		case J_FLOAT:
+		case J_OBJECT:
+			rOut << "DTC_STORE(fp_, " << web->GetRegnum() << ", " << type << ", " 
+				<< pSym << ");\n";
+			break;
+		default:
+			// The narrow integers are sign-extended as the interpreter does
+			rOut << "fp_[" << web->GetRegnum() << "] = (uint32_t)" << pSym << ";\n";
+			break;
+	}
+}
+
+/**
+ * This function will put the load of a variable from the frame of the interpreter
+ * to the output buffer.
+ *
+ * @param rOut output buffer
+ * @param pSym the variable symbol
+ */
+static void
+WriteLoad(DtcCodeBuffer &rOut, DtcCVarSymbol *pSym) {
+
+	DtcDexLiveWeb *web = pSym->GetWeb();
+	const char *type = pSym->GetTypeString();
+	uint16_t regnum = web->GetRegnum();
+
+	switch(web->GetDataType()) {
+		case J_LONG:
+		case J_DOUBLE:
+			rOut << pSym << " = DTC_ARG_WIDE(" << type << ", fp_[" << regnum << "], fp_[" 
+				<< (regnum + 1) << "]);\n";
+			break;
+		case J_FLOAT:
+		case J_OBJECT:
+			rOut << pSym << " = DTC_ARG(" << type << ", fp_[" << regnum << "]);\n";
+			break;
+		default:
+			rOut << pSym << " = (" << (type != NULL ? type : "uint32_t") << ")fp_[" 
+				<< regnum << "];\n";
+			break;
+	}
+}
+
+/**
+ * This function will put the argument words of a variable passed to a direct call
+ * to the output buffer, in the same layout as the registers of the frame.
+ *
+ * @param rOut output buffer
+ * @param pSym the variable symbol
+ */
+static void
+WriteArgWords(DtcCodeBuffer &rOut, DtcCVarSymbol *pSym) {
+
+	const char *type = pSym->GetTypeString();
+
+	switch(pSym->GetWeb()->GetDataType()) {
+		case J_LONG:
+		case J_DOUBLE:
+			rOut << "DTC_LO(" << type << ", " << pSym << "), DTC_HI(" << type << ", " 
+				<< pSym << ")";
+			break;
+		case J_FLOAT:
+		case J_OBJECT:
+			rOut << "DTC_LO(" << type << ", " << pSym << ")";
+			break;
+		default:
+			rOut << "(uint32_t)" << pSym;
+			break;
 	}
 }
 
@@ -48,11 +147,11 @@ DtcCStatement::~DtcCStatement(void) {
 	// Do nothing
 }
 
-ostream &operator <<(ostream &pOut, DtcCStatement *pStmt) {
+DtcCodeBuffer &operator <<(DtcCodeBuffer &rOut, DtcCStatement *pStmt) {
 	
 	uint32_t indent = 1;
-	pStmt->Write(pOut, indent);
-	return pOut;
+	pStmt->Write(rOut, indent);
+	return rOut;
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -74,16 +173,16 @@ DtcCAssignStmt::~DtcCAssignStmt() {
 }
 
 void
-DtcCAssignStmt::Write(ostream &pOut, uint32_t &nIndent) {
+DtcCAssignStmt::Write(DtcCodeBuffer &rOut, uint32_t &nIndent) {
 
-	InsertIndentSpace(pOut, nIndent);
+	InsertIndentSpace(rOut, nIndent);
 
 	if(m_pIdExpr != NULL) {
 
-		pOut << m_pIdExpr << " = ";
+		rOut << m_pIdExpr << " = ";
 	}
 
-	pOut << m_pRhsExpr << ";" << endl;
+	rOut << m_pRhsExpr << ";\n";
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -105,9 +204,358 @@ DtcCBranchStmt::~DtcCBranchStmt(void) {
 }
 	
 void
-DtcCBranchStmt::Write(ostream &pOut, uint32_t &nIndent) {
+DtcCBranchStmt::Write(DtcCodeBuffer &rOut, uint32_t &nIndent) {
+
+	InsertIndentSpace(rOut, nIndent);
+
+	// A branch without any condition is a goto
+	if(m_pCondExpr == NULL) {
+		rOut << "goto " << m_pTargetExpr << ";\n";
+		return;
+	}
+
+	rOut << "if(" << m_pCondExpr << ")\tgoto " << m_pTargetExpr << ";\n";
+}
+
+///////////////////////////////////////////////////////////////////////
+// DtcCDeoptStmt Class Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcCDeoptStmt::DtcCDeoptStmt(uint32_t nDexPc, DtcDexLiveWebTable_t &rBlockWebs,
+	DtcCStmtType_t nType /* = DTC_C_STMT_DEOPT */)
+:DtcCStatement(nType) {
+
+	m_nDexPc = nDexPc;
+
+	m_rBlockWebs = rBlockWebs;
+
+	m_rStoreList.clear();
+
+	m_pCondExpr = NULL;
+}
+
+DtcCDeoptStmt::~DtcCDeoptStmt(void) {
+
+	delete m_pCondExpr;
+
+	// The variable symbols are owned by the symbol table
+	m_rStoreList.clear();
+	m_rBlockWebs.clear();
+}
+
+void
+DtcCDeoptStmt::Write(DtcCodeBuffer &rOut, uint32_t &nIndent) {
+
+	InsertIndentSpace(rOut, nIndent);
+
+	// The guard is expected not to deoptimize, which keeps the stores off the hot path
+	if(m_pCondExpr != NULL) {
+		rOut << "if(__builtin_expect(" << m_pCondExpr << ", 0)) ";
+	}
+
+	rOut << "{\n";
+
+	nIndent++;
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "uint32_t *fp_ = dtc_frame();\n";
+
+	WriteStores(rOut, nIndent);
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "return dtc_deoptimize(fp_, 0x";
+	rOut.AppendHex(m_nDexPc, 4) << ");\n";
 
-	InsertIndentSpace(pOut, nIndent);
+	nIndent--;
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "}\n";
+}
+
+/**
+ * This function will print out the stores of all the resolved variables into the frame.
+ *
+ * @param rOut output buffer
+ * @param nIndent the number of the indent
+ */
+void
+DtcCDeoptStmt::WriteStores(DtcCodeBuffer &rOut, uint32_t nIndent) {
+
+	for(uint32_t i = 0; i < m_rStoreList.size(); i++) {
+
+		InsertIndentSpace(rOut, nIndent);
+		WriteStore(rOut, m_rStoreList[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// DtcCHelperStmt Class Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcCHelperStmt::DtcCHelperStmt(uint32_t nDexPc, DtcDexLiveWebTable_t &rBlockWebs)
+:DtcCDeoptStmt(nDexPc, rBlockWebs, DTC_C_STMT_HELPER) {
+
+	m_rUseList.clear();
+	m_rLoadList.clear();
+	m_rSpillList.clear();
+}
+
+DtcCHelperStmt::~DtcCHelperStmt(void) {
+
+	// The variable symbols are owned by the symbol table
+	m_rUseList.clear();
+	m_rLoadList.clear();
+	m_rSpillList.clear();
+}
+
+void
+DtcCHelperStmt::Write(DtcCodeBuffer &rOut, uint32_t &nIndent) {
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "{\n";
+
+	nIndent++;
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "uint32_t *fp_ = dtc_frame();\n";
+
+	WriteSpills(rOut, nIndent);
+
+	WriteCall(rOut, nIndent);
+
+	nIndent--;
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "}\n";
+}
+
+/**
+ * This function will print out the stores of the live references into the frame. The
+ * C variables are still valid after the call, since the collector never moves them.
+ *
+ * @param rOut output buffer
+ * @param nIndent the number of the indent
+ */
+void
+DtcCHelperStmt::WriteSpills(DtcCodeBuffer &rOut, uint32_t nIndent) {
+
+	for(uint32_t i = 0; i < m_rSpillList.size(); i++) {
+
+		InsertIndentSpace(rOut, nIndent);
+		WriteStore(rOut, m_rSpillList[i]);
+	}
+}
+
+/**
+ * This function will print out the call to the runtime helper with the stores of the
+ * used variables and the loads of the defined ones, where fp_ is the frame.
+ *
+ * @param rOut output buffer
+ * @param nIndent the number of the indent
+ */
+void
+DtcCHelperStmt::WriteCall(DtcCodeBuffer &rOut, uint32_t nIndent) {
+
+	for(uint32_t i = 0; i < m_rUseList.size(); i++) {
+
+		InsertIndentSpace(rOut, nIndent);
+		WriteStore(rOut, m_rUseList[i]);
+	}
+
+	// The whole frame is needed only when the interpreter takes over the instruction
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "if(dtc_execute(fp_, 0x";
+	rOut.AppendHex(m_nDexPc, 4) << ") != 0) {\n";
+
+	WriteStores(rOut, nIndent + 1);
+
+	InsertIndentSpace(rOut, nIndent + 1);
+	rOut << "return dtc_deoptimize(fp_, 0x";
+	rOut.AppendHex(m_nDexPc, 4) << ");\n";
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "}\n";
+
+	for(uint32_t i = 0; i < m_rLoadList.size(); i++) {
+
+		InsertIndentSpace(rOut, nIndent);
+		WriteLoad(rOut, m_rLoadList[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// DtcCInvokeStmt Class Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcCInvokeStmt::DtcCInvokeStmt(uint32_t nDexPc, DtcDexLiveWebTable_t &rBlockWebs, 
+	const Method *pCallee, DtcCallCell_t *pCell)
+:DtcCHelperStmt(nDexPc, rBlockWebs) {
+
+	m_pCallee = pCallee;
+	m_pCell = pCell;
+
+	m_pThisSym = NULL;
+	m_pResultSym = NULL;
+	m_nResultPc = 0;
+}
+
+DtcCInvokeStmt::~DtcCInvokeStmt(void) {
+	// The variable symbols are owned by the symbol table
+}
+
+void
+DtcCInvokeStmt::Write(DtcCodeBuffer &rOut, uint32_t &nIndent) {
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "{\n";
+
+	nIndent++;
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "uint32_t *fp_ = dtc_frame();\n";
+
+	// The callee may collect the garbage through any of the paths
+	WriteSpills(rOut, nIndent);
+
+	// The cell is read once, since the callee can be installed at any time
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "void *d_ = ((struct dtc_cell *)0x";
+	rOut.AppendHex((uint64_t)(uintptr_t)m_pCell) << ")->direct;\n";
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "uint32_t *nfp_;\n";
+
+	// A null receiver is left to the helper, which throws the exception
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "if(d_ != 0 && ";
+
+	if(m_pThisSym != NULL) rOut << m_pThisSym << " != 0 && ";
+
+	rOut << "(nfp_ = dtc_push_frame(fp_, (const void *)0x";
+	rOut.AppendHex((uint64_t)(uintptr_t)m_pCallee) << ", 0x";
+	rOut.AppendHex(m_nDexPc, 4) << ")) != 0) {\n";
+
+	// The function is called by the words of the arguments like the entry stub
+	InsertIndentSpace(rOut, nIndent + 1);
+	rOut << "j_long r_ = ((j_long (*)(";
+
+	for(uint16_t i = 0; i < m_pCallee->insSize; i++) {
+		rOut << (i == 0 ? "" : ", ") << "uint32_t";
+	}
+
+	rOut << (m_pCallee->insSize == 0 ? "void" : "") << "))d_)(";
+
+	for(uint32_t i = 0; i < m_rUseList.size(); i++) {
+
+		if(i > 0) rOut << ", ";
+		WriteArgWords(rOut, m_rUseList[i]);
+	}
+
+	rOut << ");\n";
+
+	// The interpreter resumes the callee and returns to the invoke in the frame
+	InsertIndentSpace(rOut, nIndent + 1);
+	rOut << "if(dtc_pop_frame(nfp_, r_) != 0) {\n";
+
+	WriteStores(rOut, nIndent + 2);
+
+	InsertIndentSpace(rOut, nIndent + 2);
+	rOut << "return dtc_deoptimize(fp_, 0x";
+	rOut.AppendHex(m_nDexPc, 4) << ");\n";
+
+	InsertIndentSpace(rOut, nIndent + 1);
+	rOut << "}\n";
+
+	if(m_pResultSym != NULL) {
+
+		const char *type = m_pResultSym->GetTypeString();
+
+		InsertIndentSpace(rOut, nIndent + 1);
+
+		switch(m_pResultSym->GetWeb()->GetDataType()) {
+			case J_LONG:
+			case J_DOUBLE:
+			case J_FLOAT:
+			case J_OBJECT:
+				rOut << m_pResultSym << " = DTC_ARG(" << type << ", r_);\n";
+				break;
+			default:
+				rOut << m_pResultSym << " = (" << (type != NULL ? type : "uint32_t") 
+					<< ")r_;\n";
+				break;
+		}
+	}
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "}\n";
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "else {\n";
+
+	WriteCall(rOut, nIndent + 1);
+
+	// The fused move-result takes the result kept by the helper
+	if(m_pResultSym != NULL) {
+
+		InsertIndentSpace(rOut, nIndent + 1);
+		rOut << "dtc_execute(fp_, 0x";
+		rOut.AppendHex(m_nResultPc, 4) << ");\n";
+
+		InsertIndentSpace(rOut, nIndent + 1);
+		WriteLoad(rOut, m_pResultSym);
+	}
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "}\n";
+
+	nIndent--;
+
+	InsertIndentSpace(rOut, nIndent);
+	rOut << "}\n";
+}
+
+///////////////////////////////////////////////////////////////////////
+// DtcCReturnStmt Class Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcCReturnStmt::DtcCReturnStmt(DtcCIdExpr *pValueExpr)
+:DtcCStatement(DTC_C_STMT_RETURN) {
+
+	m_pValueExpr = pValueExpr;
+}
+
+DtcCReturnStmt::~DtcCReturnStmt(void) {
+
+	delete m_pValueExpr;
+}
+
+void
+DtcCReturnStmt::Write(DtcCodeBuffer &rOut, uint32_t &nIndent) {
+
+	InsertIndentSpace(rOut, nIndent);
+
+	if(m_pValueExpr == NULL) {
+		rOut << "return 0;\n";
+		return;
+	}
+
+	DtcCSymbol *sym = m_pValueExpr->GetSymbol();
+
+	// The value is returned in the bits of the 64-bit return value like JValue
+	if(sym->GetType() == DTC_C_SYM_VAR) {
+
+		const char *type = ((DtcCVarSymbol *)sym)->GetTypeString();
+
+		switch(((DtcCVarSymbol *)sym)->GetWeb()->GetDataType()) {
+			case J_FLOAT:
+			case J_DOUBLE:
+			case J_OBJECT:
+				rOut << "return DTC_RET(" << type << ", " << m_pValueExpr << ");\n";
+				return;
+			default:
+				break;
+		}
+	}
 
-	pOut << "if(" << m_pCondExpr << ")\tgoto " << m_pTargetExpr << ";" << endl;
+	rOut << "return (j_long)" << m_pValueExpr << ";\n";
 }
@@ -14,11 +14,18 @@
 #define _DTC_C_STATEMENT_H_
 
 #include "DtcCommon.h"
+#include "DtcArena.h"
 #include "DtcCExpression.h"
+#include "DtcDexBasicBlock.h"
+#include "DtcCallCell.h"
 
 class DtcCStatement;
 class DtcCAssignStmt;
 class DtcCBranchStmt;
+class DtcCDeoptStmt;
+class DtcCHelperStmt;
+class DtcCInvokeStmt;
+class DtcCReturnStmt;
 
 ///////////////////////////////////////////////////////////////////////
 // User-defined Type Definition
@@ -30,6 +37,9 @@ typedef enum {
 	DTC_C_STMT_UNKNOWN = 0,
 	DTC_C_STMT_ASSIGN,
 	DTC_C_STMT_BRANCH,
+	DTC_C_STMT_DEOPT,
+	DTC_C_STMT_HELPER,
+	DTC_C_STMT_RETURN,
 	DTC_C_NUM_OF_STMT
 	
 } DtcCStmtType_t;
@@ -38,7 +48,7 @@ typedef enum {
 // DtcCStatement Class Declaration
 ///////////////////////////////////////////////////////////////////////
 
-class DtcCStatement {
+class DtcCStatement : public DtcArenaObject {
 
 protected:
 	///////////////////////////////////////////////////////////////////
@@ -56,13 +66,24 @@ public:
 	
 	virtual ~DtcCStatement();
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/** 
+	 * This function will return the type of this statement.
+	 *
+	 * @return the type of the statement
+	 */
+	inline DtcCStmtType_t GetType()				{ return m_nType;		}
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 
-	virtual void Write(ostream &pOut, uint32_t &nIndent) = 0;
+	virtual void Write(DtcCodeBuffer &rOut, uint32_t &nIndent) = 0;
 	
-	friend ostream &operator << (ostream &pOut, DtcCStatement *pStmt);
+	friend DtcCodeBuffer &operator << (DtcCodeBuffer &rOut, DtcCStatement *pStmt);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -91,11 +112,29 @@ public:
 
 	virtual ~DtcCAssignStmt();
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the left-hand side expression of the assignment.
+	 *
+	 * @return the left-hand side expression
+	 */
+	inline DtcCIdExpr *GetIdExpr()				{ return m_pIdExpr;		}
+
+	/**
+	 * This function will return the right-hand side expression of the assignment.
+	 *
+	 * @return the right-hand side expression
+	 */
+	inline DtcCExpression *GetRhsExpr()			{ return m_pRhsExpr;	}
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 
-	virtual void Write(ostream &pOut, uint32_t &nIndent);
+	virtual void Write(DtcCodeBuffer &rOut, uint32_t &nIndent);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -124,11 +163,352 @@ public:
 	
 	virtual ~DtcCBranchStmt();
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the condition expression of the branch.
+	 *
+	 * @return the condition expression
+	 */
+	inline DtcCExpression *GetCondExpr()		{ return m_pCondExpr;	}
+
+	/**
+	 * This function will return the target label expression of the branch.
+	 *
+	 * @return the target label expression
+	 */
+	inline DtcCIdExpr *GetTargetExpr()			{ return m_pTargetExpr;	}
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(DtcCodeBuffer &rOut, uint32_t &nIndent);
+};
+
+///////////////////////////////////////////////////////////////////////
+// DtcCDeoptStmt Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * A deoptimization point, where the compiled code gives up and the interpreter
+ * resumes the method. The statement stores the C variables of the registers live at
+ * the point into the frame of the interpreter and returns through the runtime helper with the
+ * dex pc of the instruction to be resumed. A point with a condition is a guard,
+ * which deoptimizes on the cold path where the instruction throws an exception.
+ */
+class DtcCDeoptStmt : public DtcCStatement {
+
+protected:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The dex pc where the interpreter resumes
+	uint32_t m_nDexPc;
+
+	// The latest webs of the registers referred by the block before the point
+	DtcDexLiveWebTable_t m_rBlockWebs;
+
+	// The variables stored into the frame, which are resolved after the translation
+	vector<DtcCVarSymbol *> m_rStoreList;
+
+	// The condition of a guard (NULL for an unconditional point)
+	DtcCExpression *m_pCondExpr;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcCDeoptStmt(uint32_t nDexPc, DtcDexLiveWebTable_t &rBlockWebs, 
+		DtcCStmtType_t nType = DTC_C_STMT_DEOPT);
+
+	virtual ~DtcCDeoptStmt();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the dex pc where the interpreter resumes.
+	 *
+	 * @return the dex pc
+	 */
+	inline uint32_t GetDexPc()					{ return m_nDexPc;		}
+
+	/**
+	 * This function will return the latest webs of the registers in the block.
+	 *
+	 * @return the table of the webs indexed by the register number
+	 */
+	inline DtcDexLiveWebTable_t &GetBlockWebs()	{ return m_rBlockWebs;	}
+
+	/**
+	 * This function will add a variable to be stored into the frame.
+	 *
+	 * @param pSym the variable symbol
+	 */
+	inline void AppendStore(DtcCVarSymbol *pSym)	{ m_rStoreList.push_back(pSym);	}
+
+	/**
+	 * This function will make the point a guard deoptimizing only if the condition holds.
+	 *
+	 * @param pCondExpr the condition expression
+	 */
+	inline void SetCondExpr(DtcCExpression *pCondExpr)	{ m_pCondExpr = pCondExpr;	}
+
+	/**
+	 * This function will return the condition of the guard.
+	 *
+	 * @return the condition expression (NULL for an unconditional point)
+	 */
+	inline DtcCExpression *GetCondExpr()		{ return m_pCondExpr;	}
+
+	/**
+	 * This function will return the variables stored into the frame.
+	 *
+	 * @return the list of the variables
+	 */
+	inline vector<DtcCVarSymbol *> &GetStoreList()	{ return m_rStoreList;	}
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(DtcCodeBuffer &rOut, uint32_t &nIndent);
+
+protected:
+
+	void WriteStores(DtcCodeBuffer &rOut, uint32_t nIndent);
+};
+
+///////////////////////////////////////////////////////////////////////
+// DtcCHelperStmt Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * A call to the runtime helper executing a dex instruction on the frame of the
+ * interpreter, which lowers the instructions not translated inline. The registers
+ * used by the instruction are stored into the frame before the call and the ones
+ * defined by it are loaded after the call. The call is a safepoint, so the other live
+ * references are stored too, where the collector finds them. The helper leaves the
+ * instruction to the interpreter by failing, where the statement deoptimizes like 
+ * DtcCDeoptStmt.
+ */
+class DtcCHelperStmt : public DtcCDeoptStmt {
+
+protected:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The variables used by the instruction
+	vector<DtcCVarSymbol *> m_rUseList;
+
+	// The variables defined by the instruction
+	vector<DtcCVarSymbol *> m_rLoadList;
+
+	// The live references not used by the instruction, which are resolved after the translation
+	vector<DtcCVarSymbol *> m_rSpillList;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcCHelperStmt(uint32_t nDexPc, DtcDexLiveWebTable_t &rBlockWebs);
+
+	virtual ~DtcCHelperStmt();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will add a variable used by the instruction.
+	 *
+	 * @param pSym the variable symbol
+	 */
+	inline void AppendUse(DtcCVarSymbol *pSym)		{ m_rUseList.push_back(pSym);	}
+
+	/**
+	 * This function will add a variable defined by the instruction.
+	 *
+	 * @param pSym the variable symbol
+	 */
+	inline void AppendLoad(DtcCVarSymbol *pSym)	{ m_rLoadList.push_back(pSym);	}
+
+	/**
+	 * This function will add a live reference to be stored before the call.
+	 *
+	 * @param pSym the variable symbol
+	 */
+	inline void AppendSpill(DtcCVarSymbol *pSym)	{ m_rSpillList.push_back(pSym);	}
+
+	/**
+	 * This function will return the variables used by the instruction.
+	 *
+	 * @return the list of the variables
+	 */
+	inline vector<DtcCVarSymbol *> &GetUseList()	{ return m_rUseList;		}
+
+	/**
+	 * This function will return the variables defined by the instruction.
+	 *
+	 * @return the list of the variables
+	 */
+	inline vector<DtcCVarSymbol *> &GetLoadList()	{ return m_rLoadList;		}
+
+	/**
+	 * This function will return the live references stored before the call.
+	 *
+	 * @return the list of the variables
+	 */
+	inline vector<DtcCVarSymbol *> &GetSpillList()	{ return m_rSpillList;	}
+
+	/**
+	 * This function will return the variable defined by the fused move-result.
+	 *
+	 * @return the variable symbol (NULL if there is no fused move-result)
+	 */
+	virtual DtcCVarSymbol *GetResultSym()			{ return NULL;			}
+
+	/**
+	 * This function will return the dex pc of the fused move-result.
+	 *
+	 * @return the dex pc
+	 */
+	virtual uint32_t GetResultPc()					{ return 0;				}
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(DtcCodeBuffer &rOut, uint32_t &nIndent);
+
+protected:
+
+	void WriteSpills(DtcCodeBuffer &rOut, uint32_t nIndent);
+
+	void WriteCall(DtcCodeBuffer &rOut, uint32_t nIndent);
+};
+
+///////////////////////////////////////////////////////////////////////
+// DtcCInvokeStmt Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * An invoke of a callee resolved at the translation, which calls the C function of the
+ * callee directly through its call cell once the callee is installed. The arguments are
+ * passed in the C parameters and the result is assigned from the C return value, and
+ * the runtime helper executes the invoke as before while the cell is unbound. A callee
+ * deoptimizing in the direct call makes the caller deoptimize at the invoke as well.
+ */
+class DtcCInvokeStmt : public DtcCHelperStmt {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The callee and its call cell
+	const Method *m_pCallee;
+	DtcCallCell_t *m_pCell;
+
+	// The receiver checked against null before the direct call (NULL for a static callee)
+	DtcCVarSymbol *m_pThisSym;
+
+	// The variable of the move-result fused with the invoke (NULL if there is none)
+	DtcCVarSymbol *m_pResultSym;
+
+	// The dex pc of the fused move-result
+	uint32_t m_nResultPc;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcCInvokeStmt(uint32_t nDexPc, DtcDexLiveWebTable_t &rBlockWebs, const Method *pCallee,
+		DtcCallCell_t *pCell);
+
+	virtual ~DtcCInvokeStmt();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will set the receiver of the callee.
+	 *
+	 * @param pSym the variable symbol of the receiver
+	 */
+	inline void SetThis(DtcCVarSymbol *pSym)		{ m_pThisSym = pSym;	}
+
+	/**
+	 * This function will fuse the move-result following the invoke.
+	 *
+	 * @param pSym the variable symbol defined by the move-result
+	 * @param nPc the dex pc of the move-result
+	 */
+	inline void SetResult(DtcCVarSymbol *pSym, uint32_t nPc) {
+		m_pResultSym = pSym;
+		m_nResultPc = nPc;
+	}
+
+	virtual DtcCVarSymbol *GetResultSym()			{ return m_pResultSym;	}
+
+	virtual uint32_t GetResultPc()					{ return m_nResultPc;	}
+
+	///////////////////////////////////////////////////////////////////
+	// Debugging Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual void Write(DtcCodeBuffer &rOut, uint32_t &nIndent);
+};
+
+///////////////////////////////////////////////////////////////////////
+// DtcCReturnStmt Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+class DtcCReturnStmt : public DtcCStatement {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// Return value expression (NULL for return-void)
+	DtcCIdExpr *m_pValueExpr;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcCReturnStmt(DtcCIdExpr *pValueExpr);
+
+	virtual ~DtcCReturnStmt();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the expression of the return value.
+	 *
+	 * @return the return value expression
+	 */
+	inline DtcCIdExpr *GetValueExpr()			{ return m_pValueExpr;	}
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 
-	virtual void Write(ostream &pOut, uint32_t &nIndent);
+	virtual void Write(DtcCodeBuffer &rOut, uint32_t &nIndent);
 };
 
 #endif
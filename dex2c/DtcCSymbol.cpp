@@ -25,10 +25,10 @@ DtcCSymbol::~DtcCSymbol(void) {
 	// Do nothing
 }
 
-ostream &operator <<(ostream &pOut, DtcCSymbol *pSymbol) {
+DtcCodeBuffer &operator <<(DtcCodeBuffer &rOut, DtcCSymbol *pSymbol) {
 	
-	pSymbol->Write(pOut);
-	return pOut;
+	pSymbol->Write(rOut);
+	return rOut;
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -38,9 +38,14 @@ ostream &operator <<(ostream &pOut, DtcCSymbol *pSymbol) {
 DtcCVarSymbol::DtcCVarSymbol(DtcDexLiveWeb *pWeb)
 :DtcCSymbol(DTC_C_SYM_VAR) {
 
-	DTC_ASSERT(m_pWeb != NULL);
+	DTC_ASSERT(pWeb != NULL);
 
 	m_pWeb = pWeb;
+
+	// The name is made once in a fixed buffer and copied at each occurrence
+	DtcCodeBuffer name(m_pName, STR_LEN);
+	pWeb->Write(name);
+	name.GetString();
 }	
 
 DtcCVarSymbol::~DtcCVarSymbol() {
@@ -57,6 +62,7 @@ DtcCVarSymbol::GetTypeString() {
 
 	static const char *dataTypeString[] = {
 
+		NULL,
 		"j_boolean",
 		"j_byte",
 		"j_char",
@@ -81,16 +87,17 @@ DtcCVarSymbol::GetTypeString() {
 }
 
 void
-DtcCVarSymbol::Write(ostream &pOut) {
+DtcCVarSymbol::Write(DtcCodeBuffer &rOut) {
 
-	pOut << m_pWeb;
+	rOut << m_pName;
 }
 
 ///////////////////////////////////////////////////////////////////////
 // DtcCFuncSymbol Class Definition
 ///////////////////////////////////////////////////////////////////////
 
-DtcCFuncSymbol::DtcCFuncSymbol(const char *pFuncName) {
+DtcCFuncSymbol::DtcCFuncSymbol(const char *pFuncName)
+:DtcCSymbol(DTC_C_SYM_FUNC) {
 
 	m_pFuncName = pFuncName;
 
@@ -101,9 +108,9 @@ DtcCFuncSymbol::~DtcCFuncSymbol() {
 }
 
 void
-DtcCFuncSymbol::Write(ostream &pOut) {
+DtcCFuncSymbol::Write(DtcCodeBuffer &rOut) {
 
-	pOut << m_pFuncName; 
+	rOut << m_pFuncName; 
 };
 
 
@@ -125,64 +132,73 @@ DtcCConstSymbol::~DtcCConstSymbol() {
 	// Do nothing
 }
 
+/**
+ * This function will print out the constant. The floating-point constants are given
+ * by their bits, so no precision is lost by the decimal notation.
+ *
+ * @param rOut output buffer
+ */
 void
-DtcCConstSymbol::Write(ostream &pOut) {
+DtcCConstSymbol::Write(DtcCodeBuffer &rOut) {
 
-	char buf[STR_LEN];
-	
-	struct {uint32_t h; uint32_t l;} value64b = {m_nHigh32, m_nLow32};		
-	
 	switch(m_nDataType) {
 		case J_BOOLEAN:	
-			sprintf(buf, "(j_boolean)%d", (j_boolean)m_nLow32);
+			rOut << "(j_boolean)" << (int32_t)(j_boolean)m_nLow32;
 			break;
 		case J_BYTE:		
-			sprintf(buf, "(j_byte)%d", (j_byte)m_nLow32);
+			rOut << "(j_byte)" << (int32_t)(j_byte)m_nLow32;
 			break;
 		case J_CHAR:	
-			sprintf(buf, "(j_char)%d", (j_char)m_nLow32);
+			rOut << "(j_char)" << (int32_t)(j_char)m_nLow32;
 			break;
 		case J_SHORT:	
-			sprintf(buf, "(j_short)%d", (j_short)m_nLow32);
+			rOut << "(j_short)" << (int32_t)(j_short)m_nLow32;
 			break;
 		case J_INT:		
-			sprintf(buf, "(j_int)%d", (j_int)m_nLow32);
+			rOut << "(j_int)" << (int32_t)m_nLow32;
 			break;
 		case J_LONG:		
-			sprintf(buf, "(j_long)%ld", *((j_long *)&value64b));
+			rOut << "(j_long)0x";
+			rOut.AppendHex(((uint64_t)m_nHigh32 << 32) | m_nLow32, 16) << "ULL";
 			break;
 		case J_FLOAT:	
-			sprintf(buf, "(j_float)%f", (j_float)m_nLow32);
+			rOut << "DTC_ARG(j_float, 0x";
+			rOut.AppendHex(m_nLow32, 8) << "u)";
 			break;
 		case J_DOUBLE:	
-			sprintf(buf, "(j_double)%lf", *((j_double *)&value64b));
+			rOut << "DTC_ARG_WIDE(j_double, 0x";
+			rOut.AppendHex(m_nLow32, 8) << "u, 0x";
+			rOut.AppendHex(m_nHigh32, 8) << "u)";
 			break;
 		case J_OBJECT:			
-			sprintf(buf, "(j_object)0x%08X", (j_object)m_nLow32);
+			rOut << "(j_object)0x";
+			rOut.AppendHex(m_nLow32, 8);
 			break;			
 		default:			
-			sprintf(buf, "(Unknown data type)0x%04X04X", m_nHigh32, m_nLow32);
+			rOut << "(Unknown data type)0x";
+			rOut.AppendHex(m_nHigh32, 8).AppendHex(m_nLow32, 8);
 			break;
 	}
-
-	pOut << buf;
 }
 
 ///////////////////////////////////////////////////////////////////////
 // DtcCLabelSymbol Class Definition
 ///////////////////////////////////////////////////////////////////////
 
-DtcCLabelSymbol::DtcCLabelSymbol(uint32_t nLabelValue) {
+DtcCLabelSymbol::DtcCLabelSymbol(uint32_t nLabelValue)
+:DtcCSymbol(DTC_C_SYM_LABEL) {
 
-	char *buf = (char *)malloc(STR_LEN);
-	sprintf(buf, "%08X", nLabelValue);
-	m_pLabelString = buf;
+	DtcCodeBuffer label(m_pLabelBuf, STR_LEN);
+	label.AppendHex(nLabelValue, 8).GetString();
+	m_pLabelString = m_pLabelBuf;
+	m_nLabelValue = nLabelValue;
 }
 
-DtcCLabelSymbol::DtcCLabelSymbol(const char *pLabelString) {
+DtcCLabelSymbol::DtcCLabelSymbol(const char *pLabelString)
+:DtcCSymbol(DTC_C_SYM_LABEL) {
 
 	m_pLabelString = pLabelString;
-
+	m_nLabelValue = 0;
 }
 	
 DtcCLabelSymbol::~DtcCLabelSymbol() {
@@ -190,7 +206,7 @@ DtcCLabelSymbol::~DtcCLabelSymbol() {
 }
 
 void
-DtcCLabelSymbol::Write(ostream &pOut) {
+DtcCLabelSymbol::Write(DtcCodeBuffer &rOut) {
 
-	pOut << ".L" << m_pLabelString; 
+	rOut << 'L' << m_pLabelString;
 };
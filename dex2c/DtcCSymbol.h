@@ -14,6 +14,8 @@
 #define _DTC_C_SYMBOL_H_
 
 #include "DtcCommon.h"
+#include "DtcArena.h"
+#include "DtcCodeBuffer.h"
 #include "DtcDexLiveWeb.h"
 
 typedef union {
@@ -41,6 +43,7 @@ typedef enum {
 	DTC_C_SYM_VAR,
 	DTC_C_SYM_LABEL,
 	DTC_C_SYM_CONST,
+	DTC_C_SYM_FUNC,
 
 	// The number of the C symbol types
 	DTC_C_NUM_OF_SYM,
@@ -51,7 +54,7 @@ typedef enum {
 // DtcCSymbol Class Declaration
 ///////////////////////////////////////////////////////////////////////
 
-class DtcCSymbol {
+class DtcCSymbol : public DtcArenaObject {
 
 protected :
 	///////////////////////////////////////////////////////////////////
@@ -70,13 +73,24 @@ public:
 	
 	virtual ~DtcCSymbol(void);
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the type of this symbol.
+	 *
+	 * @return the symbol type
+	 */
+	inline DtcCSymbolType_t GetType()			{ return m_nType;		}
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 
-	virtual void Write(ostream &pOut) = 0;
+	virtual void Write(DtcCodeBuffer &rOut) = 0;
 	
-	friend ostream &operator << (ostream &pOut, DtcCSymbol *pSymbol);
+	friend DtcCodeBuffer &operator << (DtcCodeBuffer &rOut, DtcCSymbol *pSymbol);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -92,6 +106,9 @@ private :
 
 	DtcDexLiveWeb *m_pWeb;
 
+	// The name of the variable, which is made once at the construction
+	char m_pName[STR_LEN];
+
 public:
 	///////////////////////////////////////////////////////////////////
 	// Constructor & Destructor Declaration
@@ -101,16 +118,19 @@ public:
 	
 	virtual ~DtcCVarSymbol();
 
+	/**
+	 * This function will return the live web of this variable symbol.
+	 *
+	 * @return the live web
+	 */
+	inline DtcDexLiveWeb *GetWeb()			{ return m_pWeb;		}
+
 	/**
 	 * This function will return the name of this variable symbol.
 	 * 
 	 * @return the name of the varable symbol
 	 */
-	inline const char *GetNameString() {
-		strstream o;
-		m_pWeb->Write(o);
-		return o.str();
-	}
+	inline const char *GetNameString()		{ return m_pName;		}
 
 	const char *GetTypeString();
 
@@ -118,7 +138,7 @@ public:
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 
-	virtual void Write(ostream &pOut);
+	virtual void Write(DtcCodeBuffer &rOut);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -147,7 +167,7 @@ public:
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 
-	virtual void Write(ostream &pOut);
+	virtual void Write(DtcCodeBuffer &rOut);
 };
 
 
@@ -176,11 +196,36 @@ public:
 	
 	virtual ~DtcCConstSymbol();
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the data type of the constant.
+	 *
+	 * @return the data type
+	 */
+	inline DtcDexDataType_t GetDataType()		{ return m_nDataType;	}
+
+	/**
+	 * This function will return the upper 32 bits of the constant.
+	 *
+	 * @return the upper 32 bits
+	 */
+	inline uint32_t GetHigh32()				{ return m_nHigh32;		}
+
+	/**
+	 * This function will return the lower 32 bits of the constant.
+	 *
+	 * @return the lower 32 bits
+	 */
+	inline uint32_t GetLow32()				{ return m_nLow32;		}
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 
-	virtual void Write(ostream &pOut);
+	virtual void Write(DtcCodeBuffer &rOut);
 };
 
 ///////////////////////////////////////////////////////////////////////
@@ -196,6 +241,12 @@ private :
 
 	const char *m_pLabelString;
 
+	// The buffer of the label string made from the dex address
+	char m_pLabelBuf[STR_LEN];
+
+	// The dex address of the label (0 for the named labels)
+	uint32_t m_nLabelValue;
+
 public:
 	///////////////////////////////////////////////////////////////////
 	// Constructor & Destructor Declaration
@@ -207,11 +258,22 @@ public:
 	
 	virtual ~DtcCLabelSymbol();
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the dex address indicated by the label.
+	 *
+	 * @return the dex address of the label
+	 */
+	inline uint32_t GetLabelValue()			{ return m_nLabelValue;	}
+
 	///////////////////////////////////////////////////////////////////
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 
-	virtual void Write(ostream &pOut);
+	virtual void Write(DtcCodeBuffer &rOut);
 };
 
 #endif
@@ -0,0 +1,197 @@
+/*********************************************************************
+*   DtcCSymbolTable.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include "DtcCSymbolTable.h"
+
+///////////////////////////////////////////////////////////////////////
+// Constructor & Destructor Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcCSymbolTable::DtcCSymbolTable() {
+
+	m_pSlots = NULL;
+	m_nSlotMask = 0;
+
+	m_rSymbolList.clear();
+	m_rMergedList.clear();
+}
+
+DtcCSymbolTable::~DtcCSymbolTable() {
+
+	Clear();
+}
+
+///////////////////////////////////////////////////////////////////////
+// Member Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will return the canonical symbol of the C variable of the given web,
+ * which is made at the first reference to the variable.
+ *
+ * @param pWeb a live web
+ * @return the canonical symbol
+ */
+DtcCVarSymbol *
+DtcCSymbolTable::Intern(DtcDexLiveWeb *pWeb) {
+
+	if(pWeb == NULL) return NULL;
+
+	// Keep the load factor under a half
+	if(2 * (m_rSymbolList.size() + 1) > m_nSlotMask) {
+		Rehash();
+	}
+
+	uint32_t key = GetKey(pWeb);
+	DtcCSymbolSlot_t *slot = Probe(key);
+
+	if(slot->nKey == key) {
+		return slot->pSymbol;
+	}
+
+	DtcCVarSymbol *sym = new DtcCVarSymbol(pWeb);
+
+	slot->nKey = key;
+	slot->pSymbol = sym;
+
+	m_rSymbolList.push_back(sym);
+
+	return sym;
+}
+
+/**
+ * This function will find the canonical symbol of the C variable of the given web.
+ *
+ * @param pWeb a live web
+ * @return the canonical symbol, or NULL if the variable is not referenced
+ */
+DtcCVarSymbol *
+DtcCSymbolTable::Find(DtcDexLiveWeb *pWeb) {
+
+	if(pWeb == NULL || m_pSlots == NULL) return NULL;
+
+	uint32_t key = GetKey(pWeb);
+	DtcCSymbolSlot_t *slot = Probe(key);
+
+	return (slot->nKey == key) ? slot->pSymbol : NULL;
+}
+
+/**
+ * This function will move all the symbols of the given table into this table. The
+ * symbols of the variables already in this table are kept alive for their references,
+ * but the symbols of this table remain canonical.
+ *
+ * @param rTable the table to be merged, which is left empty
+ */
+void
+DtcCSymbolTable::Merge(DtcCSymbolTable &rTable) {
+
+	for(uint32_t i = 0; i < rTable.m_rSymbolList.size(); i++) {
+
+		DtcCVarSymbol *sym = rTable.m_rSymbolList[i];
+
+		if(2 * (m_rSymbolList.size() + 1) > m_nSlotMask) {
+			Rehash();
+		}
+
+		uint32_t key = GetKey(sym->GetWeb());
+		DtcCSymbolSlot_t *slot = Probe(key);
+
+		if(slot->nKey == key) {
+			m_rMergedList.push_back(sym);
+			continue;
+		}
+
+		slot->nKey = key;
+		slot->pSymbol = sym;
+
+		m_rSymbolList.push_back(sym);
+	}
+
+	m_rMergedList.insert(m_rMergedList.end(), rTable.m_rMergedList.begin(),
+		rTable.m_rMergedList.end());
+
+	// The symbols are owned by this table from now on
+	rTable.m_rSymbolList.clear();
+	rTable.m_rMergedList.clear();
+	rTable.Clear();
+}
+
+/**
+ * This function will delete all the symbols. The expressions referring to the symbols
+ * must be deleted before.
+ */
+void
+DtcCSymbolTable::Clear() {
+
+	for(uint32_t i = 0; i < m_rSymbolList.size(); i++) {
+		delete m_rSymbolList[i];
+	}
+
+	for(uint32_t i = 0; i < m_rMergedList.size(); i++) {
+		delete m_rMergedList[i];
+	}
+
+	m_rSymbolList.clear();
+	m_rMergedList.clear();
+
+	free(m_pSlots);
+
+	m_pSlots = NULL;
+	m_nSlotMask = 0;
+}
+
+/**
+ * This function will find the slot of the given key, or the empty slot where the key
+ * is to be inserted.
+ *
+ * @param nKey the key of a variable
+ * @return the slot
+ */
+DtcCSymbolSlot_t *
+DtcCSymbolTable::Probe(uint32_t nKey) {
+
+	// Fibonacci hashing spreads the neighboring registers over the slots
+	uint32_t index = (nKey * 2654435761u) & m_nSlotMask;
+
+	while(m_pSlots[index].nKey != nKey && m_pSlots[index].nKey != DTC_SYMBOL_EMPTY_KEY) {
+		index = (index + 1) & m_nSlotMask;
+	}
+
+	return &m_pSlots[index];
+}
+
+/**
+ * This function will double the slots and insert the canonical symbols again.
+ */
+void
+DtcCSymbolTable::Rehash() {
+
+	uint32_t size = (m_pSlots == NULL) ? DTC_SYMBOL_TABLE_SIZE : 2 * (m_nSlotMask + 1);
+
+	free(m_pSlots);
+
+	m_pSlots = (DtcCSymbolSlot_t *)malloc(size * sizeof(DtcCSymbolSlot_t));
+	m_nSlotMask = size - 1;
+
+	// Every byte of an empty key is 0xFF
+	memset(m_pSlots, 0xFF, size * sizeof(DtcCSymbolSlot_t));
+
+	for(uint32_t i = 0; i < m_rSymbolList.size(); i++) {
+
+		DtcCVarSymbol *sym = m_rSymbolList[i];
+		DtcCSymbolSlot_t *slot = Probe(GetKey(sym->GetWeb()));
+
+		slot->nKey = GetKey(sym->GetWeb());
+		slot->pSymbol = sym;
+	}
+}
@@ -0,0 +1,127 @@
+/*********************************************************************
+*   DtcCSymbolTable.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_C_SYMBOL_TABLE_H_
+#define _DTC_C_SYMBOL_TABLE_H_
+
+#include "DtcCommon.h"
+#include "DtcCSymbol.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// The initial number of the slots, which must be a power of two
+#define DTC_SYMBOL_TABLE_SIZE		64
+
+// The key never made from a web, whose register number is 16 bits
+#define DTC_SYMBOL_EMPTY_KEY		0xFFFFFFFF
+
+typedef vector<DtcCVarSymbol *> DtcCVarSymbolList_t;
+
+// A slot of the hash table
+typedef struct {
+
+	// The key of the variable (DTC_SYMBOL_EMPTY_KEY for an empty slot)
+	uint32_t nKey;
+
+	DtcCVarSymbol *pSymbol;
+
+} DtcCSymbolSlot_t;
+
+///////////////////////////////////////////////////////////////////////
+// DtcCSymbolTable Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * The symbol table interns the variable symbols, so all the references to a C variable
+ * share a single symbol made at the first reference. A C variable is named after the
+ * register and the data type of its webs, which are packed into the key of an open
+ * addressing hash table. The table owns the symbols and keeps them in the order of
+ * their creation, which is the order of the declarations.
+ */
+class DtcCSymbolTable {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The slots probed linearly from the hash of the key
+	DtcCSymbolSlot_t *m_pSlots;
+	uint32_t m_nSlotMask;
+
+	// The canonical symbols in the order of their creation
+	DtcCVarSymbolList_t m_rSymbolList;
+
+	// The symbols of the same variables interned by the other tables, which are
+	// referenced by their expressions and owned by this table after a merge
+	DtcCVarSymbolList_t m_rMergedList;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcCSymbolTable();
+
+	virtual ~DtcCSymbolTable();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the number of the canonical symbols.
+	 *
+	 * @return the number of the symbols
+	 */
+	inline uint32_t GetSize()					{ return m_rSymbolList.size();	}
+
+	/**
+	 * This function will return a canonical symbol in the order of the creation.
+	 *
+	 * @param nIndex the index of the symbol
+	 * @return the symbol
+	 */
+	inline DtcCVarSymbol *GetSymbol(uint32_t nIndex)	{ return m_rSymbolList[nIndex];	}
+
+	/**
+	 * This function will return the key of the C variable of the given web.
+	 *
+	 * @param pWeb a live web
+	 * @return the key of the variable
+	 */
+	static inline uint32_t GetKey(DtcDexLiveWeb *pWeb) {
+		return ((uint32_t)pWeb->GetRegnum() << 8) | (uint32_t)pWeb->GetDataType();
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcCVarSymbol *Intern(DtcDexLiveWeb *pWeb);
+
+	DtcCVarSymbol *Find(DtcDexLiveWeb *pWeb);
+
+	void Merge(DtcCSymbolTable &rTable);
+
+	void Clear();
+
+private:
+
+	DtcCSymbolSlot_t *Probe(uint32_t nKey);
+
+	void Rehash();
+};
+
+#endif
@@ -0,0 +1,76 @@
+/*********************************************************************
+*   DtcCallCell.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <pthread.h>
+
+#include "DtcCallCell.h"
+
+///////////////////////////////////////////////////////////////////////
+// Static Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+// The cells of the methods, which are looked up by the translating threads
+static map<const Method *, DtcCallCell_t *> s_rCellTable;
+
+static pthread_mutex_t s_rCellLock = PTHREAD_MUTEX_INITIALIZER;
+
+///////////////////////////////////////////////////////////////////////
+// Global Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will return the call cell of the given method, which is created
+ * unbound if the method has never been installed.
+ *
+ * @param pMethod the resolved method
+ * @return the call cell
+ */
+DtcCallCell_t *
+dtcGetCallCell(const Method *pMethod) {
+
+	pthread_mutex_lock(&s_rCellLock);
+
+	DtcCallCell_t *&cell = s_rCellTable[pMethod];
+
+	if(cell == NULL) {
+
+		cell = new DtcCallCell_t;
+		cell->pDirect = NULL;
+	}
+
+	DtcCallCell_t *result = cell;
+
+	pthread_mutex_unlock(&s_rCellLock);
+
+	return result;
+}
+
+/**
+ * This function will bind the call cell of the given method to its C function. It is
+ * called whenever the method is installed, so the callers compiled before the method
+ * switch to the direct call from then on.
+ *
+ * @param pMethod the installed method
+ * @param pDirect the C function taking the argument words
+ */
+void
+dtcBindCallCell(const Method *pMethod, void *pDirect) {
+
+	DtcCallCell_t *cell = dtcGetCallCell(pMethod);
+
+	// The code must be visible before the callers can see the function
+	ANDROID_MEMBAR_STORE();
+
+	cell->pDirect = pDirect;
+
+	DTC_TRACE(DEX2C_TAG, "dtcBindCallCell - %s to %p", pMethod->name, pDirect);
+}
@@ -0,0 +1,44 @@
+/*********************************************************************
+*   DtcCallCell.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_CALL_CELL_H_
+#define _DTC_CALL_CELL_H_
+
+#include "DtcCommon.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+/*
+ * The call cell of a method, through which the compiled callers call the C function
+ * of the method directly with the arguments in the C parameters. A cell is never freed,
+ * so its address is embedded into the generated code of the callers, and the cell is
+ * bound whenever the method is installed. The same layout is declared as struct dtc_cell
+ * in the header of the generated code.
+ */
+typedef struct {
+
+	// The C function taking the argument words (NULL until the method is installed)
+	void * volatile pDirect;
+
+} DtcCallCell_t;
+
+///////////////////////////////////////////////////////////////////////
+// Global Function Declaration
+///////////////////////////////////////////////////////////////////////
+
+DtcCallCell_t *dtcGetCallCell(const Method *pMethod);
+
+void dtcBindCallCell(const Method *pMethod, void *pDirect);
+
+#endif
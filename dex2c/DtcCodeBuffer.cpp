@@ -0,0 +1,379 @@
+/*********************************************************************
+*   DtcCodeBuffer.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include "DtcCodeBuffer.h"
+
+///////////////////////////////////////////////////////////////////////
+// Constructor & Destructor Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * Constructor of DtcCodeBuffer class for the memory owned by the buffer
+ *
+ * @param nCapacity the initial size of the memory
+ */
+DtcCodeBuffer::DtcCodeBuffer(uint32_t nCapacity /* = DTC_CODE_BUFFER_SIZE */) {
+
+	m_nKind = DTC_CODE_BUF_HEAP;
+	m_nCapacity = (nCapacity > 0) ? nCapacity : DTC_CODE_BUFFER_SIZE;
+	m_pData = (char *)malloc(m_nCapacity);
+	m_nLength = 0;
+	m_nFd = -1;
+	m_bOwnFd = FALSE;
+	m_bOverflow = FALSE;
+	m_bAllocFailed = FALSE;
+
+	if(m_pData == NULL) {
+		DTC_ERROR(DEX2C_TAG, "DtcCodeBuffer - Fail to allocate %d bytes", m_nCapacity);
+		m_nCapacity = 0;
+		m_bAllocFailed = TRUE;
+	}
+}
+
+/**
+ * Constructor of DtcCodeBuffer class for the memory handed by the caller
+ *
+ * @param pMemory the memory, which must be kept during the lifetime of the buffer
+ * @param nCapacity the size of the memory
+ */
+DtcCodeBuffer::DtcCodeBuffer(char *pMemory, uint32_t nCapacity) {
+
+	m_nKind = DTC_CODE_BUF_FIXED;
+	m_pData = pMemory;
+	m_nCapacity = nCapacity;
+	m_nLength = 0;
+	m_nFd = -1;
+	m_bOwnFd = FALSE;
+	m_bOverflow = FALSE;
+	m_bAllocFailed = FALSE;
+}
+
+DtcCodeBuffer::~DtcCodeBuffer() {
+
+	if(m_nKind == DTC_CODE_BUF_FILE) {
+		CloseFile();
+	}
+
+	if(m_nKind == DTC_CODE_BUF_HEAP) {
+		free(m_pData);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// Member Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will write the following bytes into the given file through a shared
+ * mapping of the file, which is grown with the buffer. The bytes written so far are
+ * copied into the file once.
+ *
+ * @param nFd the file opened for reading and writing
+ * @return error information
+ */
+DtcError_t
+DtcCodeBuffer::MapFile(int nFd) {
+
+	if(m_nKind == DTC_CODE_BUF_FILE || nFd < 0) {
+		return DTC_ERROR_INVALID_PARAMETER;
+	}
+
+	uint32_t capacity = (m_nCapacity > m_nLength + 1) ? m_nCapacity : DTC_CODE_BUFFER_SIZE;
+
+	while(capacity <= m_nLength) capacity *= 2;
+
+	if(ftruncate(nFd, capacity) != 0) {
+		DTC_ERROR(DEX2C_TAG, "MapFile - Fail to resize the file to %d bytes", capacity);
+		return DTC_ERROR_MEMORY_ALLOC;
+	}
+
+	void *data = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, nFd, 0);
+
+	if(data == MAP_FAILED) {
+		DTC_ERROR(DEX2C_TAG, "MapFile - Fail to map %d bytes", capacity);
+		return DTC_ERROR_MEMORY_ALLOC;
+	}
+
+	if(m_nLength > 0) memcpy(data, m_pData, m_nLength);
+
+	if(m_nKind == DTC_CODE_BUF_HEAP) {
+		free(m_pData);
+	}
+
+	m_nKind = DTC_CODE_BUF_FILE;
+	m_pData = (char *)data;
+	m_nCapacity = capacity;
+	m_nFd = nFd;
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will unmap the file and cut it to the bytes written. The buffer is
+ * left empty with a heap memory allocated by the next append, and the file is not
+ * closed.
+ *
+ * @return error information
+ */
+DtcError_t
+DtcCodeBuffer::UnmapFile() {
+
+	if(m_nKind != DTC_CODE_BUF_FILE) {
+		return DTC_ERROR_INVALID_PARAMETER;
+	}
+
+	DtcError_t error = DTC_SUCCESS;
+
+	munmap(m_pData, m_nCapacity);
+
+	if(ftruncate(m_nFd, m_nLength) != 0) {
+		DTC_ERROR(DEX2C_TAG, "UnmapFile - Fail to resize the file to %d bytes", m_nLength);
+		error = DTC_ERROR_MEMORY_ALLOC;
+	}
+
+	if(m_bOwnFd == TRUE) {
+		close(m_nFd);
+	}
+
+	m_nKind = DTC_CODE_BUF_HEAP;
+	m_nCapacity = 0;
+	m_pData = NULL;
+	m_nLength = 0;
+	m_nFd = -1;
+	m_bOwnFd = FALSE;
+
+	return error;
+}
+
+/**
+ * This function will create the given file and write the following bytes into it
+ * through the mapping of the file. A private file must not exist yet, so that
+ * neither an existing file nor a symbolic link planted at the path is written.
+ *
+ * @param pPath the path of the file
+ * @param bPrivate whether the file is newly created only for the owner
+ * @return error information
+ */
+DtcError_t
+DtcCodeBuffer::OpenFile(const char *pPath, bool_t bPrivate /* = FALSE */) {
+
+	DtcError_t error;
+
+	int fd = bPrivate ? open(pPath, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW, 0600) :
+		open(pPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+	if(fd < 0) {
+		DTC_ERROR(DEX2C_TAG, "OpenFile - Fail to open %s", pPath);
+		return DTC_ERROR_INVALID_PARAMETER;
+	}
+
+	if((error = MapFile(fd)) != DTC_SUCCESS) {
+		close(fd);
+		return error;
+	}
+
+	m_bOwnFd = TRUE;
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will finish the file opened by OpenFile, which is cut to the bytes
+ * written and closed.
+ *
+ * @return error information
+ */
+DtcError_t
+DtcCodeBuffer::CloseFile() {
+
+	// The reason of a truncation is taken before the unmapping resets the buffer
+	DtcError_t truncation = GetError();
+	DtcError_t error = UnmapFile();
+
+	if(error == DTC_SUCCESS && truncation != DTC_SUCCESS) {
+		DTC_ERROR(DEX2C_TAG, "CloseFile - The code is truncated");
+		error = truncation;
+	}
+
+	return error;
+}
+
+/**
+ * This function will append a null-terminated string.
+ *
+ * @param pStr the string
+ * @return the buffer
+ */
+DtcCodeBuffer &
+DtcCodeBuffer::Append(const char *pStr) {
+
+	if(pStr == NULL) return *this;
+
+	return Append(pStr, (uint32_t)strlen(pStr));
+}
+
+/**
+ * This function will append the given bytes.
+ *
+ * @param pStr the bytes
+ * @param nLength the number of the bytes
+ * @return the buffer
+ */
+DtcCodeBuffer &
+DtcCodeBuffer::Append(const char *pStr, uint32_t nLength) {
+
+	if(m_bAllocFailed == TRUE || nLength == 0) return *this;
+
+	if(m_nLength + nLength >= m_nCapacity && Grow(nLength) == FALSE) {
+
+		// Keep the head of the bytes in a fixed memory
+		nLength = (m_nCapacity > m_nLength + 1) ? m_nCapacity - m_nLength - 1 : 0;
+
+		if(nLength == 0) return *this;
+	}
+
+	memcpy(m_pData + m_nLength, pStr, nLength);
+	m_nLength += nLength;
+
+	return *this;
+}
+
+/**
+ * This function will append the decimal digits of a signed integer.
+ *
+ * @param nValue the integer
+ * @return the buffer
+ */
+DtcCodeBuffer &
+DtcCodeBuffer::AppendInt(int64_t nValue) {
+
+	if(nValue >= 0) return AppendUInt((uint64_t)nValue);
+
+	Append('-');
+
+	// The magnitude of the minimum value does not fit into the signed type
+	return AppendUInt((uint64_t)0 - (uint64_t)nValue);
+}
+
+/**
+ * This function will append the decimal digits of an unsigned integer.
+ *
+ * @param nValue the integer
+ * @return the buffer
+ */
+DtcCodeBuffer &
+DtcCodeBuffer::AppendUInt(uint64_t nValue) {
+
+	char digits[24];
+	uint32_t pos = sizeof(digits);
+
+	do {
+		digits[--pos] = (char)('0' + (nValue % 10));
+		nValue /= 10;
+	} while(nValue != 0);
+
+	return Append(digits + pos, sizeof(digits) - pos);
+}
+
+/**
+ * This function will append the upper-case hexadecimal digits of an integer without
+ * any prefix, which are padded with zeros to the given width.
+ *
+ * @param nValue the integer
+ * @param nWidth the minimum number of the digits
+ * @return the buffer
+ */
+DtcCodeBuffer &
+DtcCodeBuffer::AppendHex(uint64_t nValue, uint32_t nWidth /* = 0 */) {
+
+	static const char hexDigits[] = "0123456789ABCDEF";
+
+	char digits[16];
+	uint32_t pos = sizeof(digits);
+
+	if(nWidth > sizeof(digits)) nWidth = sizeof(digits);
+
+	do {
+		digits[--pos] = hexDigits[nValue & 0xF];
+		nValue >>= 4;
+	} while(nValue != 0);
+
+	while(sizeof(digits) - pos < nWidth) {
+		digits[--pos] = '0';
+	}
+
+	return Append(digits + pos, sizeof(digits) - pos);
+}
+
+/**
+ * This function will grow the memory to take the given number of the bytes more.
+ *
+ * @param nSize the number of the bytes to be appended
+ * @return TRUE if the bytes fit into the memory
+ */
+bool_t
+DtcCodeBuffer::Grow(uint32_t nSize) {
+
+	uint32_t capacity = (m_nCapacity > 0) ? m_nCapacity : DTC_CODE_BUFFER_SIZE;
+
+	// One more byte is kept for the terminating null
+	while(capacity <= m_nLength + nSize) capacity *= 2;
+
+	switch(m_nKind) {
+
+		case DTC_CODE_BUF_HEAP: {
+
+			char *data = (char *)realloc(m_pData, capacity);
+
+			if(data == NULL) {
+				DTC_ERROR(DEX2C_TAG, "Grow - Fail to allocate %d bytes", capacity);
+				m_bAllocFailed = TRUE;
+				break;
+			}
+
+			m_pData = data;
+			m_nCapacity = capacity;
+			return TRUE;
+		}
+
+		case DTC_CODE_BUF_FILE: {
+
+			void *data = MAP_FAILED;
+
+			if(ftruncate(m_nFd, capacity) == 0) {
+				data = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_nFd, 0);
+			}
+
+			if(data == MAP_FAILED) {
+				DTC_ERROR(DEX2C_TAG, "Grow - Fail to map %d bytes", capacity);
+				m_bAllocFailed = TRUE;
+				break;
+			}
+
+			munmap(m_pData, m_nCapacity);
+
+			m_pData = (char *)data;
+			m_nCapacity = capacity;
+			return TRUE;
+		}
+
+		default:
+			break;
+	}
+
+	m_bOverflow = TRUE;
+
+	return FALSE;
+}
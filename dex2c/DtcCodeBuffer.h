@@ -0,0 +1,196 @@
+/*********************************************************************
+*   DtcCodeBuffer.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_CODE_BUFFER_H_
+#define _DTC_CODE_BUFFER_H_
+
+#include "DtcCommon.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+#define DTC_CODE_BUFFER_SIZE		(16 * 1024)
+
+// The kinds of the memory of a code buffer, which decide how the buffer grows
+typedef enum {
+	DTC_CODE_BUF_HEAP = 0,
+	DTC_CODE_BUF_FIXED,
+	DTC_CODE_BUF_FILE
+} DtcCodeBufferKind_t;
+
+///////////////////////////////////////////////////////////////////////
+// DtcCodeBuffer Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * A code buffer collects the generated code as bytes in a single memory, which is
+ * owned by the buffer, handed to the buffer by the caller, or mapped from a file.
+ * The integers are formatted in place, so the emission never allocates per token,
+ * and the heap and file memories are grown by doubling. A fixed memory is never
+ * grown and the bytes past its end are dropped.
+ */
+class DtcCodeBuffer {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcCodeBufferKind_t m_nKind;
+
+	// The memory, which always keeps a byte for the terminating null (NULL until a
+	// heap memory is allocated)
+	char *m_pData;
+
+	// The number of the bytes written and the size of the memory
+	uint32_t m_nLength;
+	uint32_t m_nCapacity;
+
+	// The file mapped into the memory (-1 for the other kinds)
+	int m_nFd;
+
+	// Whether the file is opened by the buffer and closed with the mapping
+	bool_t m_bOwnFd;
+
+	// Whether any byte is dropped since the last reset
+	bool_t m_bOverflow;
+
+	// Whether an allocation of the memory has failed since the last reset, after which
+	// every byte is dropped
+	bool_t m_bAllocFailed;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcCodeBuffer(uint32_t nCapacity = DTC_CODE_BUFFER_SIZE);
+
+	DtcCodeBuffer(char *pMemory, uint32_t nCapacity);
+
+	virtual ~DtcCodeBuffer();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the bytes written so far, which are not terminated.
+	 *
+	 * @return the address of the bytes
+	 */
+	inline const char *GetData()				{ return m_pData;		}
+
+	/**
+	 * This function will return the number of the bytes written so far.
+	 *
+	 * @return the number of the bytes
+	 */
+	inline uint32_t GetLength()				{ return m_nLength;		}
+
+	/**
+	 * This function will tell whether any byte has been dropped by a fixed memory
+	 * or a failure of the growth.
+	 *
+	 * @return TRUE if the code is truncated
+	 */
+	inline bool_t IsOverflow()				{ return m_bOverflow;	}
+
+	/**
+	 * This function will tell why the code is truncated.
+	 *
+	 * @return DTC_ERROR_MEMORY_ALLOC if an allocation has failed,
+	 *         DTC_ERROR_TOO_SHORT_BUFFER if a fixed memory is full, or DTC_SUCCESS
+	 */
+	inline DtcError_t GetError() {
+		return (m_bAllocFailed == TRUE) ? DTC_ERROR_MEMORY_ALLOC :
+			(m_bOverflow == TRUE) ? DTC_ERROR_TOO_SHORT_BUFFER : DTC_SUCCESS;
+	}
+
+	/**
+	 * This function will return the bytes written so far as a null-terminated string.
+	 *
+	 * @return the string
+	 */
+	inline const char *GetString() {
+		if(m_pData == NULL) return "";
+		m_pData[m_nLength] = '\0';
+		return m_pData;
+	}
+
+	/**
+	 * This function will discard the bytes written so far, keeping the memory.
+	 */
+	inline void Reset() {
+		m_nLength = 0;
+		m_bOverflow = FALSE;
+		m_bAllocFailed = FALSE;
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcError_t MapFile(int nFd);
+
+	DtcError_t UnmapFile();
+
+	DtcError_t OpenFile(const char *pPath, bool_t bPrivate = FALSE);
+
+	DtcError_t CloseFile();
+
+	/**
+	 * This function will append a character.
+	 *
+	 * @param nChar the character
+	 * @return the buffer
+	 */
+	inline DtcCodeBuffer &Append(char nChar) {
+
+		if(m_bAllocFailed == TRUE) return *this;
+
+		if(m_nLength + 1 < m_nCapacity || Grow(1) == TRUE) {
+			m_pData[m_nLength++] = nChar;
+		}
+
+		return *this;
+	}
+
+	DtcCodeBuffer &Append(const char *pStr);
+
+	DtcCodeBuffer &Append(const char *pStr, uint32_t nLength);
+
+	DtcCodeBuffer &AppendInt(int64_t nValue);
+
+	DtcCodeBuffer &AppendUInt(uint64_t nValue);
+
+	DtcCodeBuffer &AppendHex(uint64_t nValue, uint32_t nWidth = 0);
+
+	///////////////////////////////////////////////////////////////////
+	// Operator Definition
+	///////////////////////////////////////////////////////////////////
+
+	inline DtcCodeBuffer &operator << (char nChar)				{ return Append(nChar);		}
+	inline DtcCodeBuffer &operator << (const char *pStr)		{ return Append(pStr);		}
+	inline DtcCodeBuffer &operator << (int32_t nValue)			{ return AppendInt(nValue);	}
+	inline DtcCodeBuffer &operator << (uint32_t nValue)		{ return AppendUInt(nValue);	}
+	inline DtcCodeBuffer &operator << (DtcCodeBuffer &rBuffer)	{
+		return Append(rBuffer.GetData(), rBuffer.GetLength());
+	}
+
+private:
+
+	bool_t Grow(uint32_t nSize);
+};
+
+#endif
@@ -31,6 +31,7 @@
 #include "../../libdex/DexFile.h"
 #include "../../libdex/DexProto.h"
 #include "../../libdex/DexClass.h"
+#include "../../libdex/DexCatch.h"
 #include "../../libdex/DexOpcodes.h"
 #include "../../libdex/InstrUtils.h"
 #include "../../vm/Bits.h"
@@ -45,11 +46,64 @@ using namespace std;
 
 //#define INCLUDE_DEPRECATED
 
+// Emit the machine code directly from the C IR, falling back to the C backend
+#define DTC_ENABLE_NATIVE_BACKEND
+
+// Count the time of the compile phases and the outcome of the compiled methods
+#define DTC_ENABLE_STATS
+
+// The arguments of the external C compiler building a batch of the translated methods,
+// which must build for the 32-bit VM on the x86 hosts, and wrap the signed overflow as Java.
+// The compiler is executed directly without a shell, followed by "-o output input".
+#if defined(__i386__)
+#define DTC_CC_ARGS				"cc", "-m32", "-O2", "-fwrapv", "-fPIC", "-shared", "-w"
+#else
+#define DTC_CC_ARGS				"cc", "-O2", "-fwrapv", "-fPIC", "-shared", "-w"
+#endif
+
+// The directory under which a private directory is created for the temporary C sources
+// and shared objects of the batches
+#if defined(HAVE_ANDROID_OS)
+#define DTC_CACHE_DIR			"/data/local/tmp"
+#else
+#define DTC_CACHE_DIR			"/tmp"
+#endif
+
+// The latency budget of a batch compilation in milliseconds
+#define DTC_BATCH_BUDGET		200
+
+// The initial estimate of the compiler startup cost and the cost per dex code unit in microseconds
+#define DTC_CC_STARTUP_COST		30000
+#define DTC_CC_COST_PER_INSN	100
+
+// The methods having at least this number of the basic blocks are translated in parallel,
+// and each task of the thread pool takes a chunk of the basic blocks
+#define DTC_PARALLEL_BLOCK_THRESHOLD	64
+#define DTC_PARALLEL_BLOCK_CHUNK		16
+
+// The default numbers of the invocations and the backward branches making a method hot
+#define DTC_INVOKE_THRESHOLD		1000
+#define DTC_BRANCH_THRESHOLD		10000
+
+// The maximum number of the methods waiting for the compiler thread
+#define DTC_COMPILE_QUEUE_SIZE		256
+
+// The maximum number of the argument words of a method entered by the interpreter, which
+// has a shared entry stub for each number of the words up to it (see DtcBridge.cpp)
+#define DTC_ENTRY_MAX_INS			8
+
+// The methods having at least this number of the dex code units are compiled only in
+// the region of their hot blocks, and a block is hot if its execution count is at least
+// 1/DTC_REGION_HOT_FRACTION of the count of the hottest block
+#define DTC_REGION_INSNS_THRESHOLD	2048
+#define DTC_REGION_HOT_FRACTION		8
+
 #ifdef ANDROID_SUPPORT
 #include "Dalvik.h"
 #endif
 
 #include "DtcDebug.h"
+#include "DtcProfConfig.h"
 
 #define STR_LEN		32
 #define BUF_LEN		128
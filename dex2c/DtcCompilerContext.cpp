@@ -0,0 +1,247 @@
+/*********************************************************************
+*   DtcCompilerContext.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <pthread.h>
+
+#include "DtcCompilerContext.h"
+#include "DtcStats.h"
+
+///////////////////////////////////////////////////////////////////////
+// Static Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+// The key of the idle contexts of each thread
+static pthread_key_t s_nContextKey;
+static pthread_once_t s_nContextKeyOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * This function will release the idle contexts of an exiting thread.
+ *
+ * @param pArg the list of the idle contexts
+ */
+static void
+DestroyContexts(void *pArg) {
+
+	DtcCompilerContextList_t *contexts = (DtcCompilerContextList_t *)pArg;
+
+	for(uint32_t i = 0; i < contexts->size(); i++) {
+		delete (*contexts)[i];
+	}
+
+	delete contexts;
+}
+
+static void
+CreateContextKey() {
+
+	pthread_key_create(&s_nContextKey, DestroyContexts);
+}
+
+///////////////////////////////////////////////////////////////////////
+// Constructor & Destructor Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcCompilerContext::DtcCompilerContext() {
+
+	m_rDexMethodList.clear();
+	m_rCMethodList.clear();
+}
+
+DtcCompilerContext::~DtcCompilerContext() {
+
+	Reset();
+}
+
+///////////////////////////////////////////////////////////////////////
+// Member Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will translate the dex code of the given method into C code. The
+ * translated method stays valid until the context is reset.
+ *
+ * @param pMethod the resolved method to be translated
+ * @param pPool the thread pool translating the basic blocks of a large method in parallel
+ * @param pCMethod the translated C method (output)
+ * @param pBlockCounts the execution counts of the blocks selecting the region to be
+ *        translated (NULL to translate the whole method)
+ * @return error information
+ */
+DtcError_t
+DtcCompilerContext::Translate(Method *pMethod, DtcThreadPool *pPool, DtcCMethod *&pCMethod,
+	DtcBlockCountTable_t *pBlockCounts /* = NULL */) {
+
+	pCMethod = NULL;
+
+	if(pMethod == NULL) {
+		DTC_ERROR(DEX2C_TAG, "Invalid input Dex method - %X", pMethod);
+		return DTC_ERROR_INVALID_PARAMETER;
+	}
+
+	return Translate(new DtcDexMethod(pMethod), pPool, pCMethod, pBlockCounts);
+}
+
+/**
+ * This function will translate the given method of a dex file, which is not loaded
+ * by the VM, into C code.
+ *
+ * @param pDexFile the dex file including the method
+ * @param pDexMethod the method of the class data to be translated
+ * @param pPool the thread pool translating the basic blocks of a large method in parallel
+ * @param pCMethod the translated C method (output)
+ * @return error information
+ */
+DtcError_t
+DtcCompilerContext::Translate(DexFile *pDexFile, const DexMethod *pDexMethod, DtcThreadPool *pPool,
+	DtcCMethod *&pCMethod) {
+
+	pCMethod = NULL;
+
+	if(pDexFile == NULL || pDexMethod == NULL) {
+		DTC_ERROR(DEX2C_TAG, "Invalid input Dex method - %X", pDexMethod);
+		return DTC_ERROR_INVALID_PARAMETER;
+	}
+
+	return Translate(new DtcDexMethod(pDexFile, pDexMethod), pPool, pCMethod, NULL);
+}
+
+/**
+ * This function will build the IR of the given dex method and translate it into C
+ * code with the arena of the context bound to the calling thread.
+ *
+ * @param pDexMethod the dex method owned by the context from now on
+ * @param pPool the thread pool translating the basic blocks of a large method in parallel
+ * @param pCMethod the translated C method (output)
+ * @param pBlockCounts the execution counts of the blocks (NULL to translate the whole method)
+ * @return error information
+ */
+DtcError_t
+DtcCompilerContext::Translate(DtcDexMethod *pDexMethod, DtcThreadPool *pPool, DtcCMethod *&pCMethod,
+	DtcBlockCountTable_t *pBlockCounts) {
+
+	DtcError_t error;
+
+	// The contexts can be nested on a thread helping the pool, so the arena bound
+	// by the outer context is restored at the end
+	DtcArena *arena = DtcArena::GetCurrent();
+	DtcArena::SetCurrent(&m_rArena);
+
+	m_rDexMethodList.push_back(pDexMethod);
+
+	if((error = pDexMethod->BuildIR(pPool)) != DTC_SUCCESS) {
+
+		DTC_ERROR(DEX2C_TAG, "Translate - Build IR (error:%d)", error);
+		DtcArena::SetCurrent(arena);
+		return error;
+	}
+
+	// A large method is translated only in the region of its hot blocks
+	if(pBlockCounts != NULL) {
+		pDexMethod->SelectRegion(*pBlockCounts);
+	}
+
+	DtcCMethod *cMethod = new DtcCMethod(pDexMethod);
+
+	m_rCMethodList.push_back(cMethod);
+
+	DTC_PHASE_BEGIN(TRANSLATE);
+	error = cMethod->Translate(pPool);
+	DTC_PHASE_END(TRANSLATE);
+
+	if(error != DTC_SUCCESS) {
+
+		DTC_ERROR(DEX2C_TAG, "Translate - Translate Dex to C (error:%d)", error);
+		DtcArena::SetCurrent(arena);
+		return error;
+	}
+
+	DtcArena::SetCurrent(arena);
+
+	pCMethod = cMethod;
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will release all the methods translated by the context. The C
+ * methods are released first because they refer to the dex methods.
+ */
+void
+DtcCompilerContext::Reset() {
+
+	for(uint32_t i = 0; i < m_rCMethodList.size(); i++) {
+		delete m_rCMethodList[i];
+	}
+
+	for(uint32_t i = 0; i < m_rDexMethodList.size(); i++) {
+		delete m_rDexMethodList[i];
+	}
+
+	m_rCMethodList.clear();
+	m_rDexMethodList.clear();
+
+	m_rArena.Reset();
+}
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will take an idle context of the calling thread, or create a new
+ * one if there is none. The contexts are reused without any lock since each thread
+ * has its own contexts, and a thread running a nested task while waiting for the
+ * pool simply takes another one.
+ *
+ * @return the context
+ */
+DtcCompilerContext *
+DtcCompilerContext::Acquire() {
+
+	pthread_once(&s_nContextKeyOnce, CreateContextKey);
+
+	DtcCompilerContextList_t *contexts = (DtcCompilerContextList_t *)pthread_getspecific(s_nContextKey);
+
+	if(contexts == NULL || contexts->empty()) {
+		return new DtcCompilerContext();
+	}
+
+	DtcCompilerContext *context = contexts->back();
+	contexts->pop_back();
+
+	return context;
+}
+
+/**
+ * This function will reset the given context and keep it for the next acquisition
+ * on the calling thread.
+ *
+ * @param pContext the context taken by Acquire
+ */
+void
+DtcCompilerContext::Release(DtcCompilerContext *pContext) {
+
+	if(pContext == NULL) return;
+
+	pthread_once(&s_nContextKeyOnce, CreateContextKey);
+
+	pContext->Reset();
+
+	DtcCompilerContextList_t *contexts = (DtcCompilerContextList_t *)pthread_getspecific(s_nContextKey);
+
+	if(contexts == NULL) {
+		contexts = new DtcCompilerContextList_t;
+		pthread_setspecific(s_nContextKey, contexts);
+	}
+
+	contexts->push_back(pContext);
+}
@@ -0,0 +1,113 @@
+/*********************************************************************
+*   DtcCompilerContext.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_COMPILER_CONTEXT_H_
+#define _DTC_COMPILER_CONTEXT_H_
+
+#include "DtcCommon.h"
+#include "DtcArena.h"
+#include "DtcCMethod.h"
+#include "DtcDexMethod.h"
+#include "DtcThreadPool.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+class DtcCompilerContext;
+
+typedef vector<DtcCompilerContext *> DtcCompilerContextList_t;
+
+///////////////////////////////////////////////////////////////////////
+// DtcCompilerContext Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * A compiler context owns all the state of the translations, so that several
+ * methods can be translated at the same time by different contexts. The IR is
+ * allocated from the arena of the context and released at once by the reset,
+ * and the memory of the arena is reused by the next translation.
+ */
+class DtcCompilerContext {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The arena of the IR objects
+	DtcArena m_rArena;
+
+	// The methods translated since the last reset
+	DtcDexMethodList_t m_rDexMethodList;
+	DtcCMethodList_t m_rCMethodList;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcCompilerContext();
+
+	virtual ~DtcCompilerContext();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the C methods translated since the last reset.
+	 *
+	 * @return the list of the C methods
+	 */
+	inline DtcCMethodList_t &GetCMethods()		{ return m_rCMethodList;	}
+
+	/**
+	 * This function will return the dex method translated last, which is kept even if
+	 * the translation fails.
+	 *
+	 * @return the dex method (NULL if no method is translated since the last reset)
+	 */
+	inline DtcDexMethod *GetLastDexMethod() {
+		return m_rDexMethodList.empty() ? NULL : m_rDexMethodList.back();
+	}
+
+	/**
+	 * This function will return the arena of the context.
+	 *
+	 * @return the arena
+	 */
+	inline DtcArena *GetArena()				{ return &m_rArena;		}
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcError_t Translate(Method *pMethod, DtcThreadPool *pPool, DtcCMethod *&pCMethod,
+		DtcBlockCountTable_t *pBlockCounts = NULL);
+
+	DtcError_t Translate(DexFile *pDexFile, const DexMethod *pDexMethod, DtcThreadPool *pPool,
+		DtcCMethod *&pCMethod);
+
+	void Reset();
+
+	static DtcCompilerContext *Acquire();
+
+	static void Release(DtcCompilerContext *pContext);
+
+private:
+
+	DtcError_t Translate(DtcDexMethod *pDexMethod, DtcThreadPool *pPool, DtcCMethod *&pCMethod,
+		DtcBlockCountTable_t *pBlockCounts);
+};
+
+#endif
@@ -10,8 +10,131 @@
 *   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
 ******************************************************************************/
 
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
 #include "DtcDebug.h"
 
+//////////////////////////////////////////////////
+// User-defined Type Definition
+//////////////////////////////////////////////////
+
+// A trace message kept as it is recorded
+typedef struct {
+
+	const char *sTag;
+	const char *sFmt;
+
+	uint32_t nArgs;
+	intptr_t pArgs[DTC_TRACE_MAX_ARGS];
+
+} DtcTraceEntry_t;
+
+/*
+ * The trace buffer of a thread, which is a ring written only by the thread and read
+ * only by the flusher. The writer publishes an entry by advancing the head after the 
+ * entry is written, and the reader frees the entries by advancing the tail after they 
+ * are formatted, so no lock is needed. The messages are dropped while the ring is full.
+ */
+typedef struct DtcTraceRing {
+
+	DtcTraceEntry_t pEntries[DTC_TRACE_RING_SIZE];
+
+	volatile uint32_t nHead;
+	volatile uint32_t nTail;
+
+	// The number of the messages dropped by the writer, and the number of them reported
+	volatile uint32_t nDropped;
+	uint32_t nReported;
+
+	pid_t nThreadId;
+
+	struct DtcTraceRing *pNext;
+
+} DtcTraceRing_t;
+
+//////////////////////////////////////////////////
+// Static Variable Definition
+//////////////////////////////////////////////////
+
+// The key of the trace buffer bound to each thread
+static pthread_key_t s_nTraceKey;
+static pthread_once_t s_nTraceKeyOnce = PTHREAD_ONCE_INIT;
+
+// The trace buffers of all the threads, which are never released
+static DtcTraceRing_t * volatile s_pTraceRings = NULL;
+
+// The lock serializing the flushes of the background thread and the callers
+static pthread_mutex_t s_rFlushLock = PTHREAD_MUTEX_INITIALIZER;
+
+//////////////////////////////////////////////////
+// Static Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * This function will format the trace messages periodically. It runs on the
+ * background thread and never returns.
+ *
+ * @param pArg unused
+ * @return never returns
+ */
+static void *
+TraceMain(void *pArg) {
+
+	while(TRUE) {
+
+		usleep(DTC_TRACE_FLUSH_INTERVAL);
+
+		DtcTraceFlush();
+	}
+
+	return NULL;
+}
+
+static void
+CreateTraceKey() {
+
+	pthread_t thread;
+
+	pthread_key_create(&s_nTraceKey, NULL);
+
+	if(pthread_create(&thread, NULL, TraceMain, NULL) == 0) {
+		pthread_detach(thread);
+	}
+}
+
+/**
+ * This function will return the trace buffer of the calling thread. The buffer is
+ * made on the first call of the thread and pushed to the global list.
+ *
+ * @return the trace buffer (NULL if out of memory)
+ */
+static DtcTraceRing_t *
+GetTraceRing() {
+
+	pthread_once(&s_nTraceKeyOnce, CreateTraceKey);
+
+	DtcTraceRing_t *ring = (DtcTraceRing_t *)pthread_getspecific(s_nTraceKey);
+
+	if(ring != NULL) return ring;
+
+	ring = (DtcTraceRing_t *)calloc(1, sizeof(DtcTraceRing_t));
+
+	if(ring == NULL) return NULL;
+
+	ring->nThreadId = (pid_t)syscall(__NR_gettid);
+
+	do {
+		ring->pNext = s_pTraceRings;
+	} while(!__sync_bool_compare_and_swap(&s_pTraceRings, ring->pNext, ring));
+
+	pthread_setspecific(s_nTraceKey, ring);
+
+	return ring;
+}
+
 //////////////////////////////////////////////////
 // Debugging Function Definition
 //////////////////////////////////////////////////
@@ -27,7 +150,7 @@ DtcDebugPrintln(const char *sTag, const char *sFmt, ...) {
 		
 	va_list args;
 	va_start(args, sFmt);
-	vsprintf(buf, sFmt, args);
+	vsnprintf(buf, sizeof(buf), sFmt, args);
 	va_end(args);
 
 #ifdef ANDROID_SUPPORT
@@ -37,3 +160,94 @@ DtcDebugPrintln(const char *sTag, const char *sFmt, ...) {
 #endif
 }
 
+/**
+ * This function will record a trace message in the buffer of the calling thread
+ * without formatting it. It is called through DTC_TRACE.
+ *
+ * @param sTag the tag of the message
+ * @param sFmt the format of the message
+ * @param nArgs the number of the arguments, which are integers or pointers
+ */
+void
+DtcTraceRecord(const char *sTag, const char *sFmt, uint32_t nArgs, ...) {
+
+	DtcTraceRing_t *ring = GetTraceRing();
+
+	if(ring == NULL) return;
+
+	uint32_t head = ring->nHead;
+
+	if(head - ring->nTail >= DTC_TRACE_RING_SIZE) {
+		ring->nDropped++;
+		return;
+	}
+
+	DtcTraceEntry_t &entry = ring->pEntries[head & (DTC_TRACE_RING_SIZE - 1)];
+
+	entry.sTag = sTag;
+	entry.sFmt = sFmt;
+	entry.nArgs = (nArgs < DTC_TRACE_MAX_ARGS) ? nArgs : DTC_TRACE_MAX_ARGS;
+
+	va_list args;
+	va_start(args, nArgs);
+
+	for(uint32_t i = 0; i < entry.nArgs; i++) {
+		entry.pArgs[i] = va_arg(args, intptr_t);
+	}
+
+	va_end(args);
+
+	// The entry must be complete before the flusher can see it
+	__sync_synchronize();
+
+	ring->nHead = head + 1;
+}
+
+/**
+ * This function will format and print out the trace messages recorded by all the 
+ * threads. It is called periodically by the background thread, and can be called 
+ * to flush the messages at once.
+ */
+void
+DtcTraceFlush() {
+
+	pthread_mutex_lock(&s_rFlushLock);
+
+	for(DtcTraceRing_t *ring = s_pTraceRings; ring != NULL; ring = ring->pNext) {
+
+		uint32_t tail = ring->nTail;
+		uint32_t head = ring->nHead;
+
+		// The entries up to the head are complete
+		__sync_synchronize();
+
+		for(; tail != head; tail++) {
+
+			DtcTraceEntry_t &entry = ring->pEntries[tail & (DTC_TRACE_RING_SIZE - 1)];
+			intptr_t *a = entry.pArgs;
+			char buf[256];
+
+			// The missing arguments are never read by the format
+			snprintf(buf, sizeof(buf), entry.sFmt, a[0], a[1], a[2], a[3], a[4], a[5]);
+
+			DtcDebugPrintln(entry.sTag, "[%d] %s", ring->nThreadId, buf);
+		}
+
+		// The entries are formatted before the writer can reuse them
+		__sync_synchronize();
+
+		ring->nTail = tail;
+
+		uint32_t dropped = ring->nDropped;
+
+		if(dropped != ring->nReported) {
+
+			DtcDebugPrintln(DEX2C_TAG, "[%d] %u trace messages dropped", ring->nThreadId,
+				dropped - ring->nReported);
+			ring->nReported = dropped;
+		}
+	}
+
+	pthread_mutex_unlock(&s_rFlushLock);
+}
+
@@ -42,6 +42,14 @@ typedef enum {
 	DTC_ERROR_BUILD_CONTROL_FLOW_GRAPH,
 	DTC_ERROR_ANALYSE_LIVENESS,
 	DTC_ERROR_DEX2C_TRANSLATION,
+	DTC_ERROR_DEOPT_AMBIGUOUS,
+
+	DTC_ERROR_NATIVE_UNSUPPORTED,
+	DTC_ERROR_NATIVE_CODE_GEN,
+
+	DTC_ERROR_BATCH_COMPILATION,
+	DTC_ERROR_BATCH_LOADING,
+	DTC_ERROR_BATCH_NO_COMPILER,
 
 	DTC_FAILURE,
 	
@@ -53,22 +61,76 @@ typedef enum {
 
 void DtcDebugPrintln(const char * sTag, const char * sFmt,...);
 
+void DtcTraceRecord(const char * sTag, const char * sFmt, uint32_t nArgs, ...);
+
+void DtcTraceFlush();
+
+//////////////////////////////////////////////////
+// Log Levels
+//////////////////////////////////////////////////
+
+// The messages below the log level are compiled out
+#define DTC_LOG_TRACE			0
+#define DTC_LOG_DEBUG			1
+#define DTC_LOG_ERROR			2
+#define DTC_LOG_NONE			3
+
+// The debug VM prints out the debugging messages, and the release VM only the errors.
+// The trace messages are enabled by building with -DDTC_LOG_LEVEL=DTC_LOG_TRACE.
+#ifndef DTC_LOG_LEVEL
+#if defined(DEBUG) && DEBUG
+#define DTC_LOG_LEVEL			DTC_LOG_DEBUG
+#else
+#define DTC_LOG_LEVEL			DTC_LOG_ERROR
+#endif
+#endif
+
+// The maximum number of the arguments of a trace message
+#define DTC_TRACE_MAX_ARGS		6
+
+// The number of the entries in the trace buffer of each thread (power of 2)
+#define DTC_TRACE_RING_SIZE		1024
+
+// The interval of the thread formatting the trace messages in microseconds
+#define DTC_TRACE_FLUSH_INTERVAL	10000
+
 //////////////////////////////////////////////////
 // Debug Interface Macros for DTC Debugging Functions
 //////////////////////////////////////////////////
 
-#define DTC_ENABLE_DEBUG
-#define DTC_ENABLE_ERROR
 #define DTC_ENABLE_ASSERT
 #define DTC_ENABLE_CHECK
 
+#if DTC_LOG_LEVEL <= DTC_LOG_DEBUG
+#define DTC_ENABLE_DEBUG
+#endif
+
+#if DTC_LOG_LEVEL <= DTC_LOG_ERROR
+#define DTC_ENABLE_ERROR
+#endif
+
+/*
+ * A trace message is recorded in the buffer of the calling thread as it is, and formatted
+ * later by a background thread, so it never blocks the compiler. The arguments are kept 
+ * as the machine words, so a trace message can take at most DTC_TRACE_MAX_ARGS integers 
+ * or pointers no wider than a word, and the strings must outlive the message.
+ */
+#define DTC_TRACE_NARGS(...)			DTC_TRACE_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define DTC_TRACE_NARGS_(_0, _1, _2, _3, _4, _5, _6, N, ...)	N
+
+#if DTC_LOG_LEVEL <= DTC_LOG_TRACE
+#define DTC_TRACE(TAG, FMT, ...)		DtcTraceRecord(TAG, FMT, DTC_TRACE_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#else
+#define DTC_TRACE(TAG, FMT, ...)		//
+#endif
+
 #ifdef DTC_ENABLE_DEBUG
 #define DTC_DEBUG(TAG, FMT, ...)		DtcDebugPrintln(TAG, FMT, ##__VA_ARGS__)
 #else
 #define DTC_DEBUG(TAG, FMT, ...)		//
 #endif
 
-#ifdef DTC_ENABLE_DEBUG
+#ifdef DTC_ENABLE_ERROR
 #define DTC_ERROR(TAG, FMT, ...)			DtcDebugPrintln(TAG" ERROR", FMT, ##__VA_ARGS__)
 #else
 #define DTC_ERROR(TAG, FMT, ...)			//
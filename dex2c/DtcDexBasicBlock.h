@@ -21,10 +21,12 @@
 // User-defined Type Definition
 ///////////////////////////////////////////////////////////////////////
 
-typedef vector<DtcDexcode *> DtcDexcodeList_t;
-
 typedef map<uint16_t, DtcDexLiveWeb *> DtcDexLiveWebTable_t;
 
+class DtcDexBasicBlock;
+
+typedef vector<DtcDexBasicBlock *> DtcDexBasicBlockList_t;
+
 ///////////////////////////////////////////////////////////////////////
 // DtcDexBasicBlock Class Declaration
 ///////////////////////////////////////////////////////////////////////
@@ -48,15 +50,24 @@ private :
 	// The size of the dex code
 	uint32_t m_nInsnsSize;
 
-	// Decoded dex code list
-	DtcDexcodeList_t m_rDexcodes;
+	// The instruction table of the method, and the rows of the basic block in it
+	DtcDexInsnTable *m_pInsnTable;
+	uint32_t m_nFirstInsn;
+	uint32_t m_nInsnCount;
+
+	// The dex code failing the analysis (m_nInsnCount if none)
+	uint32_t m_nFailedInsn;
+
+	// The live webs local to the basic block, which are owned by the block
+	DtcDexLiveWebList_t m_rLiveWebs;
 
 public :
 	///////////////////////////////////////////////////////////////////
 	// Constructor & Destructor Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	DtcDexBasicBlock(const uint16_t *pInsns, const uint8_t *pFlags, uint32_t nSpc, uint32_t nEpc);
+	DtcDexBasicBlock(const uint16_t *pInsns, const uint8_t *pFlags, uint32_t nSpc, uint32_t nEpc,
+		DtcDexInsnTable *pInsnTable, uint32_t nFirstInsn, uint32_t nInsnCount);
 	
 	virtual ~DtcDexBasicBlock();
 
@@ -66,6 +77,8 @@ public :
 
 	uint32_t ResolveDexcodes();
 
+	void ReleaseDexcodes();
+
 	DtcError_t AnalyseLiveness(DtcDexLiveWebTable_t &rLocalVarTable);
 
 	///////////////////////////////////////////////////////////////////
@@ -98,11 +111,36 @@ public :
 	inline uint32_t GetStartAddress()		{ return m_nStartAddress;	}
 
 	/**
-	 * This function will return the list of the dexcode objects.
+	 * This function will return the number of the dex codes.
+	 *
+	 * @return the number of the dex codes
+	 */
+	inline uint32_t GetDexcodeCount()		{ return m_nInsnCount;	}
+
+	/**
+	 * This function will return a dex code indicated by the given index.
+	 *
+	 * @param nIndex the index of the dex code in the basic block
+	 * @return the dex code
+	 */
+	inline DtcDexcode GetDexcode(uint32_t nIndex) {
+		return DtcDexcode(m_pInsnTable, m_nFirstInsn + nIndex);
+	}
+
+	/**
+	 * This function will return whether a dex code failed the analysis.
+	 *
+	 * @return TRUE if a dex code failed the analysis
+	 */
+	inline bool_t HasFailed()				{ return m_nFailedInsn < m_nInsnCount;	}
+
+	/**
+	 * This function will return the dex code failing the analysis, which is valid only
+	 * if HasFailed() is TRUE.
 	 *
-	 * @return the list of the dexcode obejcts
+	 * @return the dex code
 	 */
-	inline DtcDexcodeList_t &GetDexcodes()	{ return m_rDexcodes;	}
+	inline DtcDexcode GetFailedDexcode()		{ return GetDexcode(m_nFailedInsn);	}
 
 	///////////////////////////////////////////////////////////////////
 	// Debugging Function Declaration
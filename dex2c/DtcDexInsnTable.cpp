@@ -0,0 +1,240 @@
+/*********************************************************************
+*   DtcDexInsnTable.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include "DtcDexInsnTable.h"
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Declaration
+///////////////////////////////////////////////////////////////////////
+
+static uint32_t GetUseCapacity(DecodedInstruction &rDec);
+
+///////////////////////////////////////////////////////////////////////
+// Constructor & Destructor Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcDexInsnTable::DtcDexInsnTable() {
+
+	m_nSize = 0;
+	m_nCapacity = 0;
+	m_nUseSize = 0;
+	m_pMemory = NULL;
+
+	m_pOpcodes = NULL;
+	m_pPcs = NULL;
+	m_pVA = NULL;
+	m_pVB = NULL;
+	m_pVC = NULL;
+
+	m_ppDefWebs = NULL;
+
+	m_pUseBegin = NULL;
+	m_pUseCount = NULL;
+	m_ppUseWebs = NULL;
+}
+
+DtcDexInsnTable::~DtcDexInsnTable() {
+
+	Release();
+}
+
+///////////////////////////////////////////////////////////////////////
+// Member Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will prepare the columns for the instructions of a method. A method
+ * has no more instructions than its code units, so every column is allocated once
+ * before the instructions are decoded.
+ *
+ * @param nInsnsSize the number of the code units
+ * @return error information
+ */
+DtcError_t
+DtcDexInsnTable::Begin(uint32_t nInsnsSize) {
+
+	Release();
+
+	// The use slices depend on the register counts decoded from the instructions, so
+	// they are allocated apart from the other columns at the end
+	uint32_t capacity = nInsnsSize;
+	uint32_t rowBytes = sizeof(DtcDexLiveWeb *) + sizeof(uint32_t) * 4 + sizeof(uint8_t) * 2;
+
+	m_pMemory = (uint8_t *)malloc(capacity * rowBytes + sizeof(uint32_t) * (capacity + 1));
+
+	DTC_CHECK(m_pMemory != NULL, MEMORY_ALLOC);
+
+	// The wider columns come first to keep them aligned
+	uint8_t *column = m_pMemory;
+
+	m_ppDefWebs = (DtcDexLiveWeb **)column;	column += sizeof(DtcDexLiveWeb *) * capacity;
+	m_pPcs = (uint32_t *)column;			column += sizeof(uint32_t) * capacity;
+	m_pVA = (uint32_t *)column;			column += sizeof(uint32_t) * capacity;
+	m_pVB = (uint32_t *)column;			column += sizeof(uint32_t) * capacity;
+	m_pVC = (uint32_t *)column;			column += sizeof(uint32_t) * capacity;
+	m_pUseBegin = (uint32_t *)column;		column += sizeof(uint32_t) * (capacity + 1);
+	m_pOpcodes = column;					column += sizeof(uint8_t) * capacity;
+	m_pUseCount = column;
+
+	m_nCapacity = capacity;
+	m_nUseSize = 0;
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will decode an instruction into the next row. The caller walks the
+ * instructions with the returned width, and reads the row just decoded.
+ *
+ * @param pInsns the instructions of the method
+ * @param nPc the address of the instruction
+ * @return the width of the instruction, or 0 if the instruction is invalid
+ */
+uint32_t
+DtcDexInsnTable::DecodeNext(const uint16_t *pInsns, uint32_t nPc) {
+
+	uint32_t width = dexGetWidthFromInstruction(pInsns + nPc);
+
+	if(width == 0 || m_nSize >= m_nCapacity) return 0;
+
+	DecodedInstruction dec;
+	uint32_t row = m_nSize++;
+
+	dexDecodeInstruction(pInsns + nPc, &dec);
+
+	m_pOpcodes[row] = (uint8_t)dec.opcode;
+	m_pPcs[row] = nPc;
+	m_pVA[row] = dec.vA;
+	m_pVB[row] = dec.vB;
+	m_pVC[row] = dec.vC;
+
+	switch(dtcGetOpcodeInfo(dec.opcode)->nFormat) {
+
+		case kFmt35c: case kFmt35ms: case kFmt35mi: {
+
+			uint32_t args = 0;
+
+			for(uint32_t i = 0; i < dec.vA && i < 5; i++) {
+				args |= (dec.arg[i] & 0xF) << (4 * i);
+			}
+
+			m_pVC[row] = args;
+			break;
+		}
+
+		case kFmt51l: {
+
+			m_pVB[row] = (uint32_t)dec.vB_wide;
+			m_pVC[row] = (uint32_t)(dec.vB_wide >> 32);
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	m_ppDefWebs[row] = NULL;
+	m_pUseBegin[row] = m_nUseSize;
+	m_pUseCount[row] = 0;
+
+	m_nUseSize += GetUseCapacity(dec);
+
+	return width;
+}
+
+/**
+ * This function will finish the decoding and allocate the use slices of the rows.
+ *
+ * @return error information
+ */
+DtcError_t
+DtcDexInsnTable::End() {
+
+	m_pUseBegin[m_nSize] = m_nUseSize;
+
+	m_ppUseWebs = (DtcDexLiveWeb **)malloc(sizeof(DtcDexLiveWeb *) * (m_nUseSize > 0 ? m_nUseSize : 1));
+
+	DTC_CHECK(m_ppUseWebs != NULL, MEMORY_ALLOC);
+
+	DTC_TRACE(DEX2C_TAG, "Decode - %d rows, %d use slots", m_nSize, m_nUseSize);
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will forget the webs of the given rows, which are analysed again.
+ *
+ * @param nFirst the first row
+ * @param nCount the number of the rows
+ */
+void
+DtcDexInsnTable::ClearWebs(uint32_t nFirst, uint32_t nCount) {
+
+	for(uint32_t row = nFirst; row < nFirst + nCount && row < m_nSize; row++) {
+
+		m_ppDefWebs[row] = NULL;
+		m_pUseCount[row] = 0;
+	}
+}
+
+/**
+ * This function will release all the columns.
+ */
+void
+DtcDexInsnTable::Release() {
+
+	free(m_pMemory);
+	free(m_ppUseWebs);
+
+	m_nSize = 0;
+	m_nCapacity = 0;
+	m_nUseSize = 0;
+	m_pMemory = NULL;
+	m_ppUseWebs = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will return the number of the registers an instruction can read,
+ * which is the size of the use slice of the instruction.
+ *
+ * @param rDec the decoded instruction
+ * @return the number of the use webs
+ */
+static uint32_t
+GetUseCapacity(DecodedInstruction &rDec) {
+
+	const DtcDexOpcodeInfo_t *info = dtcGetOpcodeInfo(rDec.opcode);
+
+	switch(info->nUseKind) {
+
+		case DTC_USE_LIST:
+			return (rDec.vA < 5) ? rDec.vA : 5;
+
+		case DTC_USE_RANGE:
+			return rDec.vA;
+
+		default: {
+
+			uint32_t count = 0;
+
+			while(count < DTC_OPCODE_MAX_USES && info->pUseOperands[count] != DTC_OPND_NONE) {
+				count++;
+			}
+
+			return count;
+		}
+	}
+}
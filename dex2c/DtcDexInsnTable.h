@@ -0,0 +1,169 @@
+/*********************************************************************
+*   DtcDexInsnTable.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_DEX_INSN_TABLE_H_
+#define _DTC_DEX_INSN_TABLE_H_
+
+#include "DtcCommon.h"
+#include "DtcDexLiveWeb.h"
+#include "DtcDexOpcode.h"
+
+///////////////////////////////////////////////////////////////////////
+// DtcDexInsnTable Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * The instruction table keeps the decoded instructions of a method as columns of
+ * fixed-width arrays, one row for each instruction in the order of the addresses.
+ * All the columns are carved from a single allocation filled while the leaders of the
+ * basic blocks are detected, so the code is decoded once and the analyses walk the
+ * columns linearly. The def web of a row is kept in place, and the
+ * use webs of all the rows share a flat array, where each row owns a slice as large
+ * as the registers named by the instruction.
+ *
+ * The operands are kept as they are decoded except two formats. The registers of
+ * the 35c formats, which are 4 bits each, are packed into vC, and the upper half of
+ * the 64-bit literal of the 51l format is kept in vC.
+ */
+class DtcDexInsnTable {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The number of the rows, and the rows the columns can hold
+	uint32_t m_nSize;
+	uint32_t m_nCapacity;
+
+	// The number of the use slots of all the rows
+	uint32_t m_nUseSize;
+
+	// The memory of all the columns
+	uint8_t *m_pMemory;
+
+	// The columns of the decoded instructions
+	uint8_t *m_pOpcodes;
+	uint32_t *m_pPcs;
+	uint32_t *m_pVA;
+	uint32_t *m_pVB;
+	uint32_t *m_pVC;
+
+	// The def web of each row
+	DtcDexLiveWeb **m_ppDefWebs;
+
+	// The slices of the use webs, which start at m_pUseBegin and hold m_pUseCount webs
+	uint32_t *m_pUseBegin;
+	uint8_t *m_pUseCount;
+	DtcDexLiveWeb **m_ppUseWebs;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcDexInsnTable();
+
+	virtual ~DtcDexInsnTable();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the number of the rows.
+	 *
+	 * @return the number of the rows
+	 */
+	inline uint32_t GetSize()						{ return m_nSize;				}
+
+	inline Opcode GetOpcode(uint32_t nRow)			{ return (Opcode)m_pOpcodes[nRow];	}
+
+	inline uint32_t GetPc(uint32_t nRow)			{ return m_pPcs[nRow];			}
+
+	inline uint32_t GetVA(uint32_t nRow)			{ return m_pVA[nRow];			}
+
+	inline uint32_t GetVB(uint32_t nRow)			{ return m_pVB[nRow];			}
+
+	inline uint32_t GetVC(uint32_t nRow)			{ return m_pVC[nRow];			}
+
+	/**
+	 * This function will return a register of a 35c format instruction.
+	 *
+	 * @param nRow the row of the instruction
+	 * @param nIndex the index of the register (0 for vC, 4 for vG)
+	 * @return the register number
+	 */
+	inline uint32_t GetArg(uint32_t nRow, uint32_t nIndex) {
+		return (m_pVC[nRow] >> (4 * nIndex)) & 0xF;
+	}
+
+	/**
+	 * This function will return the 64-bit literal of a 51l format instruction.
+	 *
+	 * @param nRow the row of the instruction
+	 * @return the literal
+	 */
+	inline uint64_t GetVBWide(uint32_t nRow) {
+		return ((uint64_t)m_pVC[nRow] << 32) | m_pVB[nRow];
+	}
+
+	inline DtcDexLiveWeb *GetDefWeb(uint32_t nRow)	{ return m_ppDefWebs[nRow];		}
+
+	inline uint32_t GetDefCount(uint32_t nRow)		{ return (m_ppDefWebs[nRow] != NULL) ? 1 : 0;	}
+
+	inline uint32_t GetUseCount(uint32_t nRow)		{ return m_pUseCount[nRow];		}
+
+	inline DtcDexLiveWeb *GetUseWeb(uint32_t nRow, uint32_t nIndex) {
+		return (nIndex < m_pUseCount[nRow]) ? m_ppUseWebs[m_pUseBegin[nRow] + nIndex] : NULL;
+	}
+
+	/**
+	 * This function will set the def web of a row. An instruction defines one register
+	 * at most, and the def web set first is kept.
+	 *
+	 * @param nRow the row of the instruction
+	 * @param pWeb the def web
+	 */
+	inline void AppendDefWeb(uint32_t nRow, DtcDexLiveWeb *pWeb) {
+		if(m_ppDefWebs[nRow] == NULL) m_ppDefWebs[nRow] = pWeb;
+	}
+
+	/**
+	 * This function will append a use web to the slice of a row, which is as large as
+	 * the registers named by the instruction.
+	 *
+	 * @param nRow the row of the instruction
+	 * @param pWeb the use web
+	 */
+	inline void AppendUseWeb(uint32_t nRow, DtcDexLiveWeb *pWeb) {
+		if(m_pUseBegin[nRow] + m_pUseCount[nRow] < m_pUseBegin[nRow + 1]) {
+			m_ppUseWebs[m_pUseBegin[nRow] + m_pUseCount[nRow]++] = pWeb;
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcError_t Begin(uint32_t nInsnsSize);
+
+	uint32_t DecodeNext(const uint16_t *pInsns, uint32_t nPc);
+
+	DtcError_t End();
+
+	void ClearWebs(uint32_t nFirst, uint32_t nCount);
+
+	void Release();
+};
+
+#endif
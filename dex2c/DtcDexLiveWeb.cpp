@@ -40,6 +40,24 @@ DtcDexLiveWeb::~DtcDexLiveWeb() {
 void
 DtcDexLiveWeb::Write(ostream &pOut) {
 
+	char name[STR_LEN];
+
+	DtcCodeBuffer buf(name, STR_LEN);
+
+	Write(buf);
+
+	pOut << buf.GetString();
+}
+
+/**
+ * This function will print out the signature of the live web into the code buffer,
+ * which is used as the name of the C variable of the web.
+ *
+ * @param rOut output buffer
+ */
+void
+DtcDexLiveWeb::Write(DtcCodeBuffer &rOut) {
+
 	const static char typeCharArray[NUM_OF_JTYPES] = {
 		'x',	/* J_UNKNOWN */ 
 		'z',	/* J_BOOLEAN */
@@ -53,7 +71,7 @@ DtcDexLiveWeb::Write(ostream &pOut) {
 		'o',	/* J_OBJECT */
 	};
 
-	pOut << 'v' << typeCharArray[m_nDataType] << m_nRegnum;
+	rOut << 'v' << typeCharArray[m_nDataType] << (uint32_t)m_nRegnum;
 }
 
 ostream &operator << (ostream &pOut, DtcDexLiveWeb *pWeb) {
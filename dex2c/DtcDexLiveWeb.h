@@ -14,6 +14,8 @@
 #define _DTC_DEX_LIVE_WEB_H_
 
 #include "DtcCommon.h"
+#include "DtcArena.h"
+#include "DtcCodeBuffer.h"
 
 ///////////////////////////////////////////////////////////////////////
 // User-defined Type Definition
@@ -45,7 +47,7 @@ typedef enum {
 // DtcDexLiveWeb Class Declaration
 ///////////////////////////////////////////////////////////////////////
 
-class DtcDexLiveWeb {
+class DtcDexLiveWeb : public DtcArenaObject {
 
 private:
 	///////////////////////////////////////////////////////////////////
@@ -90,6 +92,13 @@ public:
 	 */
 	inline DtcDexDataType_t GetDataType()	{ return m_nDataType ; }
 
+	/**
+	 * This function will return the register number of the live web.
+	 * 
+	 * @return the register number
+	 */
+	inline uint16_t GetRegnum()				{ return m_nRegnum; }
+
 	/**
 	 * This function will indicate whether the web is for a local variable or not. 
 	 *
@@ -114,6 +123,8 @@ public:
 
 	virtual void Write(ostream &pOut);
 
+	void Write(DtcCodeBuffer &rOut);
+
 	friend ostream &operator << (ostream &pOut, DtcDexLiveWeb *pWeb);		
 };
 
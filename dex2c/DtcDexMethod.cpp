@@ -11,6 +11,8 @@
 **********************************************************************/
 
 #include "DtcDexMethod.h"
+#include "DtcDexOpcode.h"
+#include "DtcStats.h"
 
 ///////////////////////////////////////////////////////////////////////
 // Static Function Declaration
@@ -26,6 +28,26 @@ static void ResolveLocalVariableCb(void *pContext, u2 nReg, u4 nStartAddress,
 		        u4 nEndAddress, const char *pName, const char *pDescriptor,
 		        const char *pSignature);
 
+static void AnalyseBlocksTask(void *pArg);
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// A chunk of the basic blocks analysed by a task of the thread pool
+typedef struct {
+
+	// The range of the basic blocks
+	DtcDexBasicBlockTable_t::iterator rBegin;
+	DtcDexBasicBlockTable_t::iterator rEnd;
+
+	// The local variables shared by all the tasks, which are only read
+	DtcDexLiveWebTable_t *pLocalVarTable;
+
+	DtcError_t nError;
+
+} DtcDexBlockChunk_t;
+
 ///////////////////////////////////////////////////////////////////////
 // Constructor & Destructor Definition
 ///////////////////////////////////////////////////////////////////////
@@ -59,13 +81,70 @@ DtcDexMethod::DtcDexMethod(Method *pMethod /* = NULL */) {
 	// Get the method index of the original dex method 
 	m_nDexMethodIndex = m_pMethod->dexMethodIndex;
 
+	m_nAccessFlags = m_pMethod->accessFlags;
+
 	// Initialize the internal data 
 	m_rBasicBlockTable.clear();
 	m_rLocalVarTable.clear();
+	m_rLoopHeaderSet.clear();
+	m_rSuccBlockTable.clear();
+	m_rRegionSet.clear();
+	m_rLiveInTable.clear();
+	m_rCatchBlockTable.clear();
+}
+
+/**
+ * Constructor of DtcDexMethod class for the methods which are not loaded by the VM,
+ * such as the ones translated ahead of time on the host.
+ *
+ * @param pDexFile the dex file including the method
+ * @param pDexMethod the method of the class data to be translated into C code
+ */
+DtcDexMethod::DtcDexMethod(DexFile *pDexFile, const DexMethod *pDexMethod) {
+
+	m_pMethod = NULL;
+	m_nMethodIndex = 0;
+
+	// Check the validity of the given method
+	if(pDexFile == NULL || pDexMethod == NULL) {
+		DTC_ERROR(DEX2C_TAG, "DtcDexMethod - Null dex method");
+		m_pDexFile = NULL;
+		m_pDexCode = NULL;
+		return;
+	}
+
+	m_pDexFile = pDexFile;
+
+	m_pDexCode = dexGetCode(pDexFile, pDexMethod);
+
+	m_nDexMethodIndex = pDexMethod->methodIdx;
+
+	m_nAccessFlags = pDexMethod->accessFlags;
+
+	// Initialize the internal data 
+	m_rBasicBlockTable.clear();
+	m_rLocalVarTable.clear();
+	m_rLoopHeaderSet.clear();
+	m_rSuccBlockTable.clear();
+	m_rRegionSet.clear();
+	m_rLiveInTable.clear();
+	m_rCatchBlockTable.clear();
 }
 
 DtcDexMethod::~DtcDexMethod() {
 
+	DtcDexBasicBlockTable_t::iterator bbiter;
+
+	for(bbiter = m_rBasicBlockTable.begin(); bbiter != m_rBasicBlockTable.end(); bbiter++) {
+		delete bbiter->second;
+	}
+
+	DtcDexLiveWebTable_t::iterator lwiter;
+
+	for(lwiter = m_rLocalVarTable.begin(); lwiter != m_rLocalVarTable.end(); lwiter++) {
+		delete lwiter->second;
+	}
+
 	m_rBasicBlockTable.clear();
 	m_rLocalVarTable.clear();
 }
@@ -111,10 +190,11 @@ DtcDexMethod::GetDescriptor() {
 /**
  * This function will be used to build the intermediate representation using the dex code.
  *
+ * @param pPool the thread pool analysing the basic blocks of a large method in parallel
  * @return error information
  */
 DtcError_t
-DtcDexMethod::BuildIR() {
+DtcDexMethod::BuildIR(DtcThreadPool *pPool /* = NULL */) {
 
 	DTC_DEBUG(DEX2C_TAG, "DtcDexMethod->BuildIR Invoked...");
 	
@@ -123,13 +203,35 @@ DtcDexMethod::BuildIR() {
 	DtcCtrlDataTable_t ctrlDataTable;
 
 	// Resolve the local variables of the method
+	DTC_PHASE_BEGIN(RESOLVE_LOCALS);
 	error = ResolveLocalVariables();
+	DTC_PHASE_END(RESOLVE_LOCALS);
 	DTC_CHECK(error == DTC_SUCCESS, RESOLVE_LOCAL_VARS);
 
 	// Resolve the basic blocks using the sequence of the dex codes in the method
+	DTC_PHASE_BEGIN(RESOLVE_BLOCKS);
 	uint32_t nblock = ResolveBasicBlocks(ctrlDataTable);
+	DTC_PHASE_END(RESOLVE_BLOCKS);
 	DTC_CHECK(nblock != 0, RESOLVE_BASIC_BLOCKS);
 
+	// The targets of the backward branches are the loop headers, where the interpreter
+	// can enter the compiled code in the middle of a long running loop
+	DtcCtrlDataTable_t::iterator ctrliter;
+
+	m_rLoopHeaderSet.clear();
+
+	for(ctrliter = ctrlDataTable.begin(); ctrliter != ctrlDataTable.end(); ctrliter++) {
+
+		DtcCtrlDataEntry_t::iterator targetiter;
+
+		for(targetiter = ctrliter->second.begin(); targetiter != ctrliter->second.end(); targetiter++) {
+
+			if(*targetiter <= ctrliter->first) m_rLoopHeaderSet.insert(*targetiter);
+		}
+	}
+
+	ResolveSuccBlocks(ctrlDataTable);
+
 	// FIXED - YOUNGSUN
 	// Building the control flow graph is not required for the Dex-to-C translation.
 #if defined(INCLUDE_DEPRECATED) 
@@ -145,6 +247,19 @@ DtcDexMethod::BuildIR() {
 	// This is because we'd like to avoid the severe runtime overhead from the global 
 	// liveness analysis within the whole method. We guess all of the data types could 
 	// be resolved with only the local analysis. We have to do it globally, if it is wrong.
+
+	// The blocks are independent of each other, so a large method is analysed in parallel
+	if(pPool != NULL && nblock >= DTC_PARALLEL_BLOCK_THRESHOLD) {
+
+		error = AnalyseBlocksInParallel(pPool);
+
+		if(error != DTC_SUCCESS) {
+			DTC_ERROR(DEX2C_TAG, "BuildIR - Fail to analyse the liveness(error:%d)", error);
+			return DTC_ERROR_ANALYSE_LIVENESS;
+		}
+
+		return DTC_SUCCESS;
+	}
 	
 	DtcDexBasicBlockTable_t::iterator iter;
 
@@ -152,9 +267,15 @@ DtcDexMethod::BuildIR() {
 
 		DtcDexBasicBlock *block = iter->second;
 
-		if(block->ResolveDexcodes() > 0) {
+		DTC_PHASE_BEGIN(RESOLVE_DEXCODES);
+		uint32_t ncode = block->ResolveDexcodes();
+		DTC_PHASE_END(RESOLVE_DEXCODES);
 
+		if(ncode > 0) {
+
+			DTC_PHASE_BEGIN(ANALYSE_LIVENESS);
 			error = block->AnalyseLiveness(m_rLocalVarTable);
+			DTC_PHASE_END(ANALYSE_LIVENESS);
 
 			if(error != DTC_SUCCESS) {
 				DTC_ERROR(DEX2C_TAG, "BuildIR - Fail to analyse the liveness(error:%d)", error);
@@ -166,6 +287,54 @@ DtcDexMethod::BuildIR() {
 	return DTC_SUCCESS;
 }
 
+/**
+ * This function will resolve the dex codes and analyse the liveness of the basic blocks
+ * in parallel. The blocks are split into chunks, and each chunk is handled by a task.
+ *
+ * @param pPool the thread pool
+ * @return error information
+ */
+DtcError_t
+DtcDexMethod::AnalyseBlocksInParallel(DtcThreadPool *pPool) {
+
+	DTC_DEBUG(DEX2C_TAG, "DtcDexMethod->AnalyseBlocksInParallel Invoked...");
+
+	vector<DtcDexBlockChunk_t> chunks;
+	DtcDexBasicBlockTable_t::iterator iter = m_rBasicBlockTable.begin();
+
+	while(iter != m_rBasicBlockTable.end()) {
+
+		DtcDexBlockChunk_t chunk;
+
+		chunk.rBegin = iter;
+		chunk.pLocalVarTable = &m_rLocalVarTable;
+		chunk.nError = DTC_SUCCESS;
+
+		for(uint32_t i = 0; i < DTC_PARALLEL_BLOCK_CHUNK && iter != m_rBasicBlockTable.end(); i++) {
+			iter++;
+		}
+
+		chunk.rEnd = iter;
+		chunks.push_back(chunk);
+	}
+
+	// The chunks must not move while the tasks are running
+	DtcTaskGroup_t group = { 0 };
+
+	for(uint32_t i = 0; i < chunks.size(); i++) {
+		pPool->Submit(AnalyseBlocksTask, &chunks[i], &group);
+	}
+
+	pPool->Wait(&group);
+
+	for(uint32_t i = 0; i < chunks.size(); i++) {
+
+		if(chunks[i].nError != DTC_SUCCESS) return chunks[i].nError;
+	}
+
+	return DTC_SUCCESS;
+}
+
 /**
  * This funciton will resolve the data type of each of the local variables in the method.
  * Each pair of a register number and its data type will be kept in rLocalVarTable.  
@@ -184,7 +353,7 @@ DtcDexMethod::ResolveLocalVariables() {
 
 	// Resolve the local variables
 	dexDecodeDebugInfo(m_pDexFile, m_pDexCode, classDescriptor, methodId->protoIdx, 
-			m_pMethod->accessFlags, NULL, ResolveLocalVariableCb, &m_rLocalVarTable);
+			m_nAccessFlags, NULL, ResolveLocalVariableCb, &m_rLocalVarTable);
 
 	return DTC_SUCCESS;
 }
@@ -228,14 +397,10 @@ DtcDexMethod::ResolveBasicBlocks(DtcCtrlDataTable_t &rCtrlDataTable) {
 // Dex code
 #define OPCODE_FLAG							0x40
 #define CHECK_OPCODE(INDEX)					flags[INDEX] |= OPCODE_FLAG
-#define DEX_OPCODE(INDEX)						(insns[INDEX] & 0xFF)
-#define DEX_CODESIZE(INDEX)						(dexGetWidthFromInstruction(&insns[INDEX]))
 #define DEX_OPERAND16(INDEX)					(get2LE((uint8_t *)&insns[INDEX]))
 #define DEX_OPERAND32(INDEX)					(get4LE((uint8_t *)&insns[INDEX]))
 
 // Branch offset
-#define BRANCH_OFFSET8(INDEX)					((int32_t)(insns[INDEX] & 0xFF))
-#define BRANCH_OFFSET16(INDEX)					((int32_t)get2LE((uint8_t *)&insns[INDEX]))
 #define BRANCH_OFFSET32(INDEX)					((int32_t)get4LE((uint8_t *)&insns[INDEX]))
 
 // Leader
@@ -282,128 +447,99 @@ do {													\
 
 		uint32_t targetAddr = tries[i].startAddr + tries[i].insnCount;
 		
-		DTC_DEBUG(DEX2C_TAG, "Exception Try - 0x%X", tries[i].startAddr);
+		DTC_TRACE(DEX2C_TAG, "Exception Try - 0x%X", tries[i].startAddr);
 		CHECK_EXCEPTION_TRY(tries[i].startAddr);
 
-		DTC_DEBUG(DEX2C_TAG, "Exception Catch - 0x%X", targetAddr);
+		DTC_TRACE(DEX2C_TAG, "Exception Catch - 0x%X", targetAddr);
 		CHECK_EXCEPTION_CATCH(targetAddr);
 	}
 
 	// Start address of the function
 	CHECK_START();
 
-	for(uint32_t i = 0;  i < insnsSize;) {
+	// The instructions are decoded into the instruction table once, and the leaders 
+	// are found from the operands just decoded
+	if(m_rInsnTable.Begin(insnsSize) != DTC_SUCCESS) {
+		return 0;
+	}
+
+	for(uint32_t i = 0, row = 0;  i < insnsSize; row++) {
 	
-		CHECK_OPCODE(i);
+		uint32_t width = m_rInsnTable.DecodeNext(insns, i);
 
-		switch(DEX_OPCODE(i)) {
-
-			case OP_IF_EQ:		/* if-test vA, vB (0) + CCCC (1)*/ 
-			case OP_IF_NE:
-			case OP_IF_LT:
-			case OP_IF_GE:
-			case OP_IF_GT:
-			case OP_IF_LE:
-			case OP_IF_EQZ:
-			case OP_IF_NEZ:
-			case OP_IF_LTZ:
-			case OP_IF_GEZ:
-			case OP_IF_GTZ:
-			case OP_IF_LEZ: {
-
-				// Check the not taken and target addresses of the branch
-				CHECK_BRANCH_NOT_TAKEN(i, 2);
-				CHECK_BRANCH_TARGET(i, BRANCH_OFFSET16(i+1));
-
-				// Skip to the next instruction
-				INCREMENT_INDEX(2);
-				break;
-			}
-			case OP_GOTO: {		/* goto + AA (0) */
+		if(width == 0) {
 
-				// Check the branch target address
-				CHECK_BRANCH_TARGET(i, BRANCH_OFFSET8(i));
+			DTC_ERROR(DEX2C_TAG, "Invalid instruction - %d", i);
+			return 0;
+		}
 
-				// Skip to the next instruction
-				INCREMENT_INDEX(1);
-				break;
-			}	
-			case OP_GOTO_16: {	/* goto/16 (0) + AAAA (1) */
-				CHECK_BRANCH_TARGET(i, BRANCH_OFFSET16(i+1));
-				INCREMENT_INDEX(2);
-				break;
-			}
-			case OP_GOTO_32: {	/* goto/32 (0) + AAAAAAAA (1) */
-				CHECK_BRANCH_TARGET(i, BRANCH_OFFSET32(i+1));
-				INCREMENT_INDEX(3);
-				break;
-			}
-			case OP_PACKED_SWITCH: {
+		CHECK_OPCODE(i);
 
-				// Check this is a switch instruction 
-				CHECK_SWITCH(i);
-				
-				// Get the start position of the index table
-				uint32_t tableIndex = i + BRANCH_OFFSET32(i+1);
-
-				// Check the ID of the table
-				if(DEX_OPERAND16(tableIndex++) != 0x0100) {
-					
-					DTC_ERROR(DEX2C_TAG, "Invalid packed switch instruction - %d", i);
-					return 0;
-				}
+		const DtcDexOpcodeInfo_t *info = dtcGetOpcodeInfo(m_rInsnTable.GetOpcode(row));
 
-				// Get the number of entries in the table
-				uint16_t tableSize = DEX_OPERAND16(tableIndex++);
+		if(info->nFlags & DTC_OPF_BRANCH) {
 
-				// Skip the first key
-				tableIndex += 2;
+			int32_t offset = 0;
 
-				for(uint16_t j = 0; j < tableSize; j++, tableIndex += 2) {
+			// The branch offsets are sign-extended by the decoder
+			switch(info->nFormat) {
+				case kFmt10t: case kFmt20t: case kFmt30t:				/* goto +AA */
+					offset = (int32_t)m_rInsnTable.GetVA(row); break;
+				case kFmt21t:										/* if-testz vAA, +BBBB */
+					offset = (int32_t)m_rInsnTable.GetVB(row); break;
+				case kFmt22t:										/* if-test vA, vB, +CCCC */
+					offset = (int32_t)m_rInsnTable.GetVC(row); break;
+				default: break;
+			}
 
-					// Check each relative branch target
-					CHECK_BRANCH_TARGET(i, BRANCH_OFFSET32(tableIndex));
-				}
-				break;
+			// Check the not taken address of a conditional branch
+			if(info->nFlags & DTC_OPF_CONT) {
+				CHECK_BRANCH_NOT_TAKEN(i, width);
 			}
-			case OP_SPARSE_SWITCH: {
 
-				// Check this is a switch instruction 
-				CHECK_SWITCH(i);
+			// Check the branch target address
+			CHECK_BRANCH_TARGET(i, offset);
+		}
+		else if(info->nFlags & DTC_OPF_SWITCH) {
+
+			bool_t packed = (m_rInsnTable.GetOpcode(row) == OP_PACKED_SWITCH) ? TRUE : FALSE;
+
+			// Check this is a switch instruction 
+			CHECK_SWITCH(i);
+			
+			// Get the start position of the index table
+			uint32_t tableIndex = i + (int32_t)m_rInsnTable.GetVB(row);
+
+			// Check the ID of the table
+			if(DEX_OPERAND16(tableIndex++) != (packed ? 0x0100 : 0x0200)) {
 				
-				// Get the start position of the index table
-				uint32_t tableIndex = i + BRANCH_OFFSET32(i+1);
-
-				// Check the ID of the table
-				if(DEX_OPERAND16(tableIndex++) != 0x0200) {
-					
-					DTC_ERROR(DEX2C_TAG, "Invalid sparse switch instruction - %d", i);
-					return 0;
-				}
+				DTC_ERROR(DEX2C_TAG, "Invalid switch instruction - %d", i);
+				return 0;
+			}
 
-				// Get the number of entries in the table
-				uint16_t tableSize = DEX_OPERAND16(tableIndex++);
+			// Get the number of entries in the table
+			uint16_t tableSize = DEX_OPERAND16(tableIndex++);
 
-				// Skip the keys of the index table
-				tableIndex += (tableSize * 2);
+			// Skip the first key of the packed table, or all the keys of the sparse table
+			tableIndex += packed ? 2 : (tableSize * 2);
 
-				for(uint16_t j = 0; j < tableSize; j++, tableIndex += 2) {
+			for(uint16_t j = 0; j < tableSize; j++, tableIndex += 2) {
 
-					// Check each relative branch target
-					CHECK_BRANCH_TARGET(i, BRANCH_OFFSET32(tableIndex));
-				}
-				break;
+				// Check each relative branch target
+				CHECK_BRANCH_TARGET(i, BRANCH_OFFSET32(tableIndex));
 			}
-			case OP_RETURN:
-			case OP_RETURN_VOID:
-			case OP_RETURN_WIDE:
-			case OP_RETURN_OBJECT:
-			case OP_RETURN_VOID_BARRIER: 
-				CHECK_RETURN(i);
-			default:
-				INCREMENT_INDEX(DEX_CODESIZE(i));
-				break;
 		}
+		else if(info->nFlags & DTC_OPF_RETURN) {
+
+			CHECK_RETURN(i);
+		}
+
+		// Skip to the next instruction
+		INCREMENT_INDEX(width);
+	}
+
+	if(m_rInsnTable.End() != DTC_SUCCESS) {
+		return 0;
 	}
 	
 	//////////////////////////////////////////////////////////////
@@ -416,7 +552,7 @@ do {													\
 	
 	for(cdtIter=rCtrlDataTable.begin();cdtIter!=rCtrlDataTable.end();++cdtIter)
 	{
-		DTC_DEBUG(DEX2C_TAG, "Leader - 0x%04X", cdtIter->first);
+		DTC_TRACE(DEX2C_TAG, "Leader - 0x%04X", cdtIter->first);
 	}
 #endif
 
@@ -424,14 +560,20 @@ do {													\
 	uint32_t spc = 0;
 	uint32_t epc = 0;
 
-	// An index value for the previous instruction
-	uint32_t prevpc = 0;
+	// The first row of the basic block
+	uint32_t first = 0;
 
-	for(uint32_t i = 1; i < insnsSize; i++) {
+	// Only the addresses of the instructions can be the leaders, which are the rows 
+	// of the instruction table
+	for(uint32_t row = 1; row < m_rInsnTable.GetSize(); row++) {
+
+		uint32_t i = m_rInsnTable.GetPc(row);
 
 		// Each basic block will be comprised of the instructions between two adjacent leaders
 		if(IS_LEADER(i)) {
 
+			uint32_t prevpc = m_rInsnTable.GetPc(row - 1);
+
 			// If there are any missing leaders, check them additionally.   			
 			if(rCtrlDataTable.count(prevpc) == 0 && !IS_RETURN(prevpc)) {
 				
@@ -439,16 +581,17 @@ do {													\
 			}
 
 			// Build a new basic block using the instructions between the first and last instructions
-			m_rBasicBlockTable[spc] = new DtcDexBasicBlock(insns, flags, spc, (epc = i-1));
+			m_rBasicBlockTable[spc] = new DtcDexBasicBlock(insns, flags, spc, (epc = i-1), 
+				&m_rInsnTable, first, row - first);
 
 			// Get the first instruction of the next basic block
 			spc = i;
+			first = row;
 		}
-
-		if(IS_OPCODE(i))		prevpc = i;
 	}
 
-	m_rBasicBlockTable[spc] = new DtcDexBasicBlock(insns, flags, spc, insnsSize-1);
+	m_rBasicBlockTable[spc] = new DtcDexBasicBlock(insns, flags, spc, insnsSize-1,
+		&m_rInsnTable, first, m_rInsnTable.GetSize() - first);
 
 	// The number of the basic blocks
 	return (uint32_t)m_rBasicBlockTable.size();
@@ -496,6 +639,443 @@ DtcDexMethod::BuildControlFlowGraph(DtcCtrlDataTable_t &rCtrlDataTable){
 	return DTC_SUCCESS;
 }
 
+/**
+ * This function will resolve the successors of each basic block from the control data
+ * table, which is indexed by the address of the last instruction of the source block.
+ *
+ * @param rCtrlDataTable the table including the control flow information
+ */
+void
+DtcDexMethod::ResolveSuccBlocks(DtcCtrlDataTable_t &rCtrlDataTable) {
+
+	DtcCtrlDataTable_t::iterator ctrliter;
+
+	m_rSuccBlockTable.clear();
+
+	for(ctrliter = rCtrlDataTable.begin(); ctrliter != rCtrlDataTable.end(); ctrliter++) {
+
+		DtcDexBasicBlock *block = FindBasicBlock(ctrliter->first);
+
+		if(block == NULL) continue;
+
+		DtcCtrlDataEntry_t &succs = m_rSuccBlockTable[block->GetStartAddress()];
+		DtcCtrlDataEntry_t::iterator targetiter;
+
+		for(targetiter = ctrliter->second.begin(); targetiter != ctrliter->second.end(); targetiter++) {
+
+			if(m_rBasicBlockTable.count(*targetiter) > 0) succs.insert(*targetiter);
+		}
+	}
+}
+
+/**
+ * This function will find the catch handlers of the basic blocks in the tries. The 
+ * leaders are split at the boundaries of the tries, so a block is either in a try or not.
+ */
+void
+DtcDexMethod::ResolveCatchBlocks() {
+
+	const DexTry *tries = dexGetTries(m_pDexCode);
+
+	m_rCatchBlockTable.clear();
+
+	for(uint32_t i = 0; i < m_pDexCode->triesSize; i++) {
+
+		uint32_t endAddr = tries[i].startAddr + tries[i].insnCount;
+
+		DexCatchIterator catchIter;
+		DexCatchHandler *handler;
+
+		dexCatchIteratorInit(&catchIter, m_pDexCode, tries[i].handlerOff);
+
+		while((handler = dexCatchIteratorNext(&catchIter)) != NULL) {
+
+			DtcDexBasicBlockTable_t::iterator iter = m_rBasicBlockTable.lower_bound(tries[i].startAddr);
+
+			for(; iter != m_rBasicBlockTable.end() && iter->first < endAddr; iter++) {
+				m_rCatchBlockTable[iter->first].insert(handler->address);
+			}
+		}
+	}
+}
+
+/**
+ * This function will return the registers live on the exit of the given basic block,
+ * which are the ones live on the entry of its successors. The next block is also a
+ * successor if the last instruction can continue, e.g. the switches falling through.
+ *
+ * @param pBlock the basic block
+ * @param rLiveRegs the live registers (output)
+ */
+void
+DtcDexMethod::GetLiveOut(DtcDexBasicBlock *pBlock, DtcLiveRegs_t &rLiveRegs) {
+
+	uint32_t address = pBlock->GetStartAddress();
+	uint16_t nregs = GetRegistersSize();
+
+	DtcCtrlDataEntry_t succs;
+	DtcCtrlDataTable_t::iterator succIter = m_rSuccBlockTable.find(address);
+
+	if(succIter != m_rSuccBlockTable.end()) succs = succIter->second;
+
+	uint32_t ncode = pBlock->GetDexcodeCount();
+
+	if(ncode > 0 && (pBlock->GetDexcode(ncode - 1).GetInfo()->nFlags & DTC_OPF_CONT)) {
+
+		DtcDexBasicBlockTable_t::iterator next = m_rBasicBlockTable.upper_bound(address);
+
+		if(next != m_rBasicBlockTable.end()) succs.insert(next->first);
+	}
+
+	rLiveRegs.assign(nregs, false);
+
+	DtcCtrlDataEntry_t::iterator iter;
+
+	for(iter = succs.begin(); iter != succs.end(); iter++) {
+
+		DtcLiveRegsTable_t::iterator liveIter = m_rLiveInTable.find(*iter);
+
+		if(liveIter == m_rLiveInTable.end()) continue;
+
+		for(uint16_t r = 0; r < nregs; r++) {
+			if(liveIter->second[r]) rLiveRegs[r] = true;
+		}
+	}
+}
+
+/**
+ * This function will turn the registers live on the exit of the given basic block into
+ * the ones live before the instruction at the given dex pc. A register pair is live as
+ * a whole, and a pair of an unknown type is taken from the opcode for safety. Only the
+ * def of a known pair kills the second register, so an unsure def keeps it live.
+ *
+ * @param pBlock the basic block
+ * @param nPc the dex pc of an instruction in the block
+ * @param rLiveRegs the live registers on the exit (input), and before the pc (output)
+ */
+void
+DtcDexMethod::TransferLiveRegisters(DtcDexBasicBlock *pBlock, uint32_t nPc, DtcLiveRegs_t &rLiveRegs) {
+
+	uint16_t nregs = GetRegistersSize();
+
+	// A block not analysed keeps all the registers live
+	if(pBlock->GetDexcodeCount() == 0 || pBlock->HasFailed() == TRUE) {
+		rLiveRegs.assign(nregs, true);
+		return;
+	}
+
+	// The registers live on the entry of the catch handlers of the block
+	DtcLiveRegs_t catchLive(nregs, false);
+	DtcCtrlDataTable_t::iterator catchIter = m_rCatchBlockTable.find(pBlock->GetStartAddress());
+
+	if(catchIter != m_rCatchBlockTable.end()) {
+
+		DtcCtrlDataEntry_t::iterator iter;
+
+		for(iter = catchIter->second.begin(); iter != catchIter->second.end(); iter++) {
+
+			DtcLiveRegsTable_t::iterator liveIter = m_rLiveInTable.find(*iter);
+
+			if(liveIter == m_rLiveInTable.end()) continue;
+
+			for(uint16_t r = 0; r < nregs; r++) {
+				if(liveIter->second[r]) catchLive[r] = true;
+			}
+		}
+	}
+
+#define IS_WIDE_WEB(WEB)									\
+	((WEB)->GetDataType() == J_LONG || (WEB)->GetDataType() == J_DOUBLE)
+
+#define SET_LIVE(REGNO, VALUE)								\
+do {														\
+	if((REGNO) < nregs) rLiveRegs[REGNO] = (VALUE);		\
+} while(0)
+
+	for(int32_t i = (int32_t)pBlock->GetDexcodeCount() - 1; i >= 0; i--) {
+
+		DtcDexcode dexcode = pBlock->GetDexcode(i);
+
+		if(dexcode.GetInsnIndex() < nPc) break;
+
+		const DtcDexOpcodeInfo_t *info = dexcode.GetInfo();
+
+		// The defs, including the one of the following move-result
+		for(uint32_t j = 0; j < dexcode.GetDefCount(); j++) {
+
+			DtcDexLiveWeb *web = dexcode.GetDefWeb(j);
+
+			SET_LIVE(web->GetRegnum(), false);
+
+			if(IS_WIDE_WEB(web)) SET_LIVE(web->GetRegnum() + 1, false);
+		}
+
+		// The use of a move-result only tells the data type, and the def is on the
+		// previous instruction, or nowhere for the move-exception
+		if(info->nFlags & DTC_OPF_MOVE_RESULT) {
+
+			uint32_t regno = dexcode.GetOperand(info->nDefOperand);
+
+			SET_LIVE(regno, false);
+
+			if(info->nFlags & DTC_OPF_WIDE) SET_LIVE(regno + 1, false);
+		}
+		else {
+
+			for(uint32_t j = 0; j < dexcode.GetUseCount(); j++) {
+
+				DtcDexLiveWeb *web = dexcode.GetUseWeb(j);
+
+				SET_LIVE(web->GetRegnum(), true);
+
+				if(IS_WIDE_WEB(web) || 
+					(web->GetDataType() == J_UNKNOWN && (info->nFlags & DTC_OPF_WIDE))) {
+					SET_LIVE(web->GetRegnum() + 1, true);
+				}
+			}
+		}
+
+		// A throwing instruction may continue in a catch handler with the same registers
+		if((info->nFlags & DTC_OPF_THROW) && catchIter != m_rCatchBlockTable.end()) {
+
+			for(uint16_t r = 0; r < nregs; r++) {
+				if(catchLive[r]) rLiveRegs[r] = true;
+			}
+		}
+	}
+
+#undef IS_WIDE_WEB
+#undef SET_LIVE
+}
+
+/**
+ * This function will find the basic block including the given dex pc.
+ *
+ * @param nPc the dex pc
+ * @return the basic block (NULL if there is none)
+ */
+DtcDexBasicBlock *
+DtcDexMethod::FindBasicBlock(uint32_t nPc) {
+
+	DtcDexBasicBlockTable_t::iterator iter = m_rBasicBlockTable.upper_bound(nPc);
+
+	if(iter == m_rBasicBlockTable.begin()) return NULL;
+
+	return (--iter)->second;
+}
+
+/**
+ * This function will select the region of the method to be compiled from the execution
+ * counts of the blocks. The hot blocks and the loops headed by the hot blocks form the
+ * region, and the other blocks are left to the interpreter. The region is selected only
+ * for a large method having a hot loop, and the whole method is compiled otherwise.
+ * The loop headers outside the region are no longer the OSR entries of the method.
+ *
+ * @param rBlockCounts the execution counts indexed by the dex pc
+ * @return TRUE if a region is selected
+ */
+bool_t
+DtcDexMethod::SelectRegion(DtcBlockCountTable_t &rBlockCounts) {
+
+	m_rRegionSet.clear();
+
+	if(m_pDexCode == NULL || GetInsnsSize() < DTC_REGION_INSNS_THRESHOLD) return FALSE;
+
+	// A count can be recorded at any pc of a block
+	DtcBlockCountTable_t blockCounts;
+	DtcBlockCountTable_t::iterator countiter;
+	uint32_t maxCount = 0;
+
+	for(countiter = rBlockCounts.begin(); countiter != rBlockCounts.end(); countiter++) {
+
+		DtcDexBasicBlock *block = FindBasicBlock(countiter->first);
+
+		if(block == NULL) continue;
+
+		uint32_t &count = blockCounts[block->GetStartAddress()];
+
+		count += countiter->second;
+
+		if(count > maxCount) maxCount = count;
+	}
+
+	if(maxCount == 0) return FALSE;
+
+	// The predecessors are needed to walk the loops backward
+	DtcCtrlDataTable_t predTable;
+	DtcCtrlDataTable_t::iterator succiter;
+
+	for(succiter = m_rSuccBlockTable.begin(); succiter != m_rSuccBlockTable.end(); succiter++) {
+
+		DtcCtrlDataEntry_t::iterator targetiter;
+
+		for(targetiter = succiter->second.begin(); targetiter != succiter->second.end(); targetiter++) {
+			predTable[*targetiter].insert(succiter->first);
+		}
+	}
+
+	bool_t hasLoop = FALSE;
+
+	for(countiter = blockCounts.begin(); countiter != blockCounts.end(); countiter++) {
+
+		uint32_t header = countiter->first;
+
+		if((uint64_t)countiter->second * DTC_REGION_HOT_FRACTION < maxCount) continue;
+
+		m_rRegionSet.insert(header);
+
+		if(m_rLoopHeaderSet.count(header) == 0) continue;
+
+		// The natural loop consists of the blocks reaching a backward branch to the 
+		// header without passing through the header
+		DtcAddressSet_t loop;
+		vector<uint32_t> worklist;
+		DtcCtrlDataEntry_t::iterator prediter;
+
+		loop.insert(header);
+
+		for(prediter = predTable[header].begin(); prediter != predTable[header].end(); prediter++) {
+			if(*prediter >= header) worklist.push_back(*prediter);
+		}
+
+		while(!worklist.empty()) {
+
+			uint32_t address = worklist.back();
+			worklist.pop_back();
+
+			if(loop.insert(address).second == FALSE) continue;
+
+			for(prediter = predTable[address].begin(); prediter != predTable[address].end(); prediter++) {
+				worklist.push_back(*prediter);
+			}
+		}
+
+		m_rRegionSet.insert(loop.begin(), loop.end());
+		hasLoop = TRUE;
+	}
+
+	// Compiling a region pays off only for a hot loop smaller than the method
+	if(hasLoop == FALSE || m_rRegionSet.size() == m_rBasicBlockTable.size()) {
+
+		m_rRegionSet.clear();
+		return FALSE;
+	}
+
+	DtcAddressSet_t::iterator headeriter = m_rLoopHeaderSet.begin();
+
+	while(headeriter != m_rLoopHeaderSet.end()) {
+
+		if(m_rRegionSet.count(*headeriter) == 0) m_rLoopHeaderSet.erase(headeriter++);
+		else headeriter++;
+	}
+
+	DTC_DEBUG(DEX2C_TAG, "SelectRegion - %d of %d blocks", 
+		m_rRegionSet.size(), m_rBasicBlockTable.size());
+
+	return TRUE;
+}
+
+/**
+ * This function will find the dex code failing the analysis of the basic blocks, which
+ * tells why the method cannot be translated.
+ *
+ * @param nPc the dex pc of the dex code (output)
+ * @param nOpcode the opcode of the dex code (output)
+ * @return TRUE if a dex code failed the analysis
+ */
+bool_t
+DtcDexMethod::FindFailedDexcode(uint32_t &nPc, Opcode &nOpcode) {
+
+	DtcDexBasicBlockTable_t::iterator iter;
+
+	for(iter = m_rBasicBlockTable.begin(); iter != m_rBasicBlockTable.end(); iter++) {
+
+		DtcDexBasicBlock *block = iter->second;
+
+		if(block->HasFailed() == FALSE) continue;
+
+		DtcDexcode dexcode = block->GetFailedDexcode();
+
+		nPc = dexcode.GetInsnIndex();
+		nOpcode = dexcode.GetOpcode();
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/**
+ * This function will resolve the registers live on the entry of each basic block by
+ * the backward data flow analysis over the whole method. Unlike the local analysis of
+ * the blocks, it works on the register numbers only, so it is cheap enough to run for
+ * every compiled method. The catch handlers are the successors of the instructions
+ * throwing in a try, so the registers read by a handler are kept live there.
+ */
+void
+DtcDexMethod::ResolveLiveRegisters() {
+
+	DTC_DEBUG(DEX2C_TAG, "DtcDexMethod->ResolveLiveRegisters Invoked...");
+
+	DtcDexBasicBlockTable_t::iterator iter;
+	DtcDexBasicBlockTable_t::reverse_iterator riter;
+
+	m_rLiveInTable.clear();
+
+	if(m_pDexCode == NULL) return;
+
+	ResolveCatchBlocks();
+
+	for(iter = m_rBasicBlockTable.begin(); iter != m_rBasicBlockTable.end(); iter++) {
+		m_rLiveInTable[iter->first].assign(GetRegistersSize(), false);
+	}
+
+	// The blocks are visited backward, which converges in a few passes without a worklist
+	bool_t changed = TRUE;
+
+	while(changed == TRUE) {
+
+		changed = FALSE;
+
+		for(riter = m_rBasicBlockTable.rbegin(); riter != m_rBasicBlockTable.rend(); riter++) {
+
+			DtcLiveRegs_t live;
+
+			GetLiveOut(riter->second, live);
+			TransferLiveRegisters(riter->second, riter->first, live);
+
+			DtcLiveRegs_t &liveIn = m_rLiveInTable[riter->first];
+
+			if(live != liveIn) {
+				liveIn.swap(live);
+				changed = TRUE;
+			}
+		}
+	}
+}
+
+/**
+ * This function will return the registers live before the instruction at the given
+ * dex pc, i.e. the registers to be kept in the frame if the interpreter resumes there.
+ * All the registers are live if the liveness is not resolved.
+ *
+ * @param nPc the dex pc of an instruction
+ * @param rLiveRegs the live registers (output)
+ */
+void
+DtcDexMethod::GetLiveRegisters(uint32_t nPc, DtcLiveRegs_t &rLiveRegs) {
+
+	DtcDexBasicBlock *block = FindBasicBlock(nPc);
+
+	if(block == NULL || m_rLiveInTable.empty()) {
+		rLiveRegs.assign(GetRegistersSize(), true);
+		return;
+	}
+
+	GetLiveOut(block, rLiveRegs);
+	TransferLiveRegisters(block, nPc, rLiveRegs);
+}
+
 ///////////////////////////////////////////////////////////////////////
 // Static Function Definition
 ///////////////////////////////////////////////////////////////////////
@@ -582,8 +1162,56 @@ ResolveLocalVariableCb(void *pContext, u2 nReg, u4 nStartAddress,
 		default: web->SetDataType(J_UNKNOWN); break;
 	}
 
+	DtcDexLiveWebTable_t &localVarTable = *(DtcDexLiveWebTable_t *)pContext;
+
+	// The later local variable of the same register replaces the earlier one
+	if(localVarTable.count(nReg) > 0) {
+		delete localVarTable[nReg];
+	}
+
 	// Append the local variable information to the array
-	(*(DtcDexLiveWebTable_t *)pContext)[nReg] = web;
+	localVarTable[nReg] = web;
+}
+
+/**
+ * This function will resolve the dex codes and analyse the liveness of a chunk of 
+ * the basic blocks. It runs on the threads of the pool.
+ *
+ * @param pArg the chunk of the basic blocks
+ */
+static void
+AnalyseBlocksTask(void *pArg) {
+
+	DtcDexBlockChunk_t *chunk = (DtcDexBlockChunk_t *)pArg;
+	DtcDexBasicBlockTable_t::iterator iter;
+
+	// The task may run on a thread bound to the arena of another compilation, 
+	// which can be reset before this method is released
+	DtcArena *arena = DtcArena::GetCurrent();
+	DtcArena::SetCurrent(NULL);
+
+	for(iter = chunk->rBegin; iter != chunk->rEnd; iter++) {
+
+		DtcDexBasicBlock *block = iter->second;
+
+		// The time is counted in the statistics of the thread running the task
+		DTC_PHASE_BEGIN(RESOLVE_DEXCODES);
+		uint32_t ncode = block->ResolveDexcodes();
+		DTC_PHASE_END(RESOLVE_DEXCODES);
+
+		if(ncode > 0) {
+
+			DTC_PHASE_BEGIN(ANALYSE_LIVENESS);
+			chunk->nError = block->AnalyseLiveness(*chunk->pLocalVarTable);
+			DTC_PHASE_END(ANALYSE_LIVENESS);
+
+			if(chunk->nError != DTC_SUCCESS) {
+				break;
+			}
+		}
+	}
+
+	DtcArena::SetCurrent(arena);
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -594,7 +1222,7 @@ void
 DtcDexMethod::Write(ostream &pOut) {
 
 	// Print out the method signature
-	pOut << "Method: " << m_pMethod->name << endl;
+	pOut << "Method: " << GetName() << endl;
 
 	DtcDexLiveWebTable_t::iterator lviter;
 
@@ -17,6 +17,8 @@
 #include "DtcDexcode.h"
 #include "DtcCommon.h"
 #include "DtcDexBasicBlock.h"
+#include "DtcDexInsnTable.h"
+#include "DtcThreadPool.h"
 
 ///////////////////////////////////////////////////////////////////////
 // User-defined Type Definition
@@ -26,8 +28,23 @@ typedef set<uint32_t> DtcCtrlDataEntry_t;
 
 typedef map<uint32_t, DtcCtrlDataEntry_t> DtcCtrlDataTable_t;
 
+typedef set<uint32_t> DtcAddressSet_t;
+
 typedef map<uint32_t, DtcDexBasicBlock *> DtcDexBasicBlockTable_t;
 
+// The execution counts of the blocks, which are indexed by the dex pc
+typedef map<uint32_t, uint32_t> DtcBlockCountTable_t;
+
+// The live registers, which are indexed by the register number
+typedef vector<bool> DtcLiveRegs_t;
+
+// The registers live on the entry of the basic blocks, which are indexed by the dex pc
+typedef map<uint32_t, DtcLiveRegs_t> DtcLiveRegsTable_t;
+
+class DtcDexMethod;
+
+typedef vector<DtcDexMethod *> DtcDexMethodList_t;
+
 ///////////////////////////////////////////////////////////////////////
 // DtcDexMethod Class Declaration
 ///////////////////////////////////////////////////////////////////////
@@ -47,6 +64,9 @@ private :
 
 	// Original dex method index
 	uint32_t m_nDexMethodIndex;
+
+	// Access flags of the method
+	uint32_t m_nAccessFlags;
 	
 	// Dex file including the target method
 	DexFile *m_pDexFile;
@@ -57,15 +77,35 @@ private :
 	// The table including the resolve basic blocks
 	DtcDexBasicBlockTable_t m_rBasicBlockTable;
 
+	// The decoded instructions of the method, shared by all the basic blocks
+	DtcDexInsnTable m_rInsnTable;
+
 	// The table for the data types of the local variables
 	DtcDexLiveWebTable_t m_rLocalVarTable;
 
+	// The addresses of the loop headers, which are the targets of the backward branches
+	DtcAddressSet_t m_rLoopHeaderSet;
+
+	// The start addresses of the successors of each basic block
+	DtcCtrlDataTable_t m_rSuccBlockTable;
+
+	// The start addresses of the basic blocks to be compiled (empty for the whole method)
+	DtcAddressSet_t m_rRegionSet;
+
+	// The registers live on the entry of each basic block (empty until resolved)
+	DtcLiveRegsTable_t m_rLiveInTable;
+
+	// The start addresses of the catch handlers of each basic block in a try
+	DtcCtrlDataTable_t m_rCatchBlockTable;
+
 public :
 	///////////////////////////////////////////////////////////////////
 	// Constructor & Destructor Declaration
 	///////////////////////////////////////////////////////////////////
 	
 	DtcDexMethod(Method *pMethod = NULL);
+
+	DtcDexMethod(DexFile *pDexFile, const DexMethod *pDexMethod);
 	
 	virtual ~DtcDexMethod();
 
@@ -77,6 +117,13 @@ public :
 
 	char* GetDescriptor();
 
+	/**
+	 * This function will return the resolved method.
+	 *
+	 * @return the resolved method
+	 */
+	inline Method *GetMethod()					{ return m_pMethod;			}
+
 	/**
 	 * This function will return the method index of the resolved method.
 	 *
@@ -91,6 +138,20 @@ public :
 	 */
 	inline uint32_t GetDexMethodIndex()			{ return m_nDexMethodIndex;	}
 
+	/**
+	 * This function will return the number of the registers used by the method.
+	 *
+	 * @return the number of the registers
+	 */
+	inline uint16_t GetRegistersSize()			{ return m_pDexCode->registersSize;	}
+
+	/**
+	 * This function will return the number of the words of the incoming arguments.
+	 *
+	 * @return the number of the argument words
+	 */
+	inline uint16_t GetInsSize()				{ return m_pDexCode->insSize;	}
+
 	/**
 	 * This function will return the basic blocks.
 	 *
@@ -105,19 +166,77 @@ public :
 	 */
 	 inline DtcDexLiveWebTable_t &GetLocalVarTable()	{ return m_rLocalVarTable; 	}
 
+	/**
+	 * This function will return the addresses of the loop headers.
+	 *
+	 * @return the set of the loop header addresses
+	 */
+	inline DtcAddressSet_t &GetLoopHeaders()		{ return m_rLoopHeaderSet;	}
+
+	/**
+	 * This function will return the number of the dex code units of the method.
+	 *
+	 * @return the number of the code units
+	 */
+	inline uint32_t GetInsnsSize()				{ return m_pDexCode->insnsSize;	}
+
+	/**
+	 * This function will return the successors of the basic blocks.
+	 *
+	 * @return the table of the successor addresses indexed by the block addresses
+	 */
+	inline DtcCtrlDataTable_t &GetSuccBlocks()		{ return m_rSuccBlockTable;	}
+
+	/**
+	 * This function will tell whether only a region of the method is compiled.
+	 *
+	 * @return TRUE if a region is selected
+	 */
+	inline bool_t HasRegion()					{ return !m_rRegionSet.empty();	}
+
+	/**
+	 * This function will tell whether the given basic block is compiled.
+	 *
+	 * @param nAddress the start address of the basic block
+	 * @return TRUE if the block is in the region or the whole method is compiled
+	 */
+	inline bool_t IsInRegion(uint32_t nAddress) {
+		return m_rRegionSet.empty() || m_rRegionSet.count(nAddress) > 0;
+	}
+
 	///////////////////////////////////////////////////////////////////
 	// Member Function Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	DtcError_t BuildIR();
+	DtcError_t BuildIR(DtcThreadPool *pPool = NULL);
+
+	bool_t SelectRegion(DtcBlockCountTable_t &rBlockCounts);
+
+	bool_t FindFailedDexcode(uint32_t &nPc, Opcode &nOpcode);
+
+	void ResolveLiveRegisters();
+
+	void GetLiveRegisters(uint32_t nPc, DtcLiveRegs_t &rLiveRegs);
 
 private:
 
+	DtcError_t AnalyseBlocksInParallel(DtcThreadPool *pPool);
+
 	DtcError_t ResolveLocalVariables();
 
 	uint32_t ResolveBasicBlocks(DtcCtrlDataTable_t &rCtrlDataTable);
 
 	DtcError_t BuildControlFlowGraph(DtcCtrlDataTable_t &rCtrlDataTable);
+
+	void ResolveSuccBlocks(DtcCtrlDataTable_t &rCtrlDataTable);
+
+	DtcDexBasicBlock *FindBasicBlock(uint32_t nPc);
+
+	void ResolveCatchBlocks();
+
+	void GetLiveOut(DtcDexBasicBlock *pBlock, DtcLiveRegs_t &rLiveRegs);
+
+	void TransferLiveRegisters(DtcDexBasicBlock *pBlock, uint32_t nPc, DtcLiveRegs_t &rLiveRegs);
 	
 public:
 	///////////////////////////////////////////////////////////////////
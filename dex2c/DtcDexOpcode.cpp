@@ -0,0 +1,560 @@
+/*********************************************************************
+*   DtcDexOpcode.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include "DtcDexOpcode.h"
+
+///////////////////////////////////////////////////////////////////////
+// Macros for the opcode table
+///////////////////////////////////////////////////////////////////////
+
+// The data types named after their type descriptors
+#define T_X		J_UNKNOWN
+#define T_Z		J_BOOLEAN
+#define T_B		J_BYTE
+#define T_C		J_CHAR
+#define T_S		J_SHORT
+#define T_I		J_INT
+#define T_J		J_LONG
+#define T_F		J_FLOAT
+#define T_D		J_DOUBLE
+#define T_L		J_OBJECT
+#define T_USE	DTC_TYPE_OF_USE
+
+// A row of the table, where the name of the opcode only tells the row
+#define OPCODE_INFO(OPCODE, FMT, DEF, DEF_TYPE, USE_KIND, USE0, TYPE0, USE1, TYPE1, USE2, TYPE2, FLAGS)	\
+	{ kFmt##FMT, DTC_OPND_##DEF, DEF_TYPE, DTC_USE_##USE_KIND,							\
+	  { DTC_OPND_##USE0, DTC_OPND_##USE1, DTC_OPND_##USE2 }, { TYPE0, TYPE1, TYPE2 }, FLAGS }
+
+///////////////////////////////////////////////////////////////////////
+// Global Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * The properties of all the opcodes in the order of their values. The operands
+ * are listed in the order the liveness analysis appends the use webs, so the
+ * translation refers to the webs with the same indices.
+ */
+const DtcDexOpcodeInfo_t gDtcOpcodeInfoTable[kNumPackedOpcodes] = {
+
+	/* 00 */ OPCODE_INFO(NOP, 10x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 01 */ OPCODE_INFO(MOVE, 12x, VA, T_USE, FIXED,
+			VB, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 02 */ OPCODE_INFO(MOVE_FROM16, 22x, VA, T_USE, FIXED,
+			VB, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 03 */ OPCODE_INFO(MOVE_16, 32x, VA, T_USE, FIXED,
+			VB, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 04 */ OPCODE_INFO(MOVE_WIDE, 12x, VA, T_USE, FIXED,
+			VB, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 05 */ OPCODE_INFO(MOVE_WIDE_FROM16, 22x, VA, T_USE, FIXED,
+			VB, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 06 */ OPCODE_INFO(MOVE_WIDE_16, 32x, VA, T_USE, FIXED,
+			VB, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 07 */ OPCODE_INFO(MOVE_OBJECT, 12x, VA, T_L, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 08 */ OPCODE_INFO(MOVE_OBJECT_FROM16, 22x, VA, T_L, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 09 */ OPCODE_INFO(MOVE_OBJECT_16, 32x, VA, T_L, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 0A */ OPCODE_INFO(MOVE_RESULT, 11x, VA, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_MOVE_RESULT),
+	/* 0B */ OPCODE_INFO(MOVE_RESULT_WIDE, 11x, VA, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_MOVE_RESULT),
+	/* 0C */ OPCODE_INFO(MOVE_RESULT_OBJECT, 11x, VA, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_MOVE_RESULT),
+	/* 0D */ OPCODE_INFO(MOVE_EXCEPTION, 11x, VA, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_MOVE_RESULT),
+	/* 0E */ OPCODE_INFO(RETURN_VOID, 10x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_RETURN),
+	/* 0F */ OPCODE_INFO(RETURN, 11x, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_RETURN),
+	/* 10 */ OPCODE_INFO(RETURN_WIDE, 11x, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_RETURN),
+	/* 11 */ OPCODE_INFO(RETURN_OBJECT, 11x, NONE, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_RETURN),
+	/* 12 */ OPCODE_INFO(CONST_4, 11n, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 13 */ OPCODE_INFO(CONST_16, 21s, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 14 */ OPCODE_INFO(CONST, 31i, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 15 */ OPCODE_INFO(CONST_HIGH16, 21h, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 16 */ OPCODE_INFO(CONST_WIDE_16, 21s, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 17 */ OPCODE_INFO(CONST_WIDE_32, 31i, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 18 */ OPCODE_INFO(CONST_WIDE, 51l, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 19 */ OPCODE_INFO(CONST_WIDE_HIGH16, 21h, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 1A */ OPCODE_INFO(CONST_STRING, 21c, VA, T_L, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 1B */ OPCODE_INFO(CONST_STRING_JUMBO, 31c, VA, T_L, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 1C */ OPCODE_INFO(CONST_CLASS, 21c, VA, T_L, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 1D */ OPCODE_INFO(MONITOR_ENTER, 11x, NONE, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 1E */ OPCODE_INFO(MONITOR_EXIT, 11x, NONE, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 1F */ OPCODE_INFO(CHECK_CAST, 21c, NONE, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 20 */ OPCODE_INFO(INSTANCE_OF, 22c, VA, T_I, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 21 */ OPCODE_INFO(ARRAY_LENGTH, 12x, VA, T_I, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 22 */ OPCODE_INFO(NEW_INSTANCE, 21c, VA, T_L, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 23 */ OPCODE_INFO(NEW_ARRAY, 22c, VA, T_L, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 24 */ OPCODE_INFO(FILLED_NEW_ARRAY, 35c, NONE, T_X, LIST,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_RESULT),
+	/* 25 */ OPCODE_INFO(FILLED_NEW_ARRAY_RANGE, 3rc, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_RESULT),
+	/* 26 */ OPCODE_INFO(FILL_ARRAY_DATA, 31t, NONE, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 27 */ OPCODE_INFO(THROW, 11x, NONE, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_THROW),
+	/* 28 */ OPCODE_INFO(GOTO, 10t, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_BRANCH),
+	/* 29 */ OPCODE_INFO(GOTO_16, 20t, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_BRANCH),
+	/* 2A */ OPCODE_INFO(GOTO_32, 30t, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_BRANCH),
+	/* 2B */ OPCODE_INFO(PACKED_SWITCH, 31t, NONE, T_X, FIXED,
+			VA, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_SWITCH),
+	/* 2C */ OPCODE_INFO(SPARSE_SWITCH, 31t, NONE, T_X, FIXED,
+			VA, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_SWITCH),
+	/* 2D */ OPCODE_INFO(CMPL_FLOAT, 23x, VA, T_I, FIXED,
+			VB, T_F, VC, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* 2E */ OPCODE_INFO(CMPG_FLOAT, 23x, VA, T_I, FIXED,
+			VB, T_F, VC, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* 2F */ OPCODE_INFO(CMPL_DOUBLE, 23x, VA, T_I, FIXED,
+			VB, T_D, VC, T_D, NONE, T_X, DTC_OPF_CONT),
+	/* 30 */ OPCODE_INFO(CMPG_DOUBLE, 23x, VA, T_I, FIXED,
+			VB, T_D, VC, T_D, NONE, T_X, DTC_OPF_CONT),
+	/* 31 */ OPCODE_INFO(CMP_LONG, 23x, VA, T_I, FIXED,
+			VB, T_J, VC, T_J, NONE, T_X, DTC_OPF_CONT),
+	/* 32 */ OPCODE_INFO(IF_EQ, 22t, NONE, T_X, FIXED,
+			VA, T_X, VB, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 33 */ OPCODE_INFO(IF_NE, 22t, NONE, T_X, FIXED,
+			VA, T_X, VB, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 34 */ OPCODE_INFO(IF_LT, 22t, NONE, T_X, FIXED,
+			VA, T_X, VB, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 35 */ OPCODE_INFO(IF_GE, 22t, NONE, T_X, FIXED,
+			VA, T_X, VB, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 36 */ OPCODE_INFO(IF_GT, 22t, NONE, T_X, FIXED,
+			VA, T_X, VB, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 37 */ OPCODE_INFO(IF_LE, 22t, NONE, T_X, FIXED,
+			VA, T_X, VB, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 38 */ OPCODE_INFO(IF_EQZ, 21t, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 39 */ OPCODE_INFO(IF_NEZ, 21t, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 3A */ OPCODE_INFO(IF_LTZ, 21t, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 3B */ OPCODE_INFO(IF_GEZ, 21t, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 3C */ OPCODE_INFO(IF_GTZ, 21t, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 3D */ OPCODE_INFO(IF_LEZ, 21t, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_BRANCH),
+	/* 3E */ OPCODE_INFO(UNUSED_3E, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+	/* 3F */ OPCODE_INFO(UNUSED_3F, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+	/* 40 */ OPCODE_INFO(UNUSED_40, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+	/* 41 */ OPCODE_INFO(UNUSED_41, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+	/* 42 */ OPCODE_INFO(UNUSED_42, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+	/* 43 */ OPCODE_INFO(UNUSED_43, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+	/* 44 */ OPCODE_INFO(AGET, 23x, VA, T_X, FIXED,
+			VB, T_L, VC, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 45 */ OPCODE_INFO(AGET_WIDE, 23x, VA, T_X, FIXED,
+			VB, T_L, VC, T_I, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 46 */ OPCODE_INFO(AGET_OBJECT, 23x, VA, T_L, FIXED,
+			VB, T_L, VC, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 47 */ OPCODE_INFO(AGET_BOOLEAN, 23x, VA, T_Z, FIXED,
+			VB, T_L, VC, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 48 */ OPCODE_INFO(AGET_BYTE, 23x, VA, T_B, FIXED,
+			VB, T_L, VC, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 49 */ OPCODE_INFO(AGET_CHAR, 23x, VA, T_C, FIXED,
+			VB, T_L, VC, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 4A */ OPCODE_INFO(AGET_SHORT, 23x, VA, T_S, FIXED,
+			VB, T_L, VC, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 4B */ OPCODE_INFO(APUT, 23x, NONE, T_X, FIXED,
+			VA, T_X, VB, T_L, VC, T_I, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 4C */ OPCODE_INFO(APUT_WIDE, 23x, NONE, T_X, FIXED,
+			VA, T_X, VB, T_L, VC, T_I, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 4D */ OPCODE_INFO(APUT_OBJECT, 23x, NONE, T_X, FIXED,
+			VA, T_L, VB, T_L, VC, T_I, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 4E */ OPCODE_INFO(APUT_BOOLEAN, 23x, NONE, T_X, FIXED,
+			VA, T_Z, VB, T_L, VC, T_I, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 4F */ OPCODE_INFO(APUT_BYTE, 23x, NONE, T_X, FIXED,
+			VA, T_B, VB, T_L, VC, T_I, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 50 */ OPCODE_INFO(APUT_CHAR, 23x, NONE, T_X, FIXED,
+			VA, T_C, VB, T_L, VC, T_I, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 51 */ OPCODE_INFO(APUT_SHORT, 23x, NONE, T_X, FIXED,
+			VA, T_S, VB, T_L, VC, T_I, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 52 */ OPCODE_INFO(IGET, 22c, VA, T_X, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 53 */ OPCODE_INFO(IGET_WIDE, 22c, VA, T_X, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 54 */ OPCODE_INFO(IGET_OBJECT, 22c, VA, T_L, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 55 */ OPCODE_INFO(IGET_BOOLEAN, 22c, VA, T_Z, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 56 */ OPCODE_INFO(IGET_BYTE, 22c, VA, T_B, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 57 */ OPCODE_INFO(IGET_CHAR, 22c, VA, T_C, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 58 */ OPCODE_INFO(IGET_SHORT, 22c, VA, T_S, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 59 */ OPCODE_INFO(IPUT, 22c, NONE, T_X, FIXED,
+			VA, T_X, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 5A */ OPCODE_INFO(IPUT_WIDE, 22c, NONE, T_X, FIXED,
+			VA, T_X, VB, T_L, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 5B */ OPCODE_INFO(IPUT_OBJECT, 22c, NONE, T_X, FIXED,
+			VA, T_L, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 5C */ OPCODE_INFO(IPUT_BOOLEAN, 22c, NONE, T_X, FIXED,
+			VA, T_Z, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 5D */ OPCODE_INFO(IPUT_BYTE, 22c, NONE, T_X, FIXED,
+			VA, T_B, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 5E */ OPCODE_INFO(IPUT_CHAR, 22c, NONE, T_X, FIXED,
+			VA, T_C, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 5F */ OPCODE_INFO(IPUT_SHORT, 22c, NONE, T_X, FIXED,
+			VA, T_S, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 60 */ OPCODE_INFO(SGET, 21c, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 61 */ OPCODE_INFO(SGET_WIDE, 21c, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 62 */ OPCODE_INFO(SGET_OBJECT, 21c, VA, T_L, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 63 */ OPCODE_INFO(SGET_BOOLEAN, 21c, VA, T_Z, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 64 */ OPCODE_INFO(SGET_BYTE, 21c, VA, T_B, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 65 */ OPCODE_INFO(SGET_CHAR, 21c, VA, T_C, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 66 */ OPCODE_INFO(SGET_SHORT, 21c, VA, T_S, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 67 */ OPCODE_INFO(SPUT, 21c, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 68 */ OPCODE_INFO(SPUT_WIDE, 21c, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 69 */ OPCODE_INFO(SPUT_OBJECT, 21c, NONE, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 6A */ OPCODE_INFO(SPUT_BOOLEAN, 21c, NONE, T_X, FIXED,
+			VA, T_Z, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 6B */ OPCODE_INFO(SPUT_BYTE, 21c, NONE, T_X, FIXED,
+			VA, T_B, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 6C */ OPCODE_INFO(SPUT_CHAR, 21c, NONE, T_X, FIXED,
+			VA, T_C, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 6D */ OPCODE_INFO(SPUT_SHORT, 21c, NONE, T_X, FIXED,
+			VA, T_S, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 6E */ OPCODE_INFO(INVOKE_VIRTUAL, 35c, NONE, T_X, LIST,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 6F */ OPCODE_INFO(INVOKE_SUPER, 35c, NONE, T_X, LIST,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 70 */ OPCODE_INFO(INVOKE_DIRECT, 35c, NONE, T_X, LIST,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 71 */ OPCODE_INFO(INVOKE_STATIC, 35c, NONE, T_X, LIST,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 72 */ OPCODE_INFO(INVOKE_INTERFACE, 35c, NONE, T_X, LIST,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 73 */ OPCODE_INFO(UNUSED_73, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+	/* 74 */ OPCODE_INFO(INVOKE_VIRTUAL_RANGE, 3rc, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 75 */ OPCODE_INFO(INVOKE_SUPER_RANGE, 3rc, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 76 */ OPCODE_INFO(INVOKE_DIRECT_RANGE, 3rc, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 77 */ OPCODE_INFO(INVOKE_STATIC_RANGE, 3rc, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 78 */ OPCODE_INFO(INVOKE_INTERFACE_RANGE, 3rc, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* 79 */ OPCODE_INFO(UNUSED_79, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+	/* 7A */ OPCODE_INFO(UNUSED_7A, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+	/* 7B */ OPCODE_INFO(NEG_INT, 12x, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 7C */ OPCODE_INFO(NOT_INT, 12x, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 7D */ OPCODE_INFO(NEG_LONG, 12x, VA, T_J, FIXED,
+			VB, T_J, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 7E */ OPCODE_INFO(NOT_LONG, 12x, VA, T_J, FIXED,
+			VB, T_J, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 7F */ OPCODE_INFO(NEG_FLOAT, 12x, VA, T_F, FIXED,
+			VB, T_F, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 80 */ OPCODE_INFO(NEG_DOUBLE, 12x, VA, T_D, FIXED,
+			VB, T_D, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 81 */ OPCODE_INFO(INT_TO_LONG, 12x, VA, T_J, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 82 */ OPCODE_INFO(INT_TO_FLOAT, 12x, VA, T_F, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 83 */ OPCODE_INFO(INT_TO_DOUBLE, 12x, VA, T_D, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 84 */ OPCODE_INFO(LONG_TO_INT, 12x, VA, T_I, FIXED,
+			VB, T_J, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 85 */ OPCODE_INFO(LONG_TO_FLOAT, 12x, VA, T_F, FIXED,
+			VB, T_J, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 86 */ OPCODE_INFO(LONG_TO_DOUBLE, 12x, VA, T_D, FIXED,
+			VB, T_J, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 87 */ OPCODE_INFO(FLOAT_TO_INT, 12x, VA, T_I, FIXED,
+			VB, T_F, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 88 */ OPCODE_INFO(FLOAT_TO_LONG, 12x, VA, T_J, FIXED,
+			VB, T_F, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 89 */ OPCODE_INFO(FLOAT_TO_DOUBLE, 12x, VA, T_D, FIXED,
+			VB, T_F, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 8A */ OPCODE_INFO(DOUBLE_TO_INT, 12x, VA, T_I, FIXED,
+			VB, T_D, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 8B */ OPCODE_INFO(DOUBLE_TO_LONG, 12x, VA, T_J, FIXED,
+			VB, T_D, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 8C */ OPCODE_INFO(DOUBLE_TO_FLOAT, 12x, VA, T_F, FIXED,
+			VB, T_D, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 8D */ OPCODE_INFO(INT_TO_BYTE, 12x, VA, T_B, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 8E */ OPCODE_INFO(INT_TO_CHAR, 12x, VA, T_C, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 8F */ OPCODE_INFO(INT_TO_SHORT, 12x, VA, T_S, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* 90 */ OPCODE_INFO(ADD_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* 91 */ OPCODE_INFO(SUB_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* 92 */ OPCODE_INFO(MUL_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* 93 */ OPCODE_INFO(DIV_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 94 */ OPCODE_INFO(REM_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 95 */ OPCODE_INFO(AND_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* 96 */ OPCODE_INFO(OR_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* 97 */ OPCODE_INFO(XOR_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* 98 */ OPCODE_INFO(SHL_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* 99 */ OPCODE_INFO(SHR_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* 9A */ OPCODE_INFO(USHR_INT, 23x, VA, T_I, FIXED,
+			VB, T_I, VC, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* 9B */ OPCODE_INFO(ADD_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 9C */ OPCODE_INFO(SUB_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 9D */ OPCODE_INFO(MUL_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* 9E */ OPCODE_INFO(DIV_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* 9F */ OPCODE_INFO(REM_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* A0 */ OPCODE_INFO(AND_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* A1 */ OPCODE_INFO(OR_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* A2 */ OPCODE_INFO(XOR_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* A3 */ OPCODE_INFO(SHL_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_I, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* A4 */ OPCODE_INFO(SHR_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_I, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* A5 */ OPCODE_INFO(USHR_LONG, 23x, VA, T_J, FIXED,
+			VB, T_J, VC, T_I, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* A6 */ OPCODE_INFO(ADD_FLOAT, 23x, VA, T_F, FIXED,
+			VB, T_F, VC, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* A7 */ OPCODE_INFO(SUB_FLOAT, 23x, VA, T_F, FIXED,
+			VB, T_F, VC, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* A8 */ OPCODE_INFO(MUL_FLOAT, 23x, VA, T_F, FIXED,
+			VB, T_F, VC, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* A9 */ OPCODE_INFO(DIV_FLOAT, 23x, VA, T_F, FIXED,
+			VB, T_F, VC, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* AA */ OPCODE_INFO(REM_FLOAT, 23x, VA, T_F, FIXED,
+			VB, T_F, VC, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* AB */ OPCODE_INFO(ADD_DOUBLE, 23x, VA, T_D, FIXED,
+			VB, T_D, VC, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* AC */ OPCODE_INFO(SUB_DOUBLE, 23x, VA, T_D, FIXED,
+			VB, T_D, VC, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* AD */ OPCODE_INFO(MUL_DOUBLE, 23x, VA, T_D, FIXED,
+			VB, T_D, VC, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* AE */ OPCODE_INFO(DIV_DOUBLE, 23x, VA, T_D, FIXED,
+			VB, T_D, VC, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* AF */ OPCODE_INFO(REM_DOUBLE, 23x, VA, T_D, FIXED,
+			VB, T_D, VC, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* B0 */ OPCODE_INFO(ADD_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* B1 */ OPCODE_INFO(SUB_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* B2 */ OPCODE_INFO(MUL_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* B3 */ OPCODE_INFO(DIV_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* B4 */ OPCODE_INFO(REM_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* B5 */ OPCODE_INFO(AND_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* B6 */ OPCODE_INFO(OR_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* B7 */ OPCODE_INFO(XOR_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* B8 */ OPCODE_INFO(SHL_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* B9 */ OPCODE_INFO(SHR_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* BA */ OPCODE_INFO(USHR_INT_2ADDR, 12x, VA, T_I, FIXED,
+			VA, T_I, VB, T_I, NONE, T_X, DTC_OPF_CONT),
+	/* BB */ OPCODE_INFO(ADD_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* BC */ OPCODE_INFO(SUB_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* BD */ OPCODE_INFO(MUL_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* BE */ OPCODE_INFO(DIV_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* BF */ OPCODE_INFO(REM_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* C0 */ OPCODE_INFO(AND_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* C1 */ OPCODE_INFO(OR_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* C2 */ OPCODE_INFO(XOR_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_J, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* C3 */ OPCODE_INFO(SHL_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_I, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* C4 */ OPCODE_INFO(SHR_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_I, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* C5 */ OPCODE_INFO(USHR_LONG_2ADDR, 12x, VA, T_J, FIXED,
+			VA, T_J, VB, T_I, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* C6 */ OPCODE_INFO(ADD_FLOAT_2ADDR, 12x, VA, T_F, FIXED,
+			VA, T_F, VB, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* C7 */ OPCODE_INFO(SUB_FLOAT_2ADDR, 12x, VA, T_F, FIXED,
+			VA, T_F, VB, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* C8 */ OPCODE_INFO(MUL_FLOAT_2ADDR, 12x, VA, T_F, FIXED,
+			VA, T_F, VB, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* C9 */ OPCODE_INFO(DIV_FLOAT_2ADDR, 12x, VA, T_F, FIXED,
+			VA, T_F, VB, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* CA */ OPCODE_INFO(REM_FLOAT_2ADDR, 12x, VA, T_F, FIXED,
+			VA, T_F, VB, T_F, NONE, T_X, DTC_OPF_CONT),
+	/* CB */ OPCODE_INFO(ADD_DOUBLE_2ADDR, 12x, VA, T_D, FIXED,
+			VA, T_D, VB, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* CC */ OPCODE_INFO(SUB_DOUBLE_2ADDR, 12x, VA, T_D, FIXED,
+			VA, T_D, VB, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* CD */ OPCODE_INFO(MUL_DOUBLE_2ADDR, 12x, VA, T_D, FIXED,
+			VA, T_D, VB, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* CE */ OPCODE_INFO(DIV_DOUBLE_2ADDR, 12x, VA, T_D, FIXED,
+			VA, T_D, VB, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* CF */ OPCODE_INFO(REM_DOUBLE_2ADDR, 12x, VA, T_D, FIXED,
+			VA, T_D, VB, T_D, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT),
+	/* D0 */ OPCODE_INFO(ADD_INT_LIT16, 22s, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* D1 */ OPCODE_INFO(RSUB_INT, 22s, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* D2 */ OPCODE_INFO(MUL_INT_LIT16, 22s, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* D3 */ OPCODE_INFO(DIV_INT_LIT16, 22s, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* D4 */ OPCODE_INFO(REM_INT_LIT16, 22s, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* D5 */ OPCODE_INFO(AND_INT_LIT16, 22s, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* D6 */ OPCODE_INFO(OR_INT_LIT16, 22s, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* D7 */ OPCODE_INFO(XOR_INT_LIT16, 22s, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* D8 */ OPCODE_INFO(ADD_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* D9 */ OPCODE_INFO(RSUB_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* DA */ OPCODE_INFO(MUL_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* DB */ OPCODE_INFO(DIV_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* DC */ OPCODE_INFO(REM_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* DD */ OPCODE_INFO(AND_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* DE */ OPCODE_INFO(OR_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* DF */ OPCODE_INFO(XOR_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* E0 */ OPCODE_INFO(SHL_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* E1 */ OPCODE_INFO(SHR_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* E2 */ OPCODE_INFO(USHR_INT_LIT8, 22b, VA, T_I, FIXED,
+			VB, T_I, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* E3 */ OPCODE_INFO(IGET_VOLATILE, 22c, VA, T_X, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* E4 */ OPCODE_INFO(IPUT_VOLATILE, 22c, NONE, T_X, FIXED,
+			VA, T_X, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* E5 */ OPCODE_INFO(SGET_VOLATILE, 21c, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* E6 */ OPCODE_INFO(SPUT_VOLATILE, 21c, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* E7 */ OPCODE_INFO(IGET_OBJECT_VOLATILE, 22c, VA, T_L, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* E8 */ OPCODE_INFO(IGET_WIDE_VOLATILE, 22c, VA, T_X, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* E9 */ OPCODE_INFO(IPUT_WIDE_VOLATILE, 22c, NONE, T_X, FIXED,
+			VA, T_X, VB, T_L, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* EA */ OPCODE_INFO(SGET_WIDE_VOLATILE, 21c, VA, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* EB */ OPCODE_INFO(SPUT_WIDE_VOLATILE, 21c, NONE, T_X, FIXED,
+			VA, T_X, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* EC */ OPCODE_INFO(BREAKPOINT, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT),
+	/* ED */ OPCODE_INFO(THROW_VERIFICATION_ERROR, 20bc, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_THROW),
+	/* EE */ OPCODE_INFO(EXECUTE_INLINE, 35mi, NONE, T_X, LIST,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* EF */ OPCODE_INFO(EXECUTE_INLINE_RANGE, 3rmi, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* F0 */ OPCODE_INFO(INVOKE_OBJECT_INIT_RANGE, 3rc, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* F1 */ OPCODE_INFO(RETURN_VOID_BARRIER, 10x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_RETURN),
+	/* F2 */ OPCODE_INFO(IGET_QUICK, 22cs, VA, T_X, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* F3 */ OPCODE_INFO(IGET_WIDE_QUICK, 22cs, VA, T_X, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* F4 */ OPCODE_INFO(IGET_OBJECT_QUICK, 22cs, VA, T_L, FIXED,
+			VB, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* F5 */ OPCODE_INFO(IPUT_QUICK, 22cs, NONE, T_X, FIXED,
+			VA, T_X, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* F6 */ OPCODE_INFO(IPUT_WIDE_QUICK, 22cs, NONE, T_X, FIXED,
+			VA, T_X, VB, T_L, NONE, T_X, DTC_OPF_WIDE | DTC_OPF_CONT | DTC_OPF_THROW),
+	/* F7 */ OPCODE_INFO(IPUT_OBJECT_QUICK, 22cs, NONE, T_X, FIXED,
+			VA, T_L, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* F8 */ OPCODE_INFO(INVOKE_VIRTUAL_QUICK, 35ms, NONE, T_X, LIST,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* F9 */ OPCODE_INFO(INVOKE_VIRTUAL_QUICK_RANGE, 3rms, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* FA */ OPCODE_INFO(INVOKE_SUPER_QUICK, 35ms, NONE, T_X, LIST,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* FB */ OPCODE_INFO(INVOKE_SUPER_QUICK_RANGE, 3rms, NONE, T_X, RANGE,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW | DTC_OPF_INVOKE | DTC_OPF_RESULT),
+	/* FC */ OPCODE_INFO(IPUT_OBJECT_VOLATILE, 22c, NONE, T_X, FIXED,
+			VA, T_L, VB, T_L, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* FD */ OPCODE_INFO(SGET_OBJECT_VOLATILE, 21c, VA, T_L, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* FE */ OPCODE_INFO(SPUT_OBJECT_VOLATILE, 21c, NONE, T_X, FIXED,
+			VA, T_L, NONE, T_X, NONE, T_X, DTC_OPF_CONT | DTC_OPF_THROW),
+	/* FF */ OPCODE_INFO(UNUSED_FF, 00x, NONE, T_X, FIXED,
+			NONE, T_X, NONE, T_X, NONE, T_X, DTC_OPF_UNUSED),
+};
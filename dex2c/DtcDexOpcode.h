@@ -0,0 +1,93 @@
+/*********************************************************************
+*   DtcDexOpcode.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_DEX_OPCODE_H_
+#define _DTC_DEX_OPCODE_H_
+
+#include "DtcCommon.h"
+#include "DtcDexLiveWeb.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// The maximum number of the fixed use operands
+#define DTC_OPCODE_MAX_USES			3
+
+// The register operands of an instruction
+#define DTC_OPND_NONE					0
+#define DTC_OPND_VA					1
+#define DTC_OPND_VB					2
+#define DTC_OPND_VC					3
+
+// The kinds of the use operands
+#define DTC_USE_FIXED					0	/* the fixed use operands */
+#define DTC_USE_LIST					1	/* {vC, vD, vE, vF, vG} of the 35c formats */
+#define DTC_USE_RANGE					2	/* {vC ... vN} of the 3rc formats */
+
+// The data type of the def, which is the same as the type of the first use
+#define DTC_TYPE_OF_USE				0xFF
+
+// Flags for opcodes
+#define DTC_OPF_WIDE					0x0001	/* reads or writes register pairs */
+#define DTC_OPF_CONT					0x0002	/* can continue to the next instruction */
+#define DTC_OPF_THROW					0x0004	/* can throw an exception */
+#define DTC_OPF_BRANCH				0x0008	/* can branch to a target */
+#define DTC_OPF_SWITCH				0x0010	/* can branch through a switch table */
+#define DTC_OPF_RETURN				0x0020	/* returns from the method */
+#define DTC_OPF_INVOKE				0x0040	/* invokes a method */
+#define DTC_OPF_RESULT				0x0080	/* leaves a result for the next move-result */
+#define DTC_OPF_MOVE_RESULT			0x0100	/* defines the result of the previous instruction */
+#define DTC_OPF_UNUSED				0x0200	/* never passes the verifier */
+
+// The properties of an opcode
+typedef struct {
+
+	// The instruction format (InstructionFormat)
+	uint8_t nFormat;
+
+	// The def operand and its data type (DtcDexDataType_t or DTC_TYPE_OF_USE)
+	uint8_t nDefOperand;
+	uint8_t nDefType;
+
+	// The use operands in the order of the use webs, and their data types
+	uint8_t nUseKind;
+	uint8_t pUseOperands[DTC_OPCODE_MAX_USES];
+	uint8_t pUseTypes[DTC_OPCODE_MAX_USES];
+
+	uint16_t nFlags;
+
+} DtcDexOpcodeInfo_t;
+
+///////////////////////////////////////////////////////////////////////
+// Global Variable Declaration
+///////////////////////////////////////////////////////////////////////
+
+extern const DtcDexOpcodeInfo_t gDtcOpcodeInfoTable[kNumPackedOpcodes];
+
+///////////////////////////////////////////////////////////////////////
+// Global Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will return the properties of the given opcode, which are shared by
+ * the leader scan, the liveness analysis, the type resolution and the translation.
+ *
+ * @param nOpcode an opcode
+ * @return the properties of the opcode
+ */
+static inline const DtcDexOpcodeInfo_t *
+dtcGetOpcodeInfo(Opcode nOpcode) {
+	return &gDtcOpcodeInfoTable[nOpcode & 0xFF];
+}
+
+#endif
@@ -15,6 +15,8 @@
 
 #include "DtcCommon.h"
 #include "DtcDexLiveWeb.h"
+#include "DtcDexInsnTable.h"
+#include "DtcDexOpcode.h"
 
 ///////////////////////////////////////////////////////////////////////
 // User-defined Type Definition
@@ -26,6 +28,10 @@ typedef vector<DtcDexLiveWeb *> DtcDexLiveWebList_t;
 // DtcDexcode Class Declaration
 ///////////////////////////////////////////////////////////////////////
 
+/**
+ * A dex code is a view of a row of the instruction table of the method, which is
+ * passed by value and does not own any memory.
+ */
 class DtcDexcode {
 	
 private :
@@ -33,58 +39,90 @@ private :
 	// Member Variable Declaration
 	///////////////////////////////////////////////////////////////////
 
-	// Decoded instruction from the dex code
-	DecodedInstruction *m_pDecodedInsn;
+	// The instruction table of the method
+	DtcDexInsnTable *m_pTable;
 
-	// Instruction index
-	uint32_t m_nInsnIndex;
-
-	// Def webs
-	DtcDexLiveWebList_t m_rDefWebs;
-	
-	// Use webs
-	DtcDexLiveWebList_t m_rUseWebs;
+	// The row of the instruction
+	uint32_t m_nRow;
 
 public :
 	///////////////////////////////////////////////////////////////////
 	// Constructor & Destructor Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	DtcDexcode(const uint16_t *pInsn, uint32_t nInsnIndex);
-	
-	virtual ~DtcDexcode();
+	/**
+	 * Constructor of DtcDexcode class
+	 *
+	 * @param pTable the instruction table
+	 * @param nRow the row of the instruction
+	 */
+	inline DtcDexcode(DtcDexInsnTable *pTable, uint32_t nRow) {
+		m_pTable = pTable;
+		m_nRow = nRow;
+	}
 
 	///////////////////////////////////////////////////////////////////
 	// Accessor & Mutator Declaration/Definition
 	///////////////////////////////////////////////////////////////////
 
 	/**
-	 * This function will return the decoded instruction including opcode and operands.
+	 * This function will return the opcode of the instruction.
+	 *
+	 * @return the opcode
+	 */
+	inline Opcode GetOpcode()				{ return m_pTable->GetOpcode(m_nRow);	}
+
+	/**
+	 * This function will return the operands of the instruction as they are decoded,
+	 * except the 35c and 51l formats described in DtcDexInsnTable.
+	 *
+	 * @return the operand
+	 */
+	inline uint32_t GetVA()				{ return m_pTable->GetVA(m_nRow);		}
+	inline uint32_t GetVB()				{ return m_pTable->GetVB(m_nRow);		}
+	inline uint32_t GetVC()				{ return m_pTable->GetVC(m_nRow);		}
+
+	inline uint32_t GetArg(uint32_t nIndex)	{ return m_pTable->GetArg(m_nRow, nIndex);	}
+
+	inline uint64_t GetVBWide()			{ return m_pTable->GetVBWide(m_nRow);	}
+
+	/**
+	 * This function will return the register named by the given operand.
+	 *
+	 * @param nOperand the operand (DTC_OPND_VA, DTC_OPND_VB or DTC_OPND_VC)
+	 * @return the register number
+	 */
+	inline uint32_t GetOperand(uint32_t nOperand) {
+		return (nOperand == DTC_OPND_VA) ? GetVA() : (nOperand == DTC_OPND_VB) ? GetVB() : GetVC();
+	}
+
+	/**
+	 * This function will return the properties of the opcode.
 	 *
-	 * @return the decoded instruction
+	 * @return the properties of the opcode
 	 */
-	inline DecodedInstruction *GetDecodedInfo()	{ return m_pDecodedInsn;	}
+	inline const DtcDexOpcodeInfo_t *GetInfo()	{ return dtcGetOpcodeInfo(GetOpcode());	}
 
 	/**
 	 * This function will return the instruction index.
 	 *
 	 * @return the instruction index
 	 */
-	inline uint32_t GetInsnIndex()				{ return m_nInsnIndex;	}
-	
+	inline uint32_t GetInsnIndex()			{ return m_pTable->GetPc(m_nRow);		}
+
 	/**
-	 * This function will return the list of the def webs.
+	 * This function will return the number of the def webs.
 	 *
-	 * @return the list of the def webs
+	 * @return the number of the def webs
 	 */
-	inline DtcDexLiveWebList_t &GetDefWebs()		{ return m_rDefWebs;		}
+	inline uint32_t GetDefCount()			{ return m_pTable->GetDefCount(m_nRow);	}
 
 	/**
-	 * This function will return the list of the use webs.
+	 * This function will return the number of the use webs.
 	 *
-	 * @return the list of the use webs
+	 * @return the number of the use webs
 	 */
-	inline DtcDexLiveWebList_t &GetUseWebs()		{ return m_rUseWebs;		}
+	inline uint32_t GetUseCount()			{ return m_pTable->GetUseCount(m_nRow);	}
 
 	/**
 	 * This function will return a def web indicated by the given index from the def web list
@@ -92,7 +130,7 @@ public :
 	 * @return a def web at the position of the given index
 	 */
 	inline DtcDexLiveWeb *GetDefWeb(uint32_t nIndex) {
-		return (nIndex < m_rDefWebs.size()) ? m_rDefWebs[nIndex] : NULL;
+		return (nIndex == 0) ? m_pTable->GetDefWeb(m_nRow) : NULL;
 	}
 
 	/**
@@ -101,7 +139,7 @@ public :
 	 * @return an use web at the position of the given index
 	 */
 	inline DtcDexLiveWeb *GetUseWeb(uint32_t nIndex) {
-		return (nIndex < m_rUseWebs.size()) ? m_rUseWebs[nIndex] : NULL;
+		return m_pTable->GetUseWeb(m_nRow, nIndex);
 	}
 	
 	/**
@@ -110,7 +148,7 @@ public :
 	 * @param pWeb a live web to be inserted into the def web list
 	 */
 	inline void AppendDefWeb(DtcDexLiveWeb *pWeb)	{ 
-		m_rDefWebs.push_back(pWeb);	
+		m_pTable->AppendDefWeb(m_nRow, pWeb);
 	}
 
 	/**
@@ -119,7 +157,7 @@ public :
 	 * @param pWeb a live web to be inserted into the use web list
 	 */
 	inline void AppendUseWeb(DtcDexLiveWeb *pWeb) {
-		m_rUseWebs.push_back(pWeb);	
+		m_pTable->AppendUseWeb(m_nRow, pWeb);
 	}
 
 	///////////////////////////////////////////////////////////////////
@@ -132,9 +170,9 @@ public :
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
 	
-	virtual void Write(ostream &pOut);
+	void Write(ostream &pOut);
 
-	friend ostream &operator << (ostream &pOut, DtcDexcode *pCode);	
+	friend ostream &operator << (ostream &pOut, DtcDexcode &rCode);	
 };
 
 #endif
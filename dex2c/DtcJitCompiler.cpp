@@ -11,6 +11,22 @@
 **********************************************************************/
 
 #include "DtcJitCompiler.h"
+#include "DtcNativeEmitter.h"
+#include "DtcStats.h"
+#include "DtcOutcome.h"
+#include "DtcCallCell.h"
+
+#include <dlfcn.h>
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Declaration
+///////////////////////////////////////////////////////////////////////
+
+static void RecordMethod(DtcCMethod *pCMethod, uint32_t nBytes, bool_t bNative);
+
+#if defined(DTC_ENABLE_NATIVE_BACKEND)
+static bool_t GetIsNativeTarget(DtcCMethod *pCMethod);
+#endif
 
 ///////////////////////////////////////////////////////////////////////
 // Constructor & Destructor
@@ -18,11 +34,33 @@
 
 DtcJitCompiler::DtcJitCompiler()  {
 
+	m_pContext = new DtcCompilerContext();
 	m_pCMethod = NULL;
+
+	m_nBatchBudget = DTC_BATCH_BUDGET;
+	m_nStartupCost = DTC_CC_STARTUP_COST;
+	m_nCostPerInsn = DTC_CC_COST_PER_INSN;
+	m_nBatchSeq = 0;
+
+	m_pCacheDir[0] = '\0';
+	m_bNoCompiler = FALSE;
+
+	m_pThreadPool = NULL;
+
+	m_rLibHandleList.clear();
+	m_rOsrEntryTable.clear();
+
+	pthread_mutex_init(&m_rOsrLock, NULL);
 }
 
 DtcJitCompiler::~DtcJitCompiler() {
-	// Do nothing
+
+	delete m_pContext;
+
+	// The temporary files are removed by every batch, so the directory is empty
+	if(m_pCacheDir[0] != '\0') rmdir(m_pCacheDir);
+
+	pthread_mutex_destroy(&m_rOsrLock);
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -42,44 +80,439 @@ DtcJitCompiler::TranslateMethod(Method *pMethod) {
 
 	DTC_DEBUG(DEX2C_TAG, "DtcJitCompiler->TranslateMethod Invoked...");
 
-	if(pMethod == NULL) {
-		DTC_ERROR(DEX2C_TAG, "Invalid input Dex method - %X", pMethod);
-		return DTC_ERROR_INVALID_PARAMETER;
+	DtcCMethod *cMethod = NULL;
+
+	// Release the IR of the previous compilation, whose memory is reused
+	m_pCMethod = NULL;
+	m_pContext->Reset();
+
+	if((error = m_pContext->Translate(pMethod, m_pThreadPool, cMethod)) != DTC_SUCCESS) {
+		return error;
 	}
+
+	m_pCMethod = cMethod;
 	
-	DtcDexMethod *dexMethod = new DtcDexMethod(pMethod);
+	// Print out the C code
+#if defined(DTC_ENABLE_DEBUG)
+	DtcCodeBuffer code;
+	code << cMethod;
+	DTC_DEBUG(DEX2C_TAG, "%s", code.GetString());
+#endif
 
-	if((error = dexMethod->BuildIR()) != DTC_SUCCESS) {
-		
-		DTC_ERROR(DEX2C_TAG, "TranslateMethod - Build IR (error:%d)", error);
-		return error;
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will compile a batch of the given methods into a single C translation 
+ * unit so that the startup cost of the C compiler and dlopen is paid once per batch.
+ * The batch is taken from the head of the array as long as the estimated compilation 
+ * time fits into the latency budget, and at least one method is always taken.
+ *
+ * @param ppMethods the array of the methods to be compiled
+ * @param nMethods the number of the methods in the array
+ * @param nConsumed the number of the methods taken from the head of the array
+ * @param pBlockCounts the array of the execution counts of the blocks of the methods,
+ *        which select the regions of the large methods (NULL to compile the whole methods)
+ * @return error information
+ */
+DtcError_t
+DtcJitCompiler::CompileBatch(Method **ppMethods, uint32_t nMethods, uint32_t &nConsumed,
+	DtcBlockCountTable_t *pBlockCounts /* = NULL */) {
+
+	DtcError_t error;
+
+	DTC_DEBUG(DEX2C_TAG, "DtcJitCompiler->CompileBatch Invoked...");
+
+	nConsumed = 0;
+
+	if(ppMethods == NULL || nMethods == 0) {
+		DTC_ERROR(DEX2C_TAG, "Invalid input method batch - %X", ppMethods);
+		return DTC_ERROR_INVALID_PARAMETER;
 	}
 
-	// Print out the dex IR
-#if 0
-	strstream o;
-	o << dexMethod << ends;
-	DTC_DEBUG(DEX2C_TAG, "%s", o.str());
+	uint32_t ninsns = 0;
+	nConsumed = SelectBatch(ppMethods, nMethods, ninsns);
+
+	DtcCMethodList_t cMethods;
+
+	// The time spent to translate each of the methods left to the C compiler
+	vector<u8> times;
+
+	m_pCMethod = NULL;
+	m_pContext->Reset();
+
+	for(uint32_t i = 0; i < nConsumed; i++) {
+
+		DtcCMethod *cMethod = NULL;
+
+		// Skip the methods compiled by an earlier batch
+		if(ppMethods[i]->compiledCode != NULL) continue;
+
+		DtcBlockCountTable_t *counts = (pBlockCounts != NULL) ? &pBlockCounts[i] : NULL;
+
+		u8 begin = dvmGetRelativeTimeUsec();
+
+		if((error = m_pContext->Translate(ppMethods[i], m_pThreadPool, cMethod, counts)) != DTC_SUCCESS) {
+
+			// The dex code rejecting the method tells which opcode to be lowered first
+			DtcDexMethod *dexMethod = m_pContext->GetLastDexMethod();
+			uint32_t pc = DTC_OUTCOME_NO_PC;
+			Opcode opcode = OP_NOP;
+
+			if(dexMethod != NULL) dexMethod->FindFailedDexcode(pc, opcode);
+
+			gDtcOutcomes.Record(ppMethods[i], error, dvmGetRelativeTimeUsec() - begin, pc, opcode);
+			continue;
+		}
+
+#if defined(DTC_ENABLE_NATIVE_BACKEND)
+
+		// The methods handled by the native backend do not need the C compiler at all
+		if(GetIsNativeTarget(cMethod) == FALSE) {
+
+			cMethods.push_back(cMethod);
+			times.push_back(dvmGetRelativeTimeUsec() - begin);
+			continue;
+		}
+
+		DtcNativeEmitter *emitter = new DtcNativeEmitter(cMethod);
+
+		DTC_PHASE_BEGIN(EMIT);
+		error = emitter->Emit();
+		DTC_PHASE_END(EMIT);
+
+		if(error == DTC_SUCCESS) {
+
+			RecordMethod(cMethod, emitter->GetCodeSize(), true);
+
+			// The code takes the argument words like the C function of the C backend
+			InstallMethod(ppMethods[i], emitter->GetEntry(), TRUE);
+			dtcBindCallCell(ppMethods[i], emitter->GetEntry());
+
+			gDtcOutcomes.Record(ppMethods[i], DTC_SUCCESS, dvmGetRelativeTimeUsec() - begin);
+
+			delete emitter;
+			continue;
+		}
+
+		delete emitter;
+
 #endif
 
-	DtcCMethod *cMethod = new DtcCMethod(dexMethod);
+		cMethods.push_back(cMethod);
+		times.push_back(dvmGetRelativeTimeUsec() - begin);
+	}
+
+	if(cMethods.empty()) {
+		m_pContext->Reset();
+		return DTC_SUCCESS;
+	}
+
+	u8 start = dvmGetRelativeTimeUsec();
+
+	vector<DtcError_t> errors(cMethods.size(), DTC_SUCCESS);
+
+	error = BuildBatch(cMethods, 0, cMethods.size(), errors);
+
+	// Refine the cost per dex code unit with the measured compilation time
+	u8 elapsed = dvmGetRelativeTimeUsec() - start;
+
+	// The methods of the batch share the time of the C compiler
+	for(uint32_t i = 0; i < cMethods.size(); i++) {
+
+		gDtcOutcomes.Record(cMethods[i]->GetDexMethod()->GetMethod(), errors[i],
+			times[i] + elapsed / cMethods.size());
+	}
+
+	if(elapsed > m_nStartupCost && ninsns > 0) {
+
+		uint32_t sample = (uint32_t)((elapsed - m_nStartupCost) / ninsns);
+		m_nCostPerInsn = (m_nCostPerInsn * 3 + sample) / 4;
+	}
+
+	DTC_DEBUG(DEX2C_TAG, "CompileBatch - %d methods, %d insns, %d us", 
+		cMethods.size(), ninsns, (uint32_t)elapsed);
+
+	m_pContext->Reset();
+
+	return error;
+}
+
+/**
+ * This function will select the methods of the next batch within the latency budget.
+ *
+ * @param ppMethods the array of the methods to be compiled
+ * @param nMethods the number of the methods in the array
+ * @param nInsns the total number of the dex code units in the batch (output)
+ * @return the number of the methods in the batch
+ */
+uint32_t
+DtcJitCompiler::SelectBatch(Method **ppMethods, uint32_t nMethods, uint32_t &nInsns) {
+
+	uint64_t budget = (uint64_t)m_nBatchBudget * 1000;
+	uint64_t cost = m_nStartupCost;
+	uint32_t count = 0;
+
+	nInsns = 0;
+
+	while(count < nMethods) {
+
+		const DexCode *dexCode = dvmGetMethodCode(ppMethods[count]);
+		uint32_t size = (dexCode != NULL) ? dexCode->insnsSize : 0;
+
+		cost += (uint64_t)m_nCostPerInsn * size;
+
+		if(count > 0 && cost > budget) break;
+
+		nInsns += size;
+		count++;
+	}
+
+	return count;
+}
+
+/**
+ * This function will emit the given range of the C methods into a translation unit, 
+ * compile it into a shared object, and install the entries of the methods. If the 
+ * batch cannot be built, it will be split in half so that a single bad method does 
+ * not lose the whole batch, unless the C compiler cannot be executed at all.
+ * The files are kept in a private directory, so no other user can replace them.
+ *
+ * @param rMethods the translated C methods
+ * @param nBegin the index of the first method in the range
+ * @param nEnd the index next to the last method in the range
+ * @param rErrors the result of each method (output)
+ * @return error information
+ */
+DtcError_t
+DtcJitCompiler::BuildBatch(DtcCMethodList_t &rMethods, uint32_t nBegin, uint32_t nEnd,
+	vector<DtcError_t> &rErrors) {
+
+	char srcPath[BUF_LEN * 2];
+	char libPath[BUF_LEN * 2];
+
+	DtcError_t error = DTC_SUCCESS;
+
+	if(m_pCacheDir[0] == '\0' && m_bNoCompiler == FALSE) {
+
+		snprintf(m_pCacheDir, sizeof(m_pCacheDir), "%s/dtc_%d_XXXXXX", DTC_CACHE_DIR, getpid());
+
+		// The directory is created with the mode 0700
+		if(mkdtemp(m_pCacheDir) == NULL) {
+
+			DTC_ERROR(DEX2C_TAG, "BuildBatch - Fail to create %s", m_pCacheDir);
+			m_pCacheDir[0] = '\0';
+			m_bNoCompiler = TRUE;
+		}
+	}
+
+	if(m_bNoCompiler == TRUE) {
+
+		for(uint32_t i = nBegin; i < nEnd; i++) rErrors[i] = DTC_ERROR_BATCH_NO_COMPILER;
+		return DTC_ERROR_BATCH_NO_COMPILER;
+	}
+
+	uint32_t seq = m_nBatchSeq++;
+
+	snprintf(srcPath, sizeof(srcPath), "%s/dtc_%u.c", m_pCacheDir, seq);
+	snprintf(libPath, sizeof(libPath), "%s/dtc_%u.so", m_pCacheDir, seq);
+
+	// Emit the shared helper declarations followed by all the methods of the batch
+	// directly into the mapping of the source file
+	DtcCodeBuffer srcFile;
 
-	if((error = cMethod->Translate()) != DTC_SUCCESS) {
-		
-		DTC_ERROR(DEX2C_TAG, "TranslateMethod - Translate Dex to C (error:%d)", error);
+	// The size of the source emitted for each method
+	vector<uint32_t> sizes(nEnd - nBegin);
+
+	if((error = srcFile.OpenFile(srcPath, TRUE)) != DTC_SUCCESS) {
 		return error;
 	}
-	
-	// Print out the C code
-#if 1
-	strstream o;
-	o << cMethod << ends;
-	DTC_DEBUG(DEX2C_TAG, "%s", o.str());
-#endif
+
+	DTC_PHASE_BEGIN(EMIT);
+
+	DtcCMethod::WriteHeader(srcFile);
+
+	for(uint32_t i = nBegin; i < nEnd; i++) {
+
+		uint32_t offset = srcFile.GetLength();
+
+		srcFile << '\n' << rMethods[i];
+
+		sizes[i - nBegin] = srcFile.GetLength() - offset;
+	}
+
+	error = srcFile.CloseFile();
+
+	DTC_PHASE_END(EMIT);
+
+	void *handle = NULL;
+
+	if(error != DTC_SUCCESS) {
+
+		DTC_ERROR(DEX2C_TAG, "BuildBatch - Write %s", srcPath);
+	}
+	else {
+
+		DTC_PHASE_BEGIN(BACKEND);
+		error = DtcCMethod::BuildSharedObject(libPath, srcPath);
+		DTC_PHASE_END(BACKEND);
+
+		if(error != DTC_SUCCESS) {
+			DTC_ERROR(DEX2C_TAG, "BuildBatch - Compile %s", srcPath);
+		}
+	}
+
+	DTC_PHASE_BEGIN(LOAD);
+
+	if(error == DTC_SUCCESS && (handle = dlopen(libPath, RTLD_NOW | RTLD_LOCAL)) == NULL) {
+
+		DTC_ERROR(DEX2C_TAG, "BuildBatch - Load %s (%s)", libPath, dlerror());
+		error = DTC_ERROR_BATCH_LOADING;
+	}
+
+	unlink(srcPath);
+	unlink(libPath);
+
+	if(error != DTC_SUCCESS) {
+
+		DTC_PHASE_END(LOAD);
+
+		// Splitting the batch only runs the compiler that cannot start again and again
+		if(error == DTC_ERROR_BATCH_NO_COMPILER) {
+
+			m_bNoCompiler = TRUE;
+
+			for(uint32_t i = nBegin; i < nEnd; i++) rErrors[i] = error;
+			return error;
+		}
+
+		if(nEnd - nBegin == 1) {
+
+			rErrors[nBegin] = error;
+			return error;
+		}
+
+		uint32_t mid = nBegin + (nEnd - nBegin) / 2;
+
+		BuildBatch(rMethods, nBegin, mid, rErrors);
+		BuildBatch(rMethods, mid, nEnd, rErrors);
+
+		return DTC_SUCCESS;
+	}
+
+	m_rLibHandleList.push_back(handle);
+
+	// Install the entries of all the methods in the batch
+	for(uint32_t i = nBegin; i < nEnd; i++) {
+
+		DtcCMethod *cMethod = rMethods[i];
+		void *entry = dlsym(handle, cMethod->GetFuncName());
+
+		if(entry == NULL) {
+			DTC_ERROR(DEX2C_TAG, "BuildBatch - Missing entry %s", cMethod->GetFuncName());
+			rErrors[i] = DTC_ERROR_BATCH_LOADING;
+			continue;
+		}
+
+		// The OSR entry is registered before the method is published
+		const char *osrName = cMethod->GetOsrFuncName();
+		void *osrEntry = (osrName != NULL) ? dlsym(handle, osrName) : NULL;
+
+		if(osrEntry != NULL) {
+
+			pthread_mutex_lock(&m_rOsrLock);
+
+			DtcOsrEntry_t &osr = m_rOsrEntryTable[cMethod->GetDexMethod()->GetMethod()];
+
+			osr.pEntry = osrEntry;
+			osr.rHeaderSet = cMethod->GetDexMethod()->GetLoopHeaders();
+
+			pthread_mutex_unlock(&m_rOsrLock);
+		}
+
+		Method *method = cMethod->GetDexMethod()->GetMethod();
+
+		// The interpreter has an entry stub only for the methods of a few argument words,
+		// and keeps interpreting the others, which the compiled callers still call
+		InstallMethod(method, entry, !cMethod->GetDexMethod()->HasRegion() &&
+			method->insSize <= DTC_ENTRY_MAX_INS);
+
+		// The compiled callers, including the ones in this batch, call the C function
+		// directly from now on, which a region cannot take since it starts anywhere
+		if(cMethod->GetDexMethod()->HasRegion() == FALSE) {
+			dtcBindCallCell(method, entry);
+		}
+
+		RecordMethod(cMethod, sizes[i - nBegin], false);
+	}
+
+	DTC_PHASE_END(LOAD);
 
 	return DTC_SUCCESS;
 }
 
+/**
+ * This function will return the OSR entry of the given method for a loop header.
+ *
+ * @param pMethod the compiled method
+ * @param nPc the dex pc of the loop header in code units
+ * @return the entry address of the OSR entry (NULL if there is none for the pc)
+ */
+void *
+DtcJitCompiler::GetOsrEntry(const Method *pMethod, uint32_t nPc) {
+
+	void *entry = NULL;
+
+	pthread_mutex_lock(&m_rOsrLock);
+
+	DtcOsrEntryTable_t::iterator iter = m_rOsrEntryTable.find(pMethod);
+
+	if(iter != m_rOsrEntryTable.end() && iter->second.rHeaderSet.count(nPc) > 0) {
+		entry = iter->second.pEntry;
+	}
+
+	pthread_mutex_unlock(&m_rOsrLock);
+
+	return entry;
+}
+
+/**
+ * This function will publish the compiled code of the given method. The code of a region
+ * is entered only through its OSR entries, so the interpreter keeps running the method
+ * on the invocations.
+ *
+ * @param pMethod the resolved method
+ * @param pEntry the entry address of the compiled code
+ * @param bEntry whether the interpreter enters the code on the invocations
+ */
+void
+DtcJitCompiler::InstallMethod(Method *pMethod, void *pEntry, bool_t bEntry) {
+
+	// The compiler thread waits in THREAD_VMWAIT, so it becomes running for the update,
+	// which waits for a pending suspension like the other threads touching the methods
+	Thread *self = dvmThreadSelf();
+	ThreadStatus oldStatus = (self != NULL) ? self->status : THREAD_RUNNING;
+
+	if(oldStatus != THREAD_RUNNING) dvmChangeStatus(self, THREAD_RUNNING);
+
+	// The code must be visible before the interpreter can see the entry
+	ANDROID_MEMBAR_STORE();
+
+	pMethod->compiledCode = pEntry;
+
+	DTC_INSTALL_RECORD();
+
+	if(bEntry == TRUE) {
+
+		// The interpreter jumps to the entry once it sees the flag
+		ANDROID_MEMBAR_STORE();
+
+		android_atomic_or(ACC_COMPILE_TARGET, (volatile int32_t *)&pMethod->accessFlags);
+	}
+
+	if(oldStatus != THREAD_RUNNING) dvmChangeStatus(self, oldStatus);
+}
+
 /**
  * This function will print out the generated C code to the file at the given path.
  *
@@ -97,9 +530,71 @@ DtcJitCompiler::DumpFile(const char * pFilePath /* = NULL */) {
 		pFilePath = "./dtcjit.out.tmp"; /* Method Signature */
 	}
 
-	ofstream outFile(pFilePath);
-	outFile << m_pCMethod << endl;
-	outFile.close();
+	DtcCodeBuffer outFile;
+
+	if(outFile.OpenFile(pFilePath) == DTC_SUCCESS) {
+		outFile << m_pCMethod << '\n';
+		outFile.CloseFile();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+#if defined(DTC_ENABLE_NATIVE_BACKEND)
+
+/**
+ * This function will check whether the native backend can replace the C backend
+ * for the given method. The code of a region has no entry of the whole method, and
+ * the return value must be produced exactly as the C function of the C backend does.
+ *
+ * @param pCMethod the translated C method
+ * @return TRUE if the machine code can be installed for the method
+ */
+static bool_t
+GetIsNativeTarget(DtcCMethod *pCMethod) {
+
+	DtcDexMethod *dexMethod = pCMethod->GetDexMethod();
+
+	if(dexMethod->HasRegion()) {
+		return FALSE;
+	}
+
+	switch(dexMethod->GetMethod()->shorty[0]) {
+		case 'V':
+		case 'Z':
+		case 'B':
+		case 'S':
+		case 'C':
+		case 'I':
+		case 'L':
+			return TRUE;
+		case 'J':
+			// The 64-bit values are kept in a single register only on the 64-bit targets
+			return (sizeof(void *) == 8) ? TRUE : FALSE;
+		default:
+			return FALSE;
+	}
+}
+
+#endif
+
+/**
+ * This function will record the outcome of a compiled method in the statistics of
+ * the calling thread.
+ *
+ * @param pCMethod the compiled C method
+ * @param nBytes the number of the bytes emitted for the method
+ * @param bNative whether the machine code is emitted directly
+ */
+static void
+RecordMethod(DtcCMethod *pCMethod, uint32_t nBytes, bool_t bNative) {
+
+	DtcDexMethod *dexMethod = pCMethod->GetDexMethod();
+
+	DTC_METHOD_RECORD(dexMethod->GetMethod(), dexMethod->GetInsnsSize(),
+		dexMethod->GetBasicBlocks().size(), nBytes, bNative);
 }
 
 ///////////////////////////////////////////////////////////////////////
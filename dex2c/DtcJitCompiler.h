@@ -16,6 +16,25 @@
 #include "DtcCommon.h"
 #include "DtcCMethod.h"
 #include "DtcDexMethod.h"
+#include "DtcThreadPool.h"
+#include "DtcCompilerContext.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+typedef vector<void *> DtcLibHandleList_t;
+
+// The OSR entry of a compiled method and the loop headers accepted by the entry
+typedef struct {
+
+	void *pEntry;
+
+	DtcAddressSet_t rHeaderSet;
+
+} DtcOsrEntry_t;
+
+typedef map<const Method *, DtcOsrEntry_t> DtcOsrEntryTable_t;
 
 ///////////////////////////////////////////////////////////////////////
 // DtcJitCompiler Class Declaration
@@ -28,8 +47,40 @@ private:
 	// Member Variable Declaration
 	///////////////////////////////////////////////////////////////////
 
+	// The context owning the IR of the methods being compiled
+	DtcCompilerContext *m_pContext;
+
+	// The method translated last, which stays valid until the next compilation
 	DtcCMethod *m_pCMethod;
 
+	// The latency budget of a batch compilation in milliseconds
+	uint32_t m_nBatchBudget;
+
+	// The estimated cost of the external C compiler in microseconds
+	uint32_t m_nStartupCost;
+	uint32_t m_nCostPerInsn;
+
+	// The sequence number of the batches to name the temporary files
+	uint32_t m_nBatchSeq;
+
+	// The directory only the VM can access, holding the temporary files of the batches
+	// (empty until the first batch)
+	char m_pCacheDir[BUF_LEN];
+
+	// Whether no batch can be built, since either the private directory or the C compiler
+	// is not available, which fails all the later batches at once
+	bool_t m_bNoCompiler;
+
+	// The handles of the loaded shared objects, which must stay loaded
+	DtcLibHandleList_t m_rLibHandleList;
+
+	// The thread pool translating the large methods in parallel (NULL for the serial translation)
+	DtcThreadPool *m_pThreadPool;
+
+	// The OSR entries of the compiled methods, which are looked up by the interpreter
+	DtcOsrEntryTable_t m_rOsrEntryTable;
+	pthread_mutex_t m_rOsrLock;
+
 public :
 	///////////////////////////////////////////////////////////////////
 	// Constructor & Destructor Declaration
@@ -39,14 +90,47 @@ public :
 	
 	virtual ~DtcJitCompiler();
 
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will be used to set the latency budget of a batch compilation.
+	 *
+	 * @param nBudget the latency budget in milliseconds
+	 */
+	inline void SetBatchBudget(uint32_t nBudget)	{ m_nBatchBudget = nBudget;	}
+
+	/**
+	 * This function will be used to set the thread pool translating the large methods.
+	 *
+	 * @param pPool the thread pool (NULL for the serial translation)
+	 */
+	inline void SetThreadPool(DtcThreadPool *pPool)	{ m_pThreadPool = pPool;	}
+
 	///////////////////////////////////////////////////////////////////
 	// Member Function Declaration
 	///////////////////////////////////////////////////////////////////
 	
 	DtcError_t TranslateMethod(Method *pMethod);
 
+	DtcError_t CompileBatch(Method **ppMethods, uint32_t nMethods, uint32_t &nConsumed,
+		DtcBlockCountTable_t *pBlockCounts = NULL);
+
+	void *GetOsrEntry(const Method *pMethod, uint32_t nPc);
+
 	void DumpFile(const char * pFilePath = NULL); 
 
+private:
+
+	uint32_t SelectBatch(Method **ppMethods, uint32_t nMethods, uint32_t &nInsns);
+
+	DtcError_t BuildBatch(DtcCMethodList_t &rMethods, uint32_t nBegin, uint32_t nEnd,
+		vector<DtcError_t> &rErrors);
+
+	void InstallMethod(Method *pMethod, void *pEntry, bool_t bEntry);
+
+public:
 	///////////////////////////////////////////////////////////////////
 	// Debugging Function Declaration
 	///////////////////////////////////////////////////////////////////
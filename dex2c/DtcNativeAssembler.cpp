@@ -0,0 +1,783 @@
+/*********************************************************************
+*   DtcNativeAssembler.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <sys/mman.h>
+
+#include "DtcNativeAssembler.h"
+
+///////////////////////////////////////////////////////////////////////
+// DtcNativeBuffer Class Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcNativeBuffer::DtcNativeBuffer() {
+
+	m_rCode.clear();
+}
+
+DtcNativeBuffer::~DtcNativeBuffer() {
+
+	m_rCode.clear();
+}
+
+/**
+ * This function will be used to append a 32-bit word in little endian.
+ *
+ * @param nWord a word to be appended
+ */
+void
+DtcNativeBuffer::Emit32(uint32_t nWord) {
+
+	Emit8((uint8_t)(nWord));
+	Emit8((uint8_t)(nWord >> 8));
+	Emit8((uint8_t)(nWord >> 16));
+	Emit8((uint8_t)(nWord >> 24));
+}
+
+/**
+ * This function will be used to append a 64-bit word in little endian.
+ *
+ * @param nDword a double word to be appended
+ */
+void
+DtcNativeBuffer::Emit64(uint64_t nDword) {
+
+	Emit32((uint32_t)(nDword));
+	Emit32((uint32_t)(nDword >> 32));
+}
+
+/**
+ * This function will overwrite the 32-bit word at the given offset.
+ *
+ * @param nOffset the byte offset of the word
+ * @param nWord the new word
+ */
+void
+DtcNativeBuffer::Patch32(uint32_t nOffset, uint32_t nWord) {
+
+	m_rCode[nOffset + 0] = (uint8_t)(nWord);
+	m_rCode[nOffset + 1] = (uint8_t)(nWord >> 8);
+	m_rCode[nOffset + 2] = (uint8_t)(nWord >> 16);
+	m_rCode[nOffset + 3] = (uint8_t)(nWord >> 24);
+}
+
+/**
+ * This function will return the 32-bit word at the given offset.
+ *
+ * @param nOffset the byte offset of the word
+ * @return the word
+ */
+uint32_t
+DtcNativeBuffer::Read32(uint32_t nOffset) {
+
+	return (uint32_t)m_rCode[nOffset] | ((uint32_t)m_rCode[nOffset + 1] << 8) |
+		((uint32_t)m_rCode[nOffset + 2] << 16) | ((uint32_t)m_rCode[nOffset + 3] << 24);
+}
+
+/**
+ * This function will copy the assembled code into a new executable memory region.
+ *
+ * @return the entry address of the installed code (NULL on failure)
+ */
+void *
+DtcNativeBuffer::Install() {
+
+	size_t size = m_rCode.size();
+
+	if(size == 0) {
+		return NULL;
+	}
+
+	void *code = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if(code == MAP_FAILED) {
+		DTC_ERROR(DEX2C_TAG, "Install - Fail to map the code buffer (size:%d)", size);
+		return NULL;
+	}
+
+	memcpy(code, &m_rCode[0], size);
+
+	if(mprotect(code, size, PROT_READ | PROT_EXEC) != 0) {
+		DTC_ERROR(DEX2C_TAG, "Install - Fail to protect the code buffer");
+		munmap(code, size);
+		return NULL;
+	}
+
+	__builtin___clear_cache((char *)code, (char *)code + size);
+
+	return code;
+}
+
+///////////////////////////////////////////////////////////////////////
+// DtcNativeAssembler Class Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcNativeAssembler::DtcNativeAssembler() {
+
+	m_rLabelTable.clear();
+	m_rFixupList.clear();
+
+	m_nFrameSize = 0;
+}
+
+DtcNativeAssembler::~DtcNativeAssembler() {
+
+	m_rLabelTable.clear();
+	m_rFixupList.clear();
+}
+
+/**
+ * This function will create the assembler for the host machine.
+ *
+ * @return a new assembler (NULL if the host machine is not supported)
+ */
+DtcNativeAssembler *
+DtcNativeAssembler::Create() {
+
+#if defined(__x86_64__)
+	return new DtcX64Assembler();
+#elif defined(__arm__)
+	return new DtcArmAssembler();
+#else
+	return NULL;
+#endif
+}
+
+/**
+ * This function will patch all the branches with the offsets of the bound labels.
+ *
+ * @return error information
+ */
+DtcError_t
+DtcNativeAssembler::Finalize() {
+
+	DtcNativeFixupList_t::iterator iter;
+
+	for(iter = m_rFixupList.begin(); iter != m_rFixupList.end(); iter++) {
+
+		DtcNativeLabelTable_t::iterator label = m_rLabelTable.find(iter->nLabel);
+
+		if(label == m_rLabelTable.end()) {
+			DTC_ERROR(DEX2C_TAG, "Finalize - Unbound label: %X", iter->nLabel);
+			return DTC_ERROR_NATIVE_CODE_GEN;
+		}
+
+		PatchBranch(iter->nOffset, label->second);
+	}
+
+	m_rFixupList.clear();
+
+	return DTC_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////
+// DtcX64Assembler Class Definition
+///////////////////////////////////////////////////////////////////////
+
+// x86-64 register numbers
+#define X64_RAX		0
+#define X64_RCX		1
+#define X64_RDX		2
+#define X64_RBX		3
+#define X64_RSP		4
+#define X64_RBP		5
+#define X64_RSI		6
+#define X64_RDI		7
+#define X64_R8		8
+#define X64_R9		9
+#define X64_R11		11
+#define X64_R12		12
+#define X64_R13		13
+#define X64_R14		14
+#define X64_R15		15
+
+DtcX64Assembler::DtcX64Assembler() {
+	// Do nothing
+}
+
+DtcX64Assembler::~DtcX64Assembler() {
+	// Do nothing
+}
+
+/**
+ * The callee-saved registers are allocated to the variables, so that they are
+ * preserved across the helper calls without any extra spill code.
+ *
+ * @param rRegs the list to be filled with the allocatable registers
+ */
+void
+DtcX64Assembler::GetAllocatableRegs(DtcNativeRegList_t &rRegs) {
+
+	rRegs.clear();
+	rRegs.push_back(X64_RBX);
+	rRegs.push_back(X64_R12);
+	rRegs.push_back(X64_R13);
+	rRegs.push_back(X64_R14);
+	rRegs.push_back(X64_R15);
+}
+
+DtcNativeReg_t
+DtcX64Assembler::GetArgReg(uint32_t nIndex) {
+
+	static const DtcNativeReg_t argRegs[] = {
+		X64_RDI, X64_RSI, X64_RDX, X64_RCX, X64_R8, X64_R9
+	};
+
+	return argRegs[nIndex];
+}
+
+/**
+ * The first scratch register is also used as the return register and
+ * the second one is used as the shift count register (cl). The third one
+ * holds the frame of the interpreter around the helper calls.
+ */
+DtcNativeReg_t
+DtcX64Assembler::GetScratchReg(uint32_t nIndex) {
+
+	return (nIndex == 0) ? X64_RAX : (nIndex == 1) ? X64_RCX : X64_RDX;
+}
+
+void
+DtcX64Assembler::EmitRex(bool_t bWide, DtcNativeReg_t nReg, DtcNativeReg_t nRm, bool_t bForce /* = FALSE */) {
+
+	uint8_t rex = 0x40 | (bWide ? 0x08 : 0) | ((nReg & 0x08) ? 0x04 : 0) | ((nRm & 0x08) ? 0x01 : 0);
+
+	if(rex != 0x40 || bForce) {
+		m_rBuffer.Emit8(rex);
+	}
+}
+
+void
+DtcX64Assembler::EmitRegReg(uint8_t nOpcode, DtcNativeReg_t nReg, DtcNativeReg_t nRm, bool_t bWide) {
+
+	EmitRex(bWide, nReg, nRm);
+	m_rBuffer.Emit8(nOpcode);
+	m_rBuffer.Emit8(0xC0 | ((nReg & 0x07) << 3) | (nRm & 0x07));
+}
+
+void
+DtcX64Assembler::EmitRegSlot(uint8_t nOpcode, DtcNativeReg_t nReg, uint32_t nOffset, bool_t bWide) {
+
+	// op reg, [rsp + disp32]
+	EmitRex(bWide, nReg, 0);
+	m_rBuffer.Emit8(nOpcode);
+	m_rBuffer.Emit8(0x84 | ((nReg & 0x07) << 3));
+	m_rBuffer.Emit8(0x24);
+	m_rBuffer.Emit32(nOffset);
+}
+
+void
+DtcX64Assembler::EmitPrologue(uint32_t nFrameSize) {
+
+	// Keep the stack 16-byte aligned after pushing rbp and 5 callee-saved registers
+	m_nFrameSize = ((nFrameSize + 15) & ~15) + 8;
+
+	m_rBuffer.Emit8(0x55);								// push rbp
+	m_rBuffer.Emit8(0x48); m_rBuffer.Emit8(0x89); m_rBuffer.Emit8(0xE5);	// mov rbp, rsp
+	m_rBuffer.Emit8(0x53);								// push rbx
+	m_rBuffer.Emit8(0x41); m_rBuffer.Emit8(0x54);			// push r12
+	m_rBuffer.Emit8(0x41); m_rBuffer.Emit8(0x55);			// push r13
+	m_rBuffer.Emit8(0x41); m_rBuffer.Emit8(0x56);			// push r14
+	m_rBuffer.Emit8(0x41); m_rBuffer.Emit8(0x57);			// push r15
+	m_rBuffer.Emit8(0x48); m_rBuffer.Emit8(0x81); m_rBuffer.Emit8(0xEC);	// sub rsp, imm32
+	m_rBuffer.Emit32(m_nFrameSize);
+}
+
+void
+DtcX64Assembler::EmitEpilogue() {
+
+	m_rBuffer.Emit8(0x48); m_rBuffer.Emit8(0x81); m_rBuffer.Emit8(0xC4);	// add rsp, imm32
+	m_rBuffer.Emit32(m_nFrameSize);
+	m_rBuffer.Emit8(0x41); m_rBuffer.Emit8(0x5F);			// pop r15
+	m_rBuffer.Emit8(0x41); m_rBuffer.Emit8(0x5E);			// pop r14
+	m_rBuffer.Emit8(0x41); m_rBuffer.Emit8(0x5D);			// pop r13
+	m_rBuffer.Emit8(0x41); m_rBuffer.Emit8(0x5C);			// pop r12
+	m_rBuffer.Emit8(0x5B);								// pop rbx
+	m_rBuffer.Emit8(0x5D);								// pop rbp
+	m_rBuffer.Emit8(0xC3);								// ret
+}
+
+void
+DtcX64Assembler::EmitLoadImm(DtcNativeReg_t nDst, uint64_t nImm, bool_t bWide) {
+
+	if(!bWide) {
+		// mov r32, imm32
+		EmitRex(FALSE, 0, nDst);
+		m_rBuffer.Emit8(0xB8 + (nDst & 0x07));
+		m_rBuffer.Emit32((uint32_t)nImm);
+	}
+	else if((int64_t)nImm == (int64_t)(int32_t)nImm) {
+		// mov r64, simm32
+		EmitRex(TRUE, 0, nDst);
+		m_rBuffer.Emit8(0xC7);
+		m_rBuffer.Emit8(0xC0 | (nDst & 0x07));
+		m_rBuffer.Emit32((uint32_t)nImm);
+	}
+	else {
+		// movabs r64, imm64
+		EmitRex(TRUE, 0, nDst);
+		m_rBuffer.Emit8(0xB8 + (nDst & 0x07));
+		m_rBuffer.Emit64(nImm);
+	}
+}
+
+void
+DtcX64Assembler::EmitMove(DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide) {
+
+	if(nDst != nSrc) {
+		EmitRegReg(0x89, nSrc, nDst, bWide);
+	}
+}
+
+void
+DtcX64Assembler::EmitLoadSlot(DtcNativeReg_t nDst, uint32_t nOffset, bool_t bWide) {
+
+	EmitRegSlot(0x8B, nDst, nOffset, bWide);
+}
+
+void
+DtcX64Assembler::EmitStoreSlot(uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide) {
+
+	EmitRegSlot(0x89, nSrc, nOffset, bWide);
+}
+
+void
+DtcX64Assembler::EmitLoadBase(DtcNativeReg_t nDst, DtcNativeReg_t nBase, uint32_t nOffset, bool_t bWide) {
+
+	// mov r32/r64, [base + disp32], where rsp and r12 take the SIB byte. A wide value
+	// is a register pair of the frame, whose low word comes first
+	EmitRex(bWide, nDst, nBase);
+	m_rBuffer.Emit8(0x8B);
+	m_rBuffer.Emit8(0x80 | ((nDst & 0x07) << 3) | (nBase & 0x07));
+
+	if((nBase & 0x07) == 0x04) {
+		m_rBuffer.Emit8(0x24);
+	}
+
+	m_rBuffer.Emit32(nOffset);
+}
+
+void
+DtcX64Assembler::EmitStoreBase(DtcNativeReg_t nBase, uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide) {
+
+	// mov [base + disp32], r32/r64
+	EmitRex(bWide, nSrc, nBase);
+	m_rBuffer.Emit8(0x89);
+	m_rBuffer.Emit8(0x80 | ((nSrc & 0x07) << 3) | (nBase & 0x07));
+
+	if((nBase & 0x07) == 0x04) {
+		m_rBuffer.Emit8(0x24);
+	}
+
+	m_rBuffer.Emit32(nOffset);
+}
+
+void
+DtcX64Assembler::EmitCall(const void *pFunc) {
+
+	// movabs r11, imm64; call r11
+	EmitLoadImm(X64_R11, (uint64_t)(uintptr_t)pFunc, TRUE);
+	m_rBuffer.Emit8(0x41); m_rBuffer.Emit8(0xFF); m_rBuffer.Emit8(0xD3);
+}
+
+DtcError_t
+DtcX64Assembler::EmitAlu(DtcCExprType_t nOp, DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide) {
+
+	switch(nOp) {
+		case DTC_C_EXPR_BINARY_ADD:	EmitRegReg(0x01, nSrc, nDst, bWide); break;
+		case DTC_C_EXPR_BINARY_SUB:	EmitRegReg(0x29, nSrc, nDst, bWide); break;
+		case DTC_C_EXPR_BINARY_AND:	EmitRegReg(0x21, nSrc, nDst, bWide); break;
+		case DTC_C_EXPR_BINARY_OR:	EmitRegReg(0x09, nSrc, nDst, bWide); break;
+		case DTC_C_EXPR_BINARY_XOR:	EmitRegReg(0x31, nSrc, nDst, bWide); break;
+
+		case DTC_C_EXPR_BINARY_MUL: {
+			// imul dst, src
+			EmitRex(bWide, nDst, nSrc);
+			m_rBuffer.Emit8(0x0F);
+			m_rBuffer.Emit8(0xAF);
+			m_rBuffer.Emit8(0xC0 | ((nDst & 0x07) << 3) | (nSrc & 0x07));
+			break;
+		}
+
+		case DTC_C_EXPR_BINARY_SHL:
+		case DTC_C_EXPR_BINARY_SHR:
+		case DTC_C_EXPR_BINARY_USHR: {
+
+			// The shift count must be in cl, which is masked by the hardware
+			// to 5 (or 6) bits as Java requires.
+			if(nDst == X64_RCX) {
+				return DTC_ERROR_NATIVE_UNSUPPORTED;
+			}
+
+			EmitMove(X64_RCX, nSrc, FALSE);
+
+			uint8_t ext = (nOp == DTC_C_EXPR_BINARY_SHL) ? 4 :
+						(nOp == DTC_C_EXPR_BINARY_SHR) ? 7 : 5;
+
+			EmitRex(bWide, 0, nDst);
+			m_rBuffer.Emit8(0xD3);
+			m_rBuffer.Emit8(0xC0 | (ext << 3) | (nDst & 0x07));
+			break;
+		}
+
+		// Division needs the exception path for the zero divisor
+		default:
+			return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	return DTC_SUCCESS;
+}
+
+DtcError_t
+DtcX64Assembler::EmitUnary(DtcCExprType_t nOp, DtcNativeReg_t nDst, bool_t bWide) {
+
+	switch(nOp) {
+		case DTC_C_EXPR_UNARY_NEG: {
+			// neg dst
+			EmitRex(bWide, 0, nDst);
+			m_rBuffer.Emit8(0xF7);
+			m_rBuffer.Emit8(0xD8 | (nDst & 0x07));
+			break;
+		}
+		case DTC_C_EXPR_UNARY_I2J: {
+			// movsxd dst, dst32
+			EmitRegReg(0x63, nDst, nDst, TRUE);
+			break;
+		}
+		case DTC_C_EXPR_UNARY_J2I: {
+			// mov dst32, dst32 (clears the upper half)
+			EmitRegReg(0x89, nDst, nDst, FALSE);
+			break;
+		}
+		default:
+			return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	return DTC_SUCCESS;
+}
+
+DtcError_t
+DtcX64Assembler::EmitCompareBranch(DtcCExprType_t nCond, DtcNativeReg_t nLhs,
+		DtcNativeReg_t nRhs, bool_t bWide, uint32_t nLabel) {
+
+	uint8_t cc;
+
+	switch(nCond) {
+		case DTC_C_EXPR_BINARY_EQ:	cc = 0x04; break;
+		case DTC_C_EXPR_BINARY_NE:	cc = 0x05; break;
+		case DTC_C_EXPR_BINARY_LT:	cc = 0x0C; break;
+		case DTC_C_EXPR_BINARY_GE:	cc = 0x0D; break;
+		case DTC_C_EXPR_BINARY_LE:	cc = 0x0E; break;
+		case DTC_C_EXPR_BINARY_GT:	cc = 0x0F; break;
+		default:
+			return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	// cmp lhs, rhs
+	EmitRegReg(0x39, nRhs, nLhs, bWide);
+
+	// jcc rel32
+	m_rBuffer.Emit8(0x0F);
+	m_rBuffer.Emit8(0x80 | cc);
+
+	DtcNativeFixup_t fixup = { m_rBuffer.GetSize(), nLabel };
+	m_rFixupList.push_back(fixup);
+	m_rBuffer.Emit32(0);
+
+	return DTC_SUCCESS;
+}
+
+void
+DtcX64Assembler::EmitJump(uint32_t nLabel) {
+
+	// jmp rel32
+	m_rBuffer.Emit8(0xE9);
+
+	DtcNativeFixup_t fixup = { m_rBuffer.GetSize(), nLabel };
+	m_rFixupList.push_back(fixup);
+	m_rBuffer.Emit32(0);
+}
+
+void
+DtcX64Assembler::PatchBranch(uint32_t nOffset, uint32_t nTarget) {
+
+	// The displacement is relative to the end of the rel32 field
+	m_rBuffer.Patch32(nOffset, (uint32_t)((int32_t)nTarget - (int32_t)(nOffset + 4)));
+}
+
+///////////////////////////////////////////////////////////////////////
+// DtcArmAssembler Class Definition
+///////////////////////////////////////////////////////////////////////
+
+// ARM register numbers
+#define ARM_R0		0
+#define ARM_R1		1
+#define ARM_R2		2
+#define ARM_R4		4
+#define ARM_R5		5
+#define ARM_R6		6
+#define ARM_R7		7
+#define ARM_R8		8
+#define ARM_R10		10
+#define ARM_R12		12
+
+// ARM condition codes
+#define ARM_COND_EQ	0x0
+#define ARM_COND_NE	0x1
+#define ARM_COND_GE	0xA
+#define ARM_COND_LT	0xB
+#define ARM_COND_GT	0xC
+#define ARM_COND_LE	0xD
+#define ARM_COND_AL	0xE
+
+DtcArmAssembler::DtcArmAssembler() {
+	// Do nothing
+}
+
+DtcArmAssembler::~DtcArmAssembler() {
+	// Do nothing
+}
+
+/**
+ * r9 is left alone since it is the platform register on some of the ABIs.
+ *
+ * @param rRegs the list to be filled with the allocatable registers
+ */
+void
+DtcArmAssembler::GetAllocatableRegs(DtcNativeRegList_t &rRegs) {
+
+	rRegs.clear();
+	rRegs.push_back(ARM_R4);
+	rRegs.push_back(ARM_R5);
+	rRegs.push_back(ARM_R6);
+	rRegs.push_back(ARM_R7);
+	rRegs.push_back(ARM_R8);
+	rRegs.push_back(ARM_R10);
+}
+
+DtcNativeReg_t
+DtcArmAssembler::GetArgReg(uint32_t nIndex) {
+
+	return (DtcNativeReg_t)nIndex;
+}
+
+/**
+ * The scratch registers are the argument registers, so the frame held by the
+ * third one must be moved to the first argument before a helper call.
+ */
+DtcNativeReg_t
+DtcArmAssembler::GetScratchReg(uint32_t nIndex) {
+
+	return (nIndex == 0) ? ARM_R0 : (nIndex == 1) ? ARM_R1 : ARM_R2;
+}
+
+void
+DtcArmAssembler::EmitAdjustStack(uint32_t nSize, bool_t bRelease) {
+
+	// sub/add sp, sp, #imm (imm8 ror 30, i.e. up to 1020 bytes at once)
+	while(nSize > 0) {
+
+		uint32_t chunk = (nSize > 1020) ? 1020 : nSize;
+
+		m_rBuffer.Emit32((bRelease ? 0xE28DDF00 : 0xE24DDF00) | (chunk >> 2));
+
+		nSize -= chunk;
+	}
+}
+
+void
+DtcArmAssembler::EmitPrologue(uint32_t nFrameSize) {
+
+	// Keep the stack 8-byte aligned after pushing 9 registers
+	m_nFrameSize = ((nFrameSize + 7) & ~7) + 4;
+
+	m_rBuffer.Emit32(0xE92D4FF0);		// push {r4-r11, lr}
+	EmitAdjustStack(m_nFrameSize, FALSE);
+}
+
+void
+DtcArmAssembler::EmitEpilogue() {
+
+	EmitAdjustStack(m_nFrameSize, TRUE);
+	m_rBuffer.Emit32(0xE8BD8FF0);		// pop {r4-r11, pc}
+}
+
+void
+DtcArmAssembler::EmitLoadImm(DtcNativeReg_t nDst, uint64_t nImm, bool_t bWide) {
+
+	uint32_t lo = (uint32_t)nImm & 0xFFFF;
+	uint32_t hi = ((uint32_t)nImm >> 16) & 0xFFFF;
+
+	// movw dst, #lo
+	m_rBuffer.Emit32(0xE3000000 | ((lo >> 12) << 16) | (nDst << 12) | (lo & 0xFFF));
+
+	if(hi != 0) {
+		// movt dst, #hi
+		m_rBuffer.Emit32(0xE3400000 | ((hi >> 12) << 16) | (nDst << 12) | (hi & 0xFFF));
+	}
+}
+
+void
+DtcArmAssembler::EmitMove(DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide) {
+
+	if(nDst != nSrc) {
+		m_rBuffer.Emit32(0xE1A00000 | (nDst << 12) | nSrc);
+	}
+}
+
+void
+DtcArmAssembler::EmitLoadSlot(DtcNativeReg_t nDst, uint32_t nOffset, bool_t bWide) {
+
+	// ldr dst, [sp, #offset]
+	m_rBuffer.Emit32(0xE59D0000 | (nDst << 12) | (nOffset & 0xFFF));
+}
+
+void
+DtcArmAssembler::EmitStoreSlot(uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide) {
+
+	// str src, [sp, #offset]
+	m_rBuffer.Emit32(0xE58D0000 | (nSrc << 12) | (nOffset & 0xFFF));
+}
+
+void
+DtcArmAssembler::EmitLoadBase(DtcNativeReg_t nDst, DtcNativeReg_t nBase, uint32_t nOffset, bool_t bWide) {
+
+	// ldr dst, [base, #offset]
+	m_rBuffer.Emit32(0xE5900000 | (nBase << 16) | (nDst << 12) | (nOffset & 0xFFF));
+}
+
+void
+DtcArmAssembler::EmitStoreBase(DtcNativeReg_t nBase, uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide) {
+
+	// str src, [base, #offset]
+	m_rBuffer.Emit32(0xE5800000 | (nBase << 16) | (nSrc << 12) | (nOffset & 0xFFF));
+}
+
+void
+DtcArmAssembler::EmitCall(const void *pFunc) {
+
+	// movw/movt ip, #func; blx ip
+	EmitLoadImm(ARM_R12, (uint32_t)(uintptr_t)pFunc, FALSE);
+	m_rBuffer.Emit32(0xE12FFF3C);
+}
+
+DtcError_t
+DtcArmAssembler::EmitAlu(DtcCExprType_t nOp, DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide) {
+
+	if(bWide) {
+		return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	// op dst, dst, src
+#define ARM_DP_REG(OPCODE)		(0xE0000000 | ((OPCODE) << 21) | (nDst << 16) | (nDst << 12) | nSrc)
+
+	switch(nOp) {
+		case DTC_C_EXPR_BINARY_ADD:	m_rBuffer.Emit32(ARM_DP_REG(0x4)); break;
+		case DTC_C_EXPR_BINARY_SUB:	m_rBuffer.Emit32(ARM_DP_REG(0x2)); break;
+		case DTC_C_EXPR_BINARY_AND:	m_rBuffer.Emit32(ARM_DP_REG(0x0)); break;
+		case DTC_C_EXPR_BINARY_XOR:	m_rBuffer.Emit32(ARM_DP_REG(0x1)); break;
+		case DTC_C_EXPR_BINARY_OR:	m_rBuffer.Emit32(ARM_DP_REG(0xC)); break;
+
+		case DTC_C_EXPR_BINARY_MUL: {
+			// mul dst, dst, src
+			m_rBuffer.Emit32(0xE0000090 | (nDst << 16) | (nSrc << 8) | nDst);
+			break;
+		}
+
+		case DTC_C_EXPR_BINARY_SHL:
+		case DTC_C_EXPR_BINARY_SHR:
+		case DTC_C_EXPR_BINARY_USHR: {
+
+			uint32_t type = (nOp == DTC_C_EXPR_BINARY_SHL) ? 0 :
+						(nOp == DTC_C_EXPR_BINARY_USHR) ? 1 : 2;
+
+			// Register-specified shifts use the whole bottom byte, so mask it as Java does.
+			// and src, src, #31
+			m_rBuffer.Emit32(0xE200001F | (nSrc << 16) | (nSrc << 12));
+
+			// mov dst, dst, <type> src
+			m_rBuffer.Emit32(0xE1A00010 | (nDst << 12) | (nSrc << 8) | (type << 5) | nDst);
+			break;
+		}
+
+		default:
+			return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+#undef ARM_DP_REG
+
+	return DTC_SUCCESS;
+}
+
+DtcError_t
+DtcArmAssembler::EmitUnary(DtcCExprType_t nOp, DtcNativeReg_t nDst, bool_t bWide) {
+
+	if(bWide || nOp != DTC_C_EXPR_UNARY_NEG) {
+		return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	// rsb dst, dst, #0
+	m_rBuffer.Emit32(0xE2600000 | (nDst << 16) | (nDst << 12));
+
+	return DTC_SUCCESS;
+}
+
+DtcError_t
+DtcArmAssembler::EmitCompareBranch(DtcCExprType_t nCond, DtcNativeReg_t nLhs,
+		DtcNativeReg_t nRhs, bool_t bWide, uint32_t nLabel) {
+
+	uint32_t cond;
+
+	if(bWide) {
+		return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	switch(nCond) {
+		case DTC_C_EXPR_BINARY_EQ:	cond = ARM_COND_EQ; break;
+		case DTC_C_EXPR_BINARY_NE:	cond = ARM_COND_NE; break;
+		case DTC_C_EXPR_BINARY_LT:	cond = ARM_COND_LT; break;
+		case DTC_C_EXPR_BINARY_GE:	cond = ARM_COND_GE; break;
+		case DTC_C_EXPR_BINARY_LE:	cond = ARM_COND_LE; break;
+		case DTC_C_EXPR_BINARY_GT:	cond = ARM_COND_GT; break;
+		default:
+			return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	// cmp lhs, rhs
+	m_rBuffer.Emit32(0xE1500000 | (nLhs << 16) | nRhs);
+
+	// b<cond> label
+	DtcNativeFixup_t fixup = { m_rBuffer.GetSize(), nLabel };
+	m_rFixupList.push_back(fixup);
+	m_rBuffer.Emit32((cond << 28) | 0x0A000000);
+
+	return DTC_SUCCESS;
+}
+
+void
+DtcArmAssembler::EmitJump(uint32_t nLabel) {
+
+	// b label
+	DtcNativeFixup_t fixup = { m_rBuffer.GetSize(), nLabel };
+	m_rFixupList.push_back(fixup);
+	m_rBuffer.Emit32((ARM_COND_AL << 28) | 0x0A000000);
+}
+
+void
+DtcArmAssembler::PatchBranch(uint32_t nOffset, uint32_t nTarget) {
+
+	// The displacement is relative to the branch address plus 8 in words
+	int32_t disp = ((int32_t)nTarget - (int32_t)(nOffset + 8)) >> 2;
+
+	uint32_t insn = m_rBuffer.Read32(nOffset);
+
+	m_rBuffer.Patch32(nOffset, (insn & 0xFF000000) | ((uint32_t)disp & 0x00FFFFFF));
+}
@@ -0,0 +1,351 @@
+/*********************************************************************
+*   DtcNativeAssembler.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_NATIVE_ASSEMBLER_H_
+#define _DTC_NATIVE_ASSEMBLER_H_
+
+#include "DtcCommon.h"
+#include "DtcCExpression.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// Physical register number of the target machine
+typedef uint8_t DtcNativeReg_t;
+
+typedef vector<DtcNativeReg_t> DtcNativeRegList_t;
+
+// Branch fixup to be patched when the target label is bound
+typedef struct {
+
+	// The offset of the instruction to be patched
+	uint32_t nOffset;
+
+	// The dex address of the target label
+	uint32_t nLabel;
+
+} DtcNativeFixup_t;
+
+typedef vector<DtcNativeFixup_t> DtcNativeFixupList_t;
+
+typedef map<uint32_t, uint32_t> DtcNativeLabelTable_t;
+
+///////////////////////////////////////////////////////////////////////
+// DtcNativeBuffer Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+class DtcNativeBuffer {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The machine code being assembled
+	vector<uint8_t> m_rCode;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcNativeBuffer();
+
+	virtual ~DtcNativeBuffer();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the current size of the machine code.
+	 *
+	 * @return the size of the machine code in bytes
+	 */
+	inline uint32_t GetSize()			{ return (uint32_t)m_rCode.size();	}
+
+	/**
+	 * This function will be used to append a byte to the machine code.
+	 *
+	 * @param nByte a byte to be appended
+	 */
+	inline void Emit8(uint8_t nByte)		{ m_rCode.push_back(nByte);		}
+
+	void Emit32(uint32_t nWord);
+
+	void Emit64(uint64_t nDword);
+
+	void Patch32(uint32_t nOffset, uint32_t nWord);
+
+	uint32_t Read32(uint32_t nOffset);
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	void *Install();
+};
+
+///////////////////////////////////////////////////////////////////////
+// DtcNativeAssembler Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+class DtcNativeAssembler {
+
+protected:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The machine code buffer
+	DtcNativeBuffer m_rBuffer;
+
+	// The offsets of the bound labels
+	DtcNativeLabelTable_t m_rLabelTable;
+
+	// The branches to be patched
+	DtcNativeFixupList_t m_rFixupList;
+
+	// The size of the spill area in the stack frame
+	uint32_t m_nFrameSize;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcNativeAssembler();
+
+	virtual ~DtcNativeAssembler();
+
+	static DtcNativeAssembler *Create();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the machine code buffer.
+	 *
+	 * @return the machine code buffer
+	 */
+	inline DtcNativeBuffer &GetBuffer()		{ return m_rBuffer;		}
+
+	/**
+	 * This function will be used to bind the given label to the current position.
+	 *
+	 * @param nLabel the dex address of the label, or a label of the emitted code beyond them
+	 */
+	inline void BindLabel(uint32_t nLabel)	{
+		m_rLabelTable[nLabel] = m_rBuffer.GetSize();
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// Target Description Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual bool_t GetIs64Bit() = 0;
+
+	virtual void GetAllocatableRegs(DtcNativeRegList_t &rRegs) = 0;
+
+	virtual uint32_t GetNumArgRegs() = 0;
+
+	virtual DtcNativeReg_t GetArgReg(uint32_t nIndex) = 0;
+
+	virtual DtcNativeReg_t GetScratchReg(uint32_t nIndex) = 0;
+
+	///////////////////////////////////////////////////////////////////
+	// Instruction Emission Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual void EmitPrologue(uint32_t nFrameSize) = 0;
+
+	virtual void EmitEpilogue() = 0;
+
+	virtual void EmitLoadImm(DtcNativeReg_t nDst, uint64_t nImm, bool_t bWide) = 0;
+
+	virtual void EmitMove(DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide) = 0;
+
+	virtual void EmitLoadSlot(DtcNativeReg_t nDst, uint32_t nOffset, bool_t bWide) = 0;
+
+	virtual void EmitStoreSlot(uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide) = 0;
+
+	virtual void EmitLoadBase(DtcNativeReg_t nDst, DtcNativeReg_t nBase, uint32_t nOffset, bool_t bWide) = 0;
+
+	virtual void EmitStoreBase(DtcNativeReg_t nBase, uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide) = 0;
+
+	virtual void EmitCall(const void *pFunc) = 0;
+
+	virtual DtcError_t EmitAlu(DtcCExprType_t nOp, DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide) = 0;
+
+	virtual DtcError_t EmitUnary(DtcCExprType_t nOp, DtcNativeReg_t nDst, bool_t bWide) = 0;
+
+	virtual DtcError_t EmitCompareBranch(DtcCExprType_t nCond, DtcNativeReg_t nLhs,
+				DtcNativeReg_t nRhs, bool_t bWide, uint32_t nLabel) = 0;
+
+	virtual void EmitJump(uint32_t nLabel) = 0;
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcError_t Finalize();
+
+protected:
+
+	virtual void PatchBranch(uint32_t nOffset, uint32_t nTarget) = 0;
+};
+
+///////////////////////////////////////////////////////////////////////
+// DtcX64Assembler Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+class DtcX64Assembler : public DtcNativeAssembler {
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcX64Assembler();
+
+	virtual ~DtcX64Assembler();
+
+	///////////////////////////////////////////////////////////////////
+	// Target Description Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual bool_t GetIs64Bit()				{ return TRUE;	}
+
+	virtual void GetAllocatableRegs(DtcNativeRegList_t &rRegs);
+
+	virtual uint32_t GetNumArgRegs()			{ return 6;		}
+
+	virtual DtcNativeReg_t GetArgReg(uint32_t nIndex);
+
+	virtual DtcNativeReg_t GetScratchReg(uint32_t nIndex);
+
+	///////////////////////////////////////////////////////////////////
+	// Instruction Emission Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual void EmitPrologue(uint32_t nFrameSize);
+
+	virtual void EmitEpilogue();
+
+	virtual void EmitLoadImm(DtcNativeReg_t nDst, uint64_t nImm, bool_t bWide);
+
+	virtual void EmitMove(DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide);
+
+	virtual void EmitLoadSlot(DtcNativeReg_t nDst, uint32_t nOffset, bool_t bWide);
+
+	virtual void EmitStoreSlot(uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide);
+
+	virtual void EmitLoadBase(DtcNativeReg_t nDst, DtcNativeReg_t nBase, uint32_t nOffset, bool_t bWide);
+
+	virtual void EmitStoreBase(DtcNativeReg_t nBase, uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide);
+
+	virtual void EmitCall(const void *pFunc);
+
+	virtual DtcError_t EmitAlu(DtcCExprType_t nOp, DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide);
+
+	virtual DtcError_t EmitUnary(DtcCExprType_t nOp, DtcNativeReg_t nDst, bool_t bWide);
+
+	virtual DtcError_t EmitCompareBranch(DtcCExprType_t nCond, DtcNativeReg_t nLhs,
+				DtcNativeReg_t nRhs, bool_t bWide, uint32_t nLabel);
+
+	virtual void EmitJump(uint32_t nLabel);
+
+protected:
+
+	virtual void PatchBranch(uint32_t nOffset, uint32_t nTarget);
+
+private:
+
+	void EmitRex(bool_t bWide, DtcNativeReg_t nReg, DtcNativeReg_t nRm, bool_t bForce = FALSE);
+
+	void EmitRegReg(uint8_t nOpcode, DtcNativeReg_t nReg, DtcNativeReg_t nRm, bool_t bWide);
+
+	void EmitRegSlot(uint8_t nOpcode, DtcNativeReg_t nReg, uint32_t nOffset, bool_t bWide);
+};
+
+///////////////////////////////////////////////////////////////////////
+// DtcArmAssembler Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+class DtcArmAssembler : public DtcNativeAssembler {
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcArmAssembler();
+
+	virtual ~DtcArmAssembler();
+
+	///////////////////////////////////////////////////////////////////
+	// Target Description Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual bool_t GetIs64Bit()				{ return FALSE;	}
+
+	virtual void GetAllocatableRegs(DtcNativeRegList_t &rRegs);
+
+	virtual uint32_t GetNumArgRegs()			{ return 4;		}
+
+	virtual DtcNativeReg_t GetArgReg(uint32_t nIndex);
+
+	virtual DtcNativeReg_t GetScratchReg(uint32_t nIndex);
+
+	///////////////////////////////////////////////////////////////////
+	// Instruction Emission Declaration
+	///////////////////////////////////////////////////////////////////
+
+	virtual void EmitPrologue(uint32_t nFrameSize);
+
+	virtual void EmitEpilogue();
+
+	virtual void EmitLoadImm(DtcNativeReg_t nDst, uint64_t nImm, bool_t bWide);
+
+	virtual void EmitMove(DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide);
+
+	virtual void EmitLoadSlot(DtcNativeReg_t nDst, uint32_t nOffset, bool_t bWide);
+
+	virtual void EmitStoreSlot(uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide);
+
+	virtual void EmitLoadBase(DtcNativeReg_t nDst, DtcNativeReg_t nBase, uint32_t nOffset, bool_t bWide);
+
+	virtual void EmitStoreBase(DtcNativeReg_t nBase, uint32_t nOffset, DtcNativeReg_t nSrc, bool_t bWide);
+
+	virtual void EmitCall(const void *pFunc);
+
+	virtual DtcError_t EmitAlu(DtcCExprType_t nOp, DtcNativeReg_t nDst, DtcNativeReg_t nSrc, bool_t bWide);
+
+	virtual DtcError_t EmitUnary(DtcCExprType_t nOp, DtcNativeReg_t nDst, bool_t bWide);
+
+	virtual DtcError_t EmitCompareBranch(DtcCExprType_t nCond, DtcNativeReg_t nLhs,
+				DtcNativeReg_t nRhs, bool_t bWide, uint32_t nLabel);
+
+	virtual void EmitJump(uint32_t nLabel);
+
+protected:
+
+	virtual void PatchBranch(uint32_t nOffset, uint32_t nTarget);
+
+private:
+
+	void EmitAdjustStack(uint32_t nSize, bool_t bRelease);
+};
+
+#endif
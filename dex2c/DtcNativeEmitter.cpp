@@ -0,0 +1,1154 @@
+/*********************************************************************
+*   DtcNativeEmitter.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <algorithm>
+
+#include "DtcNativeEmitter.h"
+#include "DtcRuntime.h"
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will return the variable symbol of the given expression.
+ *
+ * @param pExpr an expression
+ * @return the variable symbol (NULL if the expression is not a variable)
+ */
+static DtcCVarSymbol *
+GetVarSymbol(DtcCExpression *pExpr) {
+
+	if(pExpr == NULL || pExpr->GetType() != DTC_C_EXPR_ID) {
+		return NULL;
+	}
+
+	DtcCSymbol *sym = ((DtcCIdExpr *)pExpr)->GetSymbol();
+
+	if(sym == NULL || sym->GetType() != DTC_C_SYM_VAR) {
+		return NULL;
+	}
+
+	return (DtcCVarSymbol *)sym;
+}
+
+/**
+ * This function will return the key of the C variable, which is named after
+ * both the register number and the data type of its live web.
+ *
+ * @param pSym a variable symbol
+ * @return the key of the variable
+ */
+static uint32_t
+GetVarKey(DtcCVarSymbol *pSym) {
+
+	DtcDexLiveWeb *web = pSym->GetWeb();
+
+	return ((uint32_t)web->GetRegnum() << 8) | (uint32_t)web->GetDataType();
+}
+
+static bool
+CompareIntervalStart(DtcNativeInterval_t *pLhs, DtcNativeInterval_t *pRhs) {
+
+	return pLhs->nStart < pRhs->nStart;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Constructor & Destructor Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * Constructor of DtcNativeEmitter class
+ *
+ * @param pCMethod the translated C method to be emitted into machine code
+ */
+DtcNativeEmitter::DtcNativeEmitter(DtcCMethod *pCMethod) {
+
+	if(pCMethod == NULL) {
+		DTC_ERROR(DEX2C_TAG, "DtcNativeEmitter - Null C method");
+	}
+
+	m_pCMethod = pCMethod;
+
+	m_pAssembler = DtcNativeAssembler::Create();
+
+	m_pEntry = NULL;
+
+	m_nFrameSlot = 0;
+	m_nNextLabel = DTC_NATIVE_LABEL_BASE;
+
+	m_rIntervalTable.clear();
+}
+
+DtcNativeEmitter::~DtcNativeEmitter() {
+
+	delete m_pAssembler;
+
+	m_rIntervalTable.clear();
+}
+
+///////////////////////////////////////////////////////////////////////
+// Member Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will emit the machine code of the C method directly into an
+ * executable buffer without going through the textual C code. Any construct
+ * that cannot be lowered is reported as DTC_ERROR_NATIVE_UNSUPPORTED so that
+ * the caller can fall back to the C backend.
+ *
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::Emit() {
+
+	DTC_DEBUG(DEX2C_TAG, "DtcNativeEmitter->Emit Invoked...");
+
+	DtcError_t error;
+
+	DTC_CHECK(m_pCMethod != NULL, INVALID_PARAMETER);
+	DTC_CHECK(m_pAssembler != NULL, NATIVE_UNSUPPORTED);
+
+	DtcDexMethod *dexMethod = m_pCMethod->GetDexMethod();
+
+	uint32_t regsSize = dexMethod->GetRegistersSize();
+	uint32_t insSize = dexMethod->GetInsSize();
+
+	// The slots and the registers of the frame must be addressable with the short
+	// displacement of every target, where the last slot keeps the frame itself
+	DTC_CHECK(GetSlotOffset(regsSize + 1) < 4096, NATIVE_UNSUPPORTED);
+	DTC_CHECK(regsSize * sizeof(u4) < 4096, NATIVE_UNSUPPORTED);
+
+	// The argument words must all come in the argument registers of every target
+	DTC_CHECK(insSize <= DTC_NATIVE_ARG_REGS, NATIVE_UNSUPPORTED);
+
+	m_nFrameSlot = GetSlotOffset(regsSize);
+	m_nNextLabel = DTC_NATIVE_EPILOGUE + 1;
+
+	if((error = BuildIntervals()) != DTC_SUCCESS) {
+		return error;
+	}
+
+	if((error = AllocateRegisters()) != DTC_SUCCESS) {
+		return error;
+	}
+
+	/////////////////////////////////////////////////////////////////
+	// Prologue
+	/////////////////////////////////////////////////////////////////
+
+	m_pAssembler->EmitPrologue(GetSlotOffset(regsSize + 1));
+
+	// The code takes the argument words in the argument registers like the C function
+	// of the C backend, so that it is entered through the same shared entry stubs and
+	// called directly by the compiled callers, and the words are the last registers
+	for(uint32_t i = 0; i < insSize; i++) {
+
+		m_pAssembler->EmitStoreSlot(GetSlotOffset(regsSize - insSize + i),
+			m_pAssembler->GetArgReg(i), FALSE);
+	}
+
+	// The frame is kept for the helper calls and the deoptimization, which is set up by
+	// the interpreter or by dtc_push_frame of the compiled caller
+	m_pAssembler->EmitCall((const void *)dtc_frame);
+	m_pAssembler->EmitStoreSlot(m_nFrameSlot, m_pAssembler->GetScratchReg(0),
+		m_pAssembler->GetIs64Bit());
+
+	// Load the live-in variables having a physical register, whose intervals start
+	// at the entry so that nothing else takes the register before the first use
+	DtcNativeIntervalTable_t::iterator itiIter;
+
+	for(itiIter = m_rIntervalTable.begin(); itiIter != m_rIntervalTable.end(); itiIter++) {
+
+		DtcNativeInterval_t &interval = itiIter->second;
+
+		if(interval.bLiveIn && interval.nPhysReg != DTC_NATIVE_SPILLED) {
+
+			m_pAssembler->EmitLoadSlot((DtcNativeReg_t)interval.nPhysReg,
+				GetSlotOffset(interval.nRegnum), FALSE);
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////
+	// Body
+	/////////////////////////////////////////////////////////////////
+
+	DtcCBasicBlockList_t::iterator bbIter;
+	DtcCBasicBlockList_t &blocks = m_pCMethod->GetBasicBlocks();
+
+	for(bbIter = blocks.begin(); bbIter != blocks.end(); bbIter++) {
+
+		DtcCBasicBlock *block = *bbIter;
+
+		m_pAssembler->BindLabel(block->GetDexBasicBlock()->GetStartAddress());
+
+		DtcCStmtList_t::iterator stIter;
+		DtcCStmtList_t &stmts = block->GetStmtList();
+
+		for(stIter = stmts.begin(); stIter != stmts.end(); stIter++) {
+
+			if((error = EmitStatement(*stIter)) != DTC_SUCCESS) {
+				return error;
+			}
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////
+	// Epilogue
+	/////////////////////////////////////////////////////////////////
+
+	// The returns and the deoptimizations jump here with the return value
+	m_pAssembler->EmitLoadImm(m_pAssembler->GetScratchReg(0), 0, m_pAssembler->GetIs64Bit());
+
+	if(!m_pAssembler->GetIs64Bit()) {
+		m_pAssembler->EmitLoadImm(m_pAssembler->GetScratchReg(1), 0, FALSE);
+	}
+
+	m_pAssembler->BindLabel(DTC_NATIVE_EPILOGUE);
+	m_pAssembler->EmitEpilogue();
+
+	if((error = m_pAssembler->Finalize()) != DTC_SUCCESS) {
+		return error;
+	}
+
+	m_pEntry = m_pAssembler->GetBuffer().Install();
+
+	DTC_CHECK(m_pEntry != NULL, NATIVE_CODE_GEN);
+
+	DTC_DEBUG(DEX2C_TAG, "DtcNativeEmitter - %d bytes emitted at %p",
+		m_pAssembler->GetBuffer().GetSize(), m_pEntry);
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will compute the live interval of each C variable over the
+ * statements in the block order. The interval of a variable overlapping a loop
+ * is extended to the whole loop, so that the value survives the back edge.
+ *
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::BuildIntervals() {
+
+	DtcError_t error;
+
+	// The positions of the first statements of the blocks
+	map<uint32_t, uint32_t> blockPosTable;
+
+	// The positions of the backward branches and their targets
+	vector< pair<uint32_t, uint32_t> > loopList;
+
+	// The branches to be resolved after all the blocks are numbered
+	vector< pair<uint32_t, uint32_t> > branchList;
+
+	m_rIntervalTable.clear();
+
+	uint32_t pos = 0;
+
+	DtcCBasicBlockList_t::iterator bbIter;
+	DtcCBasicBlockList_t &blocks = m_pCMethod->GetBasicBlocks();
+
+	for(bbIter = blocks.begin(); bbIter != blocks.end(); bbIter++) {
+
+		DtcCBasicBlock *block = *bbIter;
+
+		blockPosTable[block->GetDexBasicBlock()->GetStartAddress()] = pos;
+
+		DtcCStmtList_t::iterator stIter;
+		DtcCStmtList_t &stmts = block->GetStmtList();
+
+		for(stIter = stmts.begin(); stIter != stmts.end(); stIter++, pos++) {
+
+			DtcCStatement *stmt = *stIter;
+
+			DtcCExpression *uses[2] = { NULL, NULL };
+			DtcCExpression *rhs = NULL;
+
+			// The variables passing through the frame of the interpreter
+			vector<DtcCVarSymbol *> useSyms;
+			vector<DtcCVarSymbol *> defSyms;
+
+			switch(stmt->GetType()) {
+
+				case DTC_C_STMT_ASSIGN: {
+
+					defSyms.push_back(GetVarSymbol(((DtcCAssignStmt *)stmt)->GetIdExpr()));
+					rhs = ((DtcCAssignStmt *)stmt)->GetRhsExpr();
+					break;
+				}
+
+				case DTC_C_STMT_BRANCH: {
+
+					DtcCIdExpr *target = ((DtcCBranchStmt *)stmt)->GetTargetExpr();
+					DtcCLabelSymbol *label = (DtcCLabelSymbol *)target->GetSymbol();
+
+					branchList.push_back(make_pair(pos, label->GetLabelValue()));
+
+					rhs = ((DtcCBranchStmt *)stmt)->GetCondExpr();
+					break;
+				}
+
+				case DTC_C_STMT_RETURN: {
+
+					rhs = ((DtcCReturnStmt *)stmt)->GetValueExpr();
+					break;
+				}
+
+				case DTC_C_STMT_HELPER: {
+
+					DtcCHelperStmt *helper = (DtcCHelperStmt *)stmt;
+
+					useSyms.insert(useSyms.end(), helper->GetUseList().begin(), helper->GetUseList().end());
+					useSyms.insert(useSyms.end(), helper->GetSpillList().begin(), helper->GetSpillList().end());
+					useSyms.insert(useSyms.end(), helper->GetStoreList().begin(), helper->GetStoreList().end());
+
+					defSyms.insert(defSyms.end(), helper->GetLoadList().begin(), helper->GetLoadList().end());
+					defSyms.push_back(helper->GetResultSym());
+					break;
+				}
+
+				case DTC_C_STMT_DEOPT: {
+
+					DtcCDeoptStmt *deopt = (DtcCDeoptStmt *)stmt;
+
+					useSyms.insert(useSyms.end(), deopt->GetStoreList().begin(), deopt->GetStoreList().end());
+
+					rhs = deopt->GetCondExpr();
+					break;
+				}
+
+				default:
+					return DTC_ERROR_NATIVE_UNSUPPORTED;
+			}
+
+			// Only the flat expressions of the C IR are supported
+			if(rhs != NULL) {
+
+				if(rhs->GetType() == DTC_C_EXPR_ID) {
+					uses[0] = rhs;
+				}
+				else if(rhs->GetType() >= DTC_C_EXPR_UNARY_NEG && rhs->GetType() <= DTC_C_EXPR_UNARY_D2F) {
+					uses[0] = ((DtcCUnaryExpr *)rhs)->GetExpr();
+				}
+				else if(rhs->GetType() >= DTC_C_EXPR_BINARY_ADD && rhs->GetType() <= DTC_C_EXPR_BINARY_GT) {
+					uses[0] = ((DtcCBinaryExpr *)rhs)->GetLhsExpr();
+					uses[1] = ((DtcCBinaryExpr *)rhs)->GetRhsExpr();
+				}
+				else {
+					return DTC_ERROR_NATIVE_UNSUPPORTED;
+				}
+			}
+
+			for(uint32_t i = 0; i < 2; i++) {
+
+				if(uses[i] == NULL) continue;
+
+				if(uses[i]->GetType() != DTC_C_EXPR_ID) {
+					return DTC_ERROR_NATIVE_UNSUPPORTED;
+				}
+
+				useSyms.push_back(GetVarSymbol(uses[i]));
+			}
+
+			// The uses come first, so that a variable used before any definition is live-in
+			for(uint32_t i = 0; i < useSyms.size(); i++) {
+
+				if((error = AddInterval(useSyms[i], pos, FALSE)) != DTC_SUCCESS) {
+					return error;
+				}
+			}
+
+			for(uint32_t i = 0; i < defSyms.size(); i++) {
+
+				if((error = AddInterval(defSyms[i], pos, TRUE)) != DTC_SUCCESS) {
+					return error;
+				}
+			}
+		}
+	}
+
+	// Find the loops from the backward branches
+	for(uint32_t i = 0; i < branchList.size(); i++) {
+
+		if(blockPosTable.count(branchList[i].second) == 0) {
+			DTC_ERROR(DEX2C_TAG, "BuildIntervals - Invalid branch target: %X", branchList[i].second);
+			return DTC_ERROR_NATIVE_CODE_GEN;
+		}
+
+		uint32_t targetPos = blockPosTable[branchList[i].second];
+
+		if(targetPos <= branchList[i].first) {
+			loopList.push_back(make_pair(targetPos, branchList[i].first));
+		}
+	}
+
+	// Extend the intervals overlapping the loops until nothing changes for nested loops
+	bool_t changed = TRUE;
+
+	while(changed) {
+
+		changed = FALSE;
+
+		DtcNativeIntervalTable_t::iterator iter;
+
+		for(iter = m_rIntervalTable.begin(); iter != m_rIntervalTable.end(); iter++) {
+
+			DtcNativeInterval_t &interval = iter->second;
+
+			for(uint32_t i = 0; i < loopList.size(); i++) {
+
+				uint32_t head = loopList[i].first;
+				uint32_t tail = loopList[i].second;
+
+				if(interval.nStart > tail || interval.nEnd < head) continue;
+
+				if(interval.nStart > head) { interval.nStart = head; changed = TRUE; }
+				if(interval.nEnd < tail) { interval.nEnd = tail; changed = TRUE; }
+			}
+		}
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will extend the live interval of a variable to the given position.
+ * A variable used before any definition is live-in and loaded at the entry, so its
+ * interval starts at the entry rather than at the first use.
+ *
+ * @param pSym a variable symbol (ignored if NULL)
+ * @param nPos the position of the statement
+ * @param bDef whether the statement defines the variable
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::AddInterval(DtcCVarSymbol *pSym, uint32_t nPos, bool_t bDef) {
+
+	if(pSym == NULL) {
+		return DTC_SUCCESS;
+	}
+
+	DtcError_t error;
+	bool_t wide;
+
+	if((error = GetIsWideType(pSym->GetWeb()->GetDataType(), wide)) != DTC_SUCCESS) {
+		return error;
+	}
+
+	uint32_t key = GetVarKey(pSym);
+
+	if(m_rIntervalTable.count(key) == 0) {
+
+		// The 64-bit live-in values are split into two slots
+		if(!bDef && wide) {
+			return DTC_ERROR_NATIVE_UNSUPPORTED;
+		}
+
+		DtcNativeInterval_t interval = {
+			pSym->GetWeb()->GetRegnum(), pSym->GetWeb()->GetDataType(),
+			bDef ? nPos : 0, nPos, !bDef, DTC_NATIVE_SPILLED
+		};
+
+		m_rIntervalTable[key] = interval;
+	}
+
+	m_rIntervalTable[key].nEnd = nPos;
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will assign the physical registers to the live intervals
+ * using the linear scan algorithm. The interval ending last is spilled to its
+ * slot whenever the registers run out.
+ *
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::AllocateRegisters() {
+
+	DtcNativeRegList_t freeRegs;
+	DtcNativeIntervalList_t intervals;
+	DtcNativeIntervalList_t active;
+
+	m_pAssembler->GetAllocatableRegs(freeRegs);
+
+	DtcNativeIntervalTable_t::iterator iter;
+
+	for(iter = m_rIntervalTable.begin(); iter != m_rIntervalTable.end(); iter++) {
+		intervals.push_back(&iter->second);
+	}
+
+	sort(intervals.begin(), intervals.end(), CompareIntervalStart);
+
+	for(uint32_t i = 0; i < intervals.size(); i++) {
+
+		DtcNativeInterval_t *current = intervals[i];
+
+		// Expire the old intervals
+		for(uint32_t j = 0; j < active.size(); ) {
+
+			if(active[j]->nEnd < current->nStart) {
+				freeRegs.push_back((DtcNativeReg_t)active[j]->nPhysReg);
+				active.erase(active.begin() + j);
+			}
+			else j++;
+		}
+
+		if(!freeRegs.empty()) {
+
+			current->nPhysReg = freeRegs.back();
+			freeRegs.pop_back();
+			active.push_back(current);
+			continue;
+		}
+
+		// Spill the interval ending last
+		uint32_t victim = 0;
+
+		for(uint32_t j = 1; j < active.size(); j++) {
+			if(active[j]->nEnd > active[victim]->nEnd) victim = j;
+		}
+
+		if(!active.empty() && active[victim]->nEnd > current->nEnd) {
+
+			current->nPhysReg = active[victim]->nPhysReg;
+			active[victim]->nPhysReg = DTC_NATIVE_SPILLED;
+			active[victim] = current;
+		}
+		else {
+			current->nPhysReg = DTC_NATIVE_SPILLED;
+		}
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will emit the machine code of a C statement.
+ *
+ * @param pStmt a C statement
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::EmitStatement(DtcCStatement *pStmt) {
+
+	DtcError_t error;
+
+	DtcNativeReg_t t0 = m_pAssembler->GetScratchReg(0);
+	DtcNativeReg_t t1 = m_pAssembler->GetScratchReg(1);
+
+	switch(pStmt->GetType()) {
+
+		case DTC_C_STMT_ASSIGN: {
+
+			DtcCAssignStmt *stmt = (DtcCAssignStmt *)pStmt;
+			DtcCExpression *rhs = stmt->GetRhsExpr();
+			DtcCExprType_t op = rhs->GetType();
+
+			bool_t wide;
+
+			if((error = GetIsWide(stmt->GetIdExpr(), wide)) != DTC_SUCCESS) {
+				return error;
+			}
+
+			if(op == DTC_C_EXPR_ID) {
+
+				error = LoadOperand(t0, rhs, wide);
+			}
+			else if(op == DTC_C_EXPR_UNARY_I2J || op == DTC_C_EXPR_UNARY_J2I) {
+
+				DTC_CHECK(m_pAssembler->GetIs64Bit(), NATIVE_UNSUPPORTED);
+
+				error = LoadOperand(t0, ((DtcCUnaryExpr *)rhs)->GetExpr(), op == DTC_C_EXPR_UNARY_J2I);
+
+				if(error == DTC_SUCCESS) {
+					error = m_pAssembler->EmitUnary(op, t0, wide);
+				}
+			}
+			else if(op >= DTC_C_EXPR_UNARY_NEG && op <= DTC_C_EXPR_UNARY_D2F) {
+
+				error = LoadOperand(t0, ((DtcCUnaryExpr *)rhs)->GetExpr(), wide);
+
+				if(error == DTC_SUCCESS) {
+					error = m_pAssembler->EmitUnary(op, t0, wide);
+				}
+			}
+			else if(op >= DTC_C_EXPR_BINARY_ADD && op <= DTC_C_EXPR_BINARY_USHR) {
+
+				bool_t shift = (op == DTC_C_EXPR_BINARY_SHL || op == DTC_C_EXPR_BINARY_SHR ||
+					op == DTC_C_EXPR_BINARY_USHR);
+
+				error = LoadOperand(t0, ((DtcCBinaryExpr *)rhs)->GetLhsExpr(), wide);
+
+				if(error == DTC_SUCCESS) {
+					// The shift distance is always an int
+					error = LoadOperand(t1, ((DtcCBinaryExpr *)rhs)->GetRhsExpr(), shift ? FALSE : wide);
+				}
+
+				if(error == DTC_SUCCESS) {
+					error = m_pAssembler->EmitAlu(op, t0, t1, wide);
+				}
+			}
+			else {
+				error = DTC_ERROR_NATIVE_UNSUPPORTED;
+			}
+
+			if(error != DTC_SUCCESS) {
+				return error;
+			}
+
+			return StoreVariable(stmt->GetIdExpr(), t0);
+		}
+
+		case DTC_C_STMT_BRANCH: {
+
+			DtcCBranchStmt *stmt = (DtcCBranchStmt *)pStmt;
+			DtcCExpression *cond = stmt->GetCondExpr();
+			uint32_t label = ((DtcCLabelSymbol *)stmt->GetTargetExpr()->GetSymbol())->GetLabelValue();
+
+			if(cond == NULL) {
+				m_pAssembler->EmitJump(label);
+				return DTC_SUCCESS;
+			}
+
+			return EmitCondBranch(cond, FALSE, label);
+		}
+
+		case DTC_C_STMT_RETURN:
+			return EmitReturn((DtcCReturnStmt *)pStmt);
+
+		case DTC_C_STMT_HELPER:
+			return EmitHelper((DtcCHelperStmt *)pStmt);
+
+		case DTC_C_STMT_DEOPT: {
+
+			DtcCDeoptStmt *stmt = (DtcCDeoptStmt *)pStmt;
+
+			if(stmt->GetCondExpr() == NULL) {
+				return EmitDeopt(stmt);
+			}
+
+			// The guard branches over the deoptimization, which is expected not to happen
+			uint32_t skip = NewLabel();
+
+			if((error = EmitCondBranch(stmt->GetCondExpr(), TRUE, skip)) != DTC_SUCCESS) {
+				return error;
+			}
+
+			if((error = EmitDeopt(stmt)) != DTC_SUCCESS) {
+				return error;
+			}
+
+			m_pAssembler->BindLabel(skip);
+			return DTC_SUCCESS;
+		}
+
+		default:
+			break;
+	}
+
+	return DTC_ERROR_NATIVE_UNSUPPORTED;
+}
+
+/**
+ * This function will emit the branch taken by the result of a comparison.
+ *
+ * @param pCond a binary comparison expression
+ * @param bNegate whether the branch is taken when the comparison fails
+ * @param nLabel the target label
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::EmitCondBranch(DtcCExpression *pCond, bool_t bNegate, uint32_t nLabel) {
+
+	DtcError_t error;
+
+	DtcNativeReg_t t0 = m_pAssembler->GetScratchReg(0);
+	DtcNativeReg_t t1 = m_pAssembler->GetScratchReg(1);
+
+	DtcCExprType_t op = pCond->GetType();
+
+	if(op < DTC_C_EXPR_BINARY_EQ || op > DTC_C_EXPR_BINARY_GT) {
+		return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	if(bNegate) {
+		switch(op) {
+			case DTC_C_EXPR_BINARY_EQ:	op = DTC_C_EXPR_BINARY_NE; break;
+			case DTC_C_EXPR_BINARY_NE:	op = DTC_C_EXPR_BINARY_EQ; break;
+			case DTC_C_EXPR_BINARY_LE:	op = DTC_C_EXPR_BINARY_GT; break;
+			case DTC_C_EXPR_BINARY_LT:	op = DTC_C_EXPR_BINARY_GE; break;
+			case DTC_C_EXPR_BINARY_GE:	op = DTC_C_EXPR_BINARY_LT; break;
+			default:					op = DTC_C_EXPR_BINARY_LE; break;
+		}
+	}
+
+	DtcCExpression *lhs = ((DtcCBinaryExpr *)pCond)->GetLhsExpr();
+	DtcCExpression *rhs = ((DtcCBinaryExpr *)pCond)->GetRhsExpr();
+
+	bool_t wide;
+
+	if((error = GetIsWide(lhs, wide)) != DTC_SUCCESS) {
+		return error;
+	}
+
+	if((error = LoadOperand(t0, lhs, wide)) != DTC_SUCCESS) {
+		return error;
+	}
+
+	if((error = LoadOperand(t1, rhs, wide)) != DTC_SUCCESS) {
+		return error;
+	}
+
+	return m_pAssembler->EmitCompareBranch(op, t0, t1, wide, nLabel);
+}
+
+/**
+ * This function will emit the return of a value, which is extended to the 64-bit
+ * return value of the C function in the same way as the C backend does.
+ *
+ * @param pStmt a return statement
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::EmitReturn(DtcCReturnStmt *pStmt) {
+
+	DtcError_t error;
+
+	DtcNativeReg_t t0 = m_pAssembler->GetScratchReg(0);
+	DtcNativeReg_t t1 = m_pAssembler->GetScratchReg(1);
+	DtcNativeReg_t t2 = m_pAssembler->GetScratchReg(2);
+
+	bool_t is64Bit = m_pAssembler->GetIs64Bit();
+
+	DtcCIdExpr *value = pStmt->GetValueExpr();
+
+	// The void methods return 0 in the epilogue
+	if(value == NULL) {
+		m_pAssembler->EmitJump(DTC_NATIVE_EPILOGUE);
+		return DTC_SUCCESS;
+	}
+
+	DtcDexDataType_t type = J_INT;
+	bool_t wide;
+
+	if(value->GetSymbol()->GetType() == DTC_C_SYM_VAR) {
+		type = ((DtcCVarSymbol *)value->GetSymbol())->GetWeb()->GetDataType();
+	}
+
+	if((error = GetIsWide(value, wide)) != DTC_SUCCESS) {
+		return error;
+	}
+
+	if((error = LoadOperand(t0, value, wide)) != DTC_SUCCESS) {
+		return error;
+	}
+
+	// The signed integers are sign-extended, and the others are zero-extended
+	bool_t sign = (type == J_INT || type == J_BYTE || type == J_SHORT);
+
+	if(is64Bit) {
+		if(sign && !wide && (error = m_pAssembler->EmitUnary(DTC_C_EXPR_UNARY_I2J, t0, TRUE)) != DTC_SUCCESS) {
+			return error;
+		}
+	}
+	else if(sign) {
+
+		// The upper word is the sign of the lower one
+		m_pAssembler->EmitMove(t1, t0, FALSE);
+		m_pAssembler->EmitLoadImm(t2, 31, FALSE);
+
+		if((error = m_pAssembler->EmitAlu(DTC_C_EXPR_BINARY_SHR, t1, t2, FALSE)) != DTC_SUCCESS) {
+			return error;
+		}
+	}
+	else {
+		m_pAssembler->EmitLoadImm(t1, 0, FALSE);
+	}
+
+	m_pAssembler->EmitJump(DTC_NATIVE_EPILOGUE);
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will emit the call to the runtime helper executing the instruction
+ * in the interpreter, with the stores of the used variables and the loads of the
+ * defined ones. The direct calls of the invokes are left to the C backend, so an
+ * invoke always goes through the helper here.
+ *
+ * @param pStmt a helper statement
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::EmitHelper(DtcCHelperStmt *pStmt) {
+
+	DtcError_t error;
+
+	DtcNativeReg_t t0 = m_pAssembler->GetScratchReg(0);
+	DtcNativeReg_t t1 = m_pAssembler->GetScratchReg(1);
+
+	// The live references are stored for the collector along with the used variables
+	if((error = EmitFrameStores(pStmt->GetSpillList())) != DTC_SUCCESS) {
+		return error;
+	}
+
+	if((error = EmitFrameStores(pStmt->GetUseList())) != DTC_SUCCESS) {
+		return error;
+	}
+
+	EmitRuntimeCall((const void *)dtc_execute, pStmt->GetDexPc());
+
+	// The whole frame is needed only when the interpreter takes over the instruction
+	uint32_t done = NewLabel();
+
+	m_pAssembler->EmitLoadImm(t1, 0, FALSE);
+
+	if((error = m_pAssembler->EmitCompareBranch(DTC_C_EXPR_BINARY_EQ, t0, t1, FALSE, done)) != DTC_SUCCESS) {
+		return error;
+	}
+
+	if((error = EmitDeopt(pStmt)) != DTC_SUCCESS) {
+		return error;
+	}
+
+	m_pAssembler->BindLabel(done);
+
+	if((error = EmitFrameLoads(pStmt->GetLoadList())) != DTC_SUCCESS) {
+		return error;
+	}
+
+	// The fused move-result takes the result kept by the helper
+	if(pStmt->GetResultSym() != NULL) {
+
+		vector<DtcCVarSymbol *> result(1, pStmt->GetResultSym());
+
+		EmitRuntimeCall((const void *)dtc_execute, pStmt->GetResultPc());
+
+		if((error = EmitFrameLoads(result)) != DTC_SUCCESS) {
+			return error;
+		}
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will emit the deoptimization, which stores the live variables into
+ * the frame and returns what the interpreter returns after resuming the method.
+ *
+ * @param pStmt a deoptimization statement
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::EmitDeopt(DtcCDeoptStmt *pStmt) {
+
+	DtcError_t error;
+
+	if((error = EmitFrameStores(pStmt->GetStoreList())) != DTC_SUCCESS) {
+		return error;
+	}
+
+	EmitRuntimeCall((const void *)dtc_deoptimize, pStmt->GetDexPc());
+
+	m_pAssembler->EmitJump(DTC_NATIVE_EPILOGUE);
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will emit the stores of the given variables into the frame.
+ *
+ * @param rSyms the variable symbols
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::EmitFrameStores(vector<DtcCVarSymbol *> &rSyms) {
+
+	DtcError_t error;
+
+	DtcNativeReg_t t0 = m_pAssembler->GetScratchReg(0);
+	DtcNativeReg_t base = m_pAssembler->GetScratchReg(2);
+
+	if(rSyms.empty()) {
+		return DTC_SUCCESS;
+	}
+
+	m_pAssembler->EmitLoadSlot(base, m_nFrameSlot, m_pAssembler->GetIs64Bit());
+
+	for(uint32_t i = 0; i < rSyms.size(); i++) {
+
+		bool_t wide;
+
+		if((error = GetIsWideType(rSyms[i]->GetWeb()->GetDataType(), wide)) != DTC_SUCCESS) {
+			return error;
+		}
+
+		if((error = LoadVariable(t0, rSyms[i], wide)) != DTC_SUCCESS) {
+			return error;
+		}
+
+		m_pAssembler->EmitStoreBase(base, rSyms[i]->GetWeb()->GetRegnum() * sizeof(u4), t0, wide);
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will emit the loads of the given variables from the frame.
+ *
+ * @param rSyms the variable symbols
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::EmitFrameLoads(vector<DtcCVarSymbol *> &rSyms) {
+
+	DtcError_t error;
+
+	DtcNativeReg_t t0 = m_pAssembler->GetScratchReg(0);
+	DtcNativeReg_t base = m_pAssembler->GetScratchReg(2);
+
+	if(rSyms.empty()) {
+		return DTC_SUCCESS;
+	}
+
+	m_pAssembler->EmitLoadSlot(base, m_nFrameSlot, m_pAssembler->GetIs64Bit());
+
+	for(uint32_t i = 0; i < rSyms.size(); i++) {
+
+		bool_t wide;
+
+		if((error = GetIsWideType(rSyms[i]->GetWeb()->GetDataType(), wide)) != DTC_SUCCESS) {
+			return error;
+		}
+
+		m_pAssembler->EmitLoadBase(t0, base, rSyms[i]->GetWeb()->GetRegnum() * sizeof(u4), wide);
+
+		if((error = StoreSymbol(rSyms[i], t0)) != DTC_SUCCESS) {
+			return error;
+		}
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will emit the call to a runtime function taking the frame and
+ * a dex address, whose result is left in the first scratch register.
+ *
+ * @param pFunc the runtime function
+ * @param nPc the dex address
+ */
+void
+DtcNativeEmitter::EmitRuntimeCall(const void *pFunc, uint32_t nPc) {
+
+	m_pAssembler->EmitLoadSlot(m_pAssembler->GetArgReg(0), m_nFrameSlot, m_pAssembler->GetIs64Bit());
+	m_pAssembler->EmitLoadImm(m_pAssembler->GetArgReg(1), nPc, FALSE);
+	m_pAssembler->EmitCall(pFunc);
+}
+
+/**
+ * This function will load the value of a variable or a constant into the given register.
+ *
+ * @param nDst the destination register
+ * @param pExpr an ID expression of a variable or a constant
+ * @param bWide whether the value is 64 bits wide
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::LoadOperand(DtcNativeReg_t nDst, DtcCExpression *pExpr, bool_t bWide) {
+
+	if(pExpr == NULL || pExpr->GetType() != DTC_C_EXPR_ID) {
+		return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	DtcCSymbol *sym = ((DtcCIdExpr *)pExpr)->GetSymbol();
+
+	switch(sym->GetType()) {
+
+		case DTC_C_SYM_VAR:
+			return LoadVariable(nDst, (DtcCVarSymbol *)sym, bWide);
+
+		case DTC_C_SYM_CONST: {
+
+			DtcCConstSymbol *constSym = (DtcCConstSymbol *)sym;
+
+			switch(constSym->GetDataType()) {
+				case J_FLOAT:
+				case J_DOUBLE:
+					return DTC_ERROR_NATIVE_UNSUPPORTED;
+				case J_LONG:
+					m_pAssembler->EmitLoadImm(nDst, ((uint64_t)constSym->GetHigh32() << 32) |
+						constSym->GetLow32(), bWide);
+					break;
+				default:
+					// Sign-extend the 32-bit constant for the 64-bit context
+					m_pAssembler->EmitLoadImm(nDst, (uint64_t)(int64_t)(int32_t)constSym->GetLow32(), bWide);
+					break;
+			}
+			break;
+		}
+
+		default:
+			return DTC_ERROR_NATIVE_UNSUPPORTED;
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will load the value of a variable into the given register.
+ *
+ * @param nDst the destination register
+ * @param pSym a variable symbol
+ * @param bWide whether the value is 64 bits wide
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::LoadVariable(DtcNativeReg_t nDst, DtcCVarSymbol *pSym, bool_t bWide) {
+
+	DtcNativeInterval_t *interval = GetVarInterval(pSym);
+
+	DTC_CHECK(interval != NULL, NATIVE_CODE_GEN);
+
+	if(interval->nPhysReg != DTC_NATIVE_SPILLED) {
+		m_pAssembler->EmitMove(nDst, (DtcNativeReg_t)interval->nPhysReg, bWide);
+	}
+	else {
+		m_pAssembler->EmitLoadSlot(nDst, GetSlotOffset(interval->nRegnum), bWide);
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will store the value of the given register into a variable.
+ *
+ * @param pIdExpr an ID expression of a variable
+ * @param nSrc the source register
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::StoreVariable(DtcCIdExpr *pIdExpr, DtcNativeReg_t nSrc) {
+
+	return StoreSymbol(GetVarSymbol(pIdExpr), nSrc);
+}
+
+/**
+ * This function will store the value of the given register into a variable.
+ *
+ * @param pSym a variable symbol
+ * @param nSrc the source register
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::StoreSymbol(DtcCVarSymbol *pSym, DtcNativeReg_t nSrc) {
+
+	DtcNativeInterval_t *interval = GetVarInterval(pSym);
+
+	DTC_CHECK(interval != NULL, NATIVE_UNSUPPORTED);
+
+	bool_t wide = (interval->nDataType == J_LONG);
+
+	if(interval->nPhysReg != DTC_NATIVE_SPILLED) {
+		m_pAssembler->EmitMove((DtcNativeReg_t)interval->nPhysReg, nSrc, wide);
+	}
+	else {
+		m_pAssembler->EmitStoreSlot(GetSlotOffset(interval->nRegnum), nSrc, wide);
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will check whether the value of the given expression is
+ * 64 bits wide. The floating-point values are not supported yet.
+ *
+ * @param pExpr an ID expression
+ * @param bWide the reference to be set for the wide values
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::GetIsWide(DtcCExpression *pExpr, bool_t &bWide) {
+
+	DtcDexDataType_t type = J_INT;
+
+	DtcCVarSymbol *sym = GetVarSymbol(pExpr);
+
+	if(sym != NULL) {
+		type = sym->GetWeb()->GetDataType();
+	}
+	else if(pExpr != NULL && pExpr->GetType() == DTC_C_EXPR_ID &&
+		((DtcCIdExpr *)pExpr)->GetSymbol()->GetType() == DTC_C_SYM_CONST) {
+		type = ((DtcCConstSymbol *)((DtcCIdExpr *)pExpr)->GetSymbol())->GetDataType();
+	}
+
+	return GetIsWideType(type, bWide);
+}
+
+/**
+ * This function will check whether the values of the given data type are 64 bits wide.
+ *
+ * @param nType a data type
+ * @param bWide the reference to be set for the wide values
+ * @return error information
+ */
+DtcError_t
+DtcNativeEmitter::GetIsWideType(DtcDexDataType_t nType, bool_t &bWide) {
+
+	switch(nType) {
+		case J_FLOAT:
+		case J_DOUBLE:
+			return DTC_ERROR_NATIVE_UNSUPPORTED;
+		case J_LONG:
+			DTC_CHECK(m_pAssembler->GetIs64Bit(), NATIVE_UNSUPPORTED);
+			bWide = TRUE;
+			break;
+		default:
+			bWide = FALSE;
+			break;
+	}
+
+	return DTC_SUCCESS;
+}
+
+/**
+ * This function will return the live interval of the variable of the given expression.
+ *
+ * @param pExpr an ID expression of a variable
+ * @return the live interval (NULL if the expression is not a variable)
+ */
+DtcNativeInterval_t *
+DtcNativeEmitter::GetInterval(DtcCExpression *pExpr) {
+
+	return GetVarInterval(GetVarSymbol(pExpr));
+}
+
+/**
+ * This function will return the live interval of the given variable.
+ *
+ * @param pSym a variable symbol
+ * @return the live interval (NULL if the variable has no interval)
+ */
+DtcNativeInterval_t *
+DtcNativeEmitter::GetVarInterval(DtcCVarSymbol *pSym) {
+
+	if(pSym == NULL) {
+		return NULL;
+	}
+
+	DtcNativeIntervalTable_t::iterator iter = m_rIntervalTable.find(GetVarKey(pSym));
+
+	return (iter != m_rIntervalTable.end()) ? &iter->second : NULL;
+}
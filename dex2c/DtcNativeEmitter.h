@@ -0,0 +1,174 @@
+/*********************************************************************
+*   DtcNativeEmitter.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_NATIVE_EMITTER_H_
+#define _DTC_NATIVE_EMITTER_H_
+
+#include "DtcCommon.h"
+#include "DtcCMethod.h"
+#include "DtcNativeAssembler.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+#define DTC_NATIVE_SPILLED		(-1)
+
+// The number of the argument registers common to all the targets (r0-r3 of ARM)
+#define DTC_NATIVE_ARG_REGS		4
+
+// The labels of the emitted code beyond the dex addresses, the first of which is the epilogue
+#define DTC_NATIVE_LABEL_BASE		0x80000000
+#define DTC_NATIVE_EPILOGUE		DTC_NATIVE_LABEL_BASE
+
+// Live interval of a C variable over the linearized statements
+typedef struct {
+
+	// Register number and data type identifying the C variable
+	uint16_t nRegnum;
+	DtcDexDataType_t nDataType;
+
+	// The first and last statement positions
+	uint32_t nStart;
+	uint32_t nEnd;
+
+	// Whether the variable is used before any definition
+	bool_t bLiveIn;
+
+	// Assigned physical register (DTC_NATIVE_SPILLED if it lives in its slot)
+	int32_t nPhysReg;
+
+} DtcNativeInterval_t;
+
+typedef map<uint32_t, DtcNativeInterval_t> DtcNativeIntervalTable_t;
+
+typedef vector<DtcNativeInterval_t *> DtcNativeIntervalList_t;
+
+///////////////////////////////////////////////////////////////////////
+// DtcNativeEmitter Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+class DtcNativeEmitter {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The translated C method to be emitted
+	DtcCMethod *m_pCMethod;
+
+	// The assembler of the host machine
+	DtcNativeAssembler *m_pAssembler;
+
+	// The live intervals of the C variables
+	DtcNativeIntervalTable_t m_rIntervalTable;
+
+	// The entry address of the installed code
+	void *m_pEntry;
+
+	// The offset of the slot keeping the frame of the interpreter
+	uint32_t m_nFrameSlot;
+
+	// The next label of the cold paths
+	uint32_t m_nNextLabel;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcNativeEmitter(DtcCMethod *pCMethod);
+
+	virtual ~DtcNativeEmitter();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the entry address of the emitted code.
+	 *
+	 * @return the entry address (NULL if it is not emitted yet)
+	 */
+	inline void *GetEntry()				{ return m_pEntry;		}
+
+	/**
+	 * This function will return the size of the emitted code.
+	 *
+	 * @return the size of the code in bytes
+	 */
+	inline uint32_t GetCodeSize()			{ return m_pAssembler->GetBuffer().GetSize();	}
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcError_t Emit();
+
+private:
+
+	DtcError_t BuildIntervals();
+
+	DtcError_t AddInterval(DtcCVarSymbol *pSym, uint32_t nPos, bool_t bDef);
+
+	DtcError_t AllocateRegisters();
+
+	DtcError_t EmitStatement(DtcCStatement *pStmt);
+
+	DtcError_t EmitCondBranch(DtcCExpression *pCond, bool_t bNegate, uint32_t nLabel);
+
+	DtcError_t EmitReturn(DtcCReturnStmt *pStmt);
+
+	DtcError_t EmitHelper(DtcCHelperStmt *pStmt);
+
+	DtcError_t EmitDeopt(DtcCDeoptStmt *pStmt);
+
+	DtcError_t EmitFrameStores(vector<DtcCVarSymbol *> &rSyms);
+
+	DtcError_t EmitFrameLoads(vector<DtcCVarSymbol *> &rSyms);
+
+	void EmitRuntimeCall(const void *pFunc, uint32_t nPc);
+
+	DtcError_t LoadOperand(DtcNativeReg_t nDst, DtcCExpression *pExpr, bool_t bWide);
+
+	DtcError_t LoadVariable(DtcNativeReg_t nDst, DtcCVarSymbol *pSym, bool_t bWide);
+
+	DtcError_t StoreVariable(DtcCIdExpr *pIdExpr, DtcNativeReg_t nSrc);
+
+	DtcError_t StoreSymbol(DtcCVarSymbol *pSym, DtcNativeReg_t nSrc);
+
+	DtcError_t GetIsWide(DtcCExpression *pExpr, bool_t &bWide);
+
+	DtcError_t GetIsWideType(DtcDexDataType_t nType, bool_t &bWide);
+
+	DtcNativeInterval_t *GetInterval(DtcCExpression *pExpr);
+
+	DtcNativeInterval_t *GetVarInterval(DtcCVarSymbol *pSym);
+
+	/**
+	 * This function will return a new label of a cold path.
+	 *
+	 * @return the label
+	 */
+	inline uint32_t NewLabel()			{ return m_nNextLabel++;	}
+
+	/**
+	 * This function will return the offset of the spill slot of the given register.
+	 *
+	 * @param nRegnum the register number
+	 * @return the offset of the slot from the stack pointer
+	 */
+	inline uint32_t GetSlotOffset(uint16_t nRegnum)	{ return (uint32_t)nRegnum * 8;	}
+};
+
+#endif
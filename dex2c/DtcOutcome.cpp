@@ -0,0 +1,212 @@
+/*********************************************************************
+*   DtcOutcome.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <algorithm>
+
+#include "DtcOutcome.h"
+
+///////////////////////////////////////////////////////////////////////
+// Global Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcOutcomeRegistry gDtcOutcomes;
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Declaration
+///////////////////////////////////////////////////////////////////////
+
+typedef pair<uint32_t, const Method *> DtcRankedMethod_t;
+
+static bool CompareRank(const DtcRankedMethod_t &rLeft, const DtcRankedMethod_t &rRight);
+
+///////////////////////////////////////////////////////////////////////
+// Constructor & Destructor Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcOutcomeRegistry::DtcOutcomeRegistry() {
+
+	pthread_mutex_init(&m_rLock, NULL);
+
+	m_rOutcomeTable.clear();
+
+	memset(m_pErrorCounts, 0, sizeof(m_pErrorCounts));
+}
+
+DtcOutcomeRegistry::~DtcOutcomeRegistry() {
+
+	// The compiler thread can record until the VM exits, so nothing is released here
+}
+
+///////////////////////////////////////////////////////////////////////
+// Member Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will record the result of a compile attempt of the given method.
+ *
+ * @param pMethod the method
+ * @param nError the result of the attempt
+ * @param nTimeUs the time spent for the attempt in microseconds
+ * @param nPc the dex pc of the dex code causing the result
+ * @param nOpcode the opcode of the dex code causing the result
+ */
+void
+DtcOutcomeRegistry::Record(const Method *pMethod, DtcError_t nError, uint64_t nTimeUs,
+	uint32_t nPc /* = DTC_OUTCOME_NO_PC */, Opcode nOpcode /* = OP_NOP */) {
+
+	if(nError < 0 || nError >= NUM_OF_DTC_ERRORS) nError = DTC_FAILURE;
+
+	pthread_mutex_lock(&m_rLock);
+
+	m_pErrorCounts[nError]++;
+
+	if(pMethod != NULL) {
+
+		// A new outcome starts with zero from the map
+		DtcOutcome_t &outcome = m_rOutcomeTable[pMethod];
+
+		outcome.nError = nError;
+		outcome.nPc = nPc;
+		outcome.nOpcode = nOpcode;
+		outcome.nAttempts++;
+		outcome.nTimeUs += nTimeUs;
+	}
+
+	pthread_mutex_unlock(&m_rLock);
+}
+
+/**
+ * This function will count that the given method got hot again. Only the rejected
+ * methods are counted, since the compiled ones never get hot in the interpreter.
+ *
+ * @param pMethod the method
+ */
+void
+DtcOutcomeRegistry::AddHit(const Method *pMethod) {
+
+	pthread_mutex_lock(&m_rLock);
+
+	DtcOutcomeTable_t::iterator iter = m_rOutcomeTable.find(pMethod);
+
+	if(iter != m_rOutcomeTable.end() && iter->second.nError != DTC_SUCCESS) {
+		iter->second.nHits++;
+	}
+
+	pthread_mutex_unlock(&m_rLock);
+}
+
+/**
+ * This function will return the number of the attempts resulting in the given error.
+ *
+ * @param nError the error code
+ * @return the number of the attempts
+ */
+uint32_t
+DtcOutcomeRegistry::GetErrorCount(DtcError_t nError) {
+
+	if(nError < 0 || nError >= NUM_OF_DTC_ERRORS) return 0;
+
+	pthread_mutex_lock(&m_rLock);
+
+	uint32_t count = m_pErrorCounts[nError];
+
+	pthread_mutex_unlock(&m_rLock);
+
+	return count;
+}
+
+/**
+ * This function will print out the counts by the error codes, and the hottest methods
+ * rejected by each of the errors.
+ *
+ * @param nTopN the number of the methods printed for each error
+ */
+void
+DtcOutcomeRegistry::Dump(uint32_t nTopN /* = DTC_OUTCOME_TOP_N */) {
+
+	vector<DtcRankedMethod_t> ranks[NUM_OF_DTC_ERRORS];
+	DtcOutcomeTable_t::iterator iter;
+
+	pthread_mutex_lock(&m_rLock);
+
+	for(iter = m_rOutcomeTable.begin(); iter != m_rOutcomeTable.end(); iter++) {
+
+		if(iter->second.nError == DTC_SUCCESS) continue;
+
+		ranks[iter->second.nError].push_back(DtcRankedMethod_t(iter->second.nHits, iter->first));
+	}
+
+	DtcDebugPrintln(DEX2C_TAG, "Compile outcomes (error: attempts)");
+
+	for(uint32_t i = 0; i < NUM_OF_DTC_ERRORS; i++) {
+
+		if(m_pErrorCounts[i] == 0) continue;
+
+		DtcDebugPrintln(DEX2C_TAG, "  %2d: %u", i, m_pErrorCounts[i]);
+
+		uint32_t count = (ranks[i].size() < nTopN) ? ranks[i].size() : nTopN;
+
+		partial_sort(ranks[i].begin(), ranks[i].begin() + count, ranks[i].end(), CompareRank);
+
+		for(uint32_t j = 0; j < count; j++) {
+
+			const Method *method = ranks[i][j].second;
+			DtcOutcome_t &outcome = m_rOutcomeTable[method];
+
+			if(outcome.nPc != DTC_OUTCOME_NO_PC) {
+
+				DtcDebugPrintln(DEX2C_TAG, "      %s.%s: %u hits, %u attempts, %llu us, %s at 0x%04x",
+					method->clazz->descriptor, method->name, outcome.nHits, outcome.nAttempts,
+					(unsigned long long)outcome.nTimeUs, dexGetOpcodeName(outcome.nOpcode), outcome.nPc);
+			}
+			else {
+
+				DtcDebugPrintln(DEX2C_TAG, "      %s.%s: %u hits, %u attempts, %llu us",
+					method->clazz->descriptor, method->name, outcome.nHits, outcome.nAttempts,
+					(unsigned long long)outcome.nTimeUs);
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&m_rLock);
+}
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will order the rejected methods from the hottest one.
+ *
+ * @param rLeft a method and its hits
+ * @param rRight a method and its hits
+ * @return true if the left one is hotter
+ */
+static bool
+CompareRank(const DtcRankedMethod_t &rLeft, const DtcRankedMethod_t &rRight) {
+
+	return rLeft.first > rRight.first;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Global Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will print out the compile outcomes on demand, next to the compile
+ * statistics.
+ */
+extern "C" void
+dtcDumpCompileOutcomes(void) {
+
+	gDtcOutcomes.Dump();
+}
@@ -0,0 +1,110 @@
+/*********************************************************************
+*   DtcOutcome.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_OUTCOME_H_
+#define _DTC_OUTCOME_H_
+
+#include <pthread.h>
+
+#include "DtcCommon.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// The number of the error codes
+#define NUM_OF_DTC_ERRORS			(DTC_FAILURE + 1)
+
+// The number of the rejected methods printed for each cause
+#define DTC_OUTCOME_TOP_N			10
+
+// The dex pc of an outcome not caused by a dex code
+#define DTC_OUTCOME_NO_PC			0xFFFFFFFF
+
+// The outcome of the compile attempts of a method
+typedef struct {
+
+	// The result of the last attempt
+	DtcError_t nError;
+
+	// The dex code causing the result (DTC_OUTCOME_NO_PC if not caused by a dex code)
+	uint32_t nPc;
+	Opcode nOpcode;
+
+	// The number of the attempts and the time spent for them in microseconds
+	uint32_t nAttempts;
+	uint64_t nTimeUs;
+
+	// The number of the times the method got hot again after it was rejected
+	uint32_t nHits;
+
+} DtcOutcome_t;
+
+typedef map<const Method *, DtcOutcome_t> DtcOutcomeTable_t;
+
+///////////////////////////////////////////////////////////////////////
+// DtcOutcomeRegistry Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * The registry keeps the result of every compile attempt by the method, so that the
+ * causes rejecting the methods can be ranked by how often the rejected methods get
+ * hot again. The counts by the error codes are kept apart from the methods.
+ */
+class DtcOutcomeRegistry {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The outcomes of the methods
+	DtcOutcomeTable_t m_rOutcomeTable;
+
+	// The number of the attempts by the error codes
+	uint32_t m_pErrorCounts[NUM_OF_DTC_ERRORS];
+
+	// The lock protecting the registry
+	pthread_mutex_t m_rLock;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcOutcomeRegistry();
+
+	virtual ~DtcOutcomeRegistry();
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	void Record(const Method *pMethod, DtcError_t nError, uint64_t nTimeUs,
+		uint32_t nPc = DTC_OUTCOME_NO_PC, Opcode nOpcode = OP_NOP);
+
+	void AddHit(const Method *pMethod);
+
+	uint32_t GetErrorCount(DtcError_t nError);
+
+	void Dump(uint32_t nTopN = DTC_OUTCOME_TOP_N);
+};
+
+extern DtcOutcomeRegistry gDtcOutcomes;
+
+///////////////////////////////////////////////////////////////////////
+// Global Function Declaration
+///////////////////////////////////////////////////////////////////////
+
+extern "C" void dtcDumpCompileOutcomes(void);
+
+#endif
@@ -0,0 +1,25 @@
+/*********************************************************************
+*   DtcProfConfig.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+/*
+ * The configuration of the hotness counters shared by DtcProfiler.cpp and the
+ * interpreter (vm/mterp), which includes the header from the assembly sources,
+ * so only the preprocessor directives may appear in it.
+ */
+
+#ifndef _DTC_PROF_CONFIG_H_
+#define _DTC_PROF_CONFIG_H_
+
+// The size of the method hotness counter table (log2)
+#define DTC_PROF_SIZE_LOG_2			11
+
+#endif /* _DTC_PROF_CONFIG_H_ */
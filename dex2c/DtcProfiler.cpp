@@ -0,0 +1,419 @@
+/*********************************************************************
+*   DtcProfiler.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include "DtcProfiler.h"
+#include "DtcOutcome.h"
+#include "DtcStats.h"
+
+///////////////////////////////////////////////////////////////////////
+// Global Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+u2 gDtcProfCounters[NUM_OF_DTC_HOT_KINDS * DTC_PROF_SIZE];
+
+// The counters are filled with the default thresholds when the VM is loaded
+DtcProfiler gDtcProfiler;
+
+///////////////////////////////////////////////////////////////////////
+// Constructor & Destructor Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcProfiler::DtcProfiler() {
+
+	pthread_mutex_init(&m_rLock, NULL);
+	pthread_cond_init(&m_rQueueCond, NULL);
+
+	m_rQueue.clear();
+	m_rRequestedSet.clear();
+	m_rBlockCountTable.clear();
+
+	m_bThreadStarted = FALSE;
+	m_pCompiler = NULL;
+
+	// The options of the VM are applied later by dtcProfileParseOption
+	m_bEnabled = TRUE;
+	m_bBranchHot = TRUE;
+	m_bReport = FALSE;
+
+	SetThresholds(DTC_INVOKE_THRESHOLD, DTC_BRANCH_THRESHOLD);
+}
+
+DtcProfiler::~DtcProfiler() {
+
+	// The compiler thread runs until the VM exits, so nothing is released here
+}
+
+///////////////////////////////////////////////////////////////////////
+// Member Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will set the thresholds of the hotness counters and restart all
+ * the counters from them.
+ *
+ * @param nInvokeThreshold the number of the invocations making a method hot
+ * @param nBranchThreshold the number of the backward branches making a method hot
+ */
+void
+DtcProfiler::SetThresholds(u4 nInvokeThreshold, u4 nBranchThreshold) {
+
+	u4 thresholds[NUM_OF_DTC_HOT_KINDS] = { nInvokeThreshold, nBranchThreshold };
+
+	// The counters are 16-bit and zero is the trigger value
+	for(uint32_t kind = 0; kind < NUM_OF_DTC_HOT_KINDS; kind++) {
+
+		if(thresholds[kind] == 0) thresholds[kind] = 1;
+		if(thresholds[kind] > 0xFFFF) thresholds[kind] = 0xFFFF;
+
+		m_pThresholds[kind] = (u2)thresholds[kind];
+	}
+
+	for(uint32_t kind = 0; kind < NUM_OF_DTC_HOT_KINDS; kind++) {
+
+		u2 *counters = &gDtcProfCounters[kind * DTC_PROF_SIZE];
+
+		for(uint32_t i = 0; i < DTC_PROF_SIZE; i++) {
+			counters[i] = m_pThresholds[kind];
+		}
+	}
+}
+
+/**
+ * This function will apply an option of the VM starting with -Xdex2c:, which is one of
+ *
+ *   -Xdex2c:off          the hot methods are never compiled
+ *   -Xdex2c:report       the compiler thread prints out a summary of the compilations
+ *                        whenever it has compiled all the queued methods
+ *   -Xdex2c:invoke=<n>   the number of the invocations making a method hot
+ *   -Xdex2c:branch=<n>   the number of the backward branches making a method hot
+ *   -Xdex2c:branch=off   only the invocations make a method hot, and the loops enter
+ *                        the methods already compiled
+ *
+ * @param pOption the option
+ * @return TRUE if the option is known
+ */
+bool_t
+DtcProfiler::ParseOption(const char *pOption) {
+
+	static const char prefix[] = "-Xdex2c:";
+
+	if(strncmp(pOption, prefix, sizeof(prefix) - 1) != 0) return FALSE;
+
+	const char *value = pOption + sizeof(prefix) - 1;
+
+	if(strcmp(value, "off") == 0) {
+
+		// The counters of a disabled profiler expire as rarely as possible
+		m_bEnabled = FALSE;
+		SetThresholds(0xFFFF, 0xFFFF);
+		return TRUE;
+	}
+
+	if(strcmp(value, "report") == 0) {
+		m_bReport = TRUE;
+		return TRUE;
+	}
+
+	if(m_bEnabled == FALSE) return TRUE;
+
+	if(strncmp(value, "invoke=", 7) == 0) {
+		SetThresholds(strtoul(value + 7, NULL, 10), m_pThresholds[DTC_HOT_BRANCH]);
+		return TRUE;
+	}
+
+	if(strcmp(value, "branch=off") == 0) {
+		m_bBranchHot = FALSE;
+		SetThresholds(m_pThresholds[DTC_HOT_INVOKE], 0xFFFF);
+		return TRUE;
+	}
+
+	if(strncmp(value, "branch=", 7) == 0) {
+		m_bBranchHot = TRUE;
+		SetThresholds(m_pThresholds[DTC_HOT_INVOKE], strtoul(value + 7, NULL, 10));
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/**
+ * This function will queue the given method to the compiler thread. A method is
+ * queued only once, even if the compilation fails.
+ *
+ * @param pMethod the hot method
+ * @return TRUE if the method is queued
+ */
+bool_t
+DtcProfiler::RequestCompile(Method *pMethod) {
+
+	if(m_bEnabled == FALSE) return FALSE;
+
+	// Abstract and native methods do not have any code to be compiled
+	if(pMethod == NULL || pMethod->compiledCode != NULL || dvmGetMethodCode(pMethod) == NULL) {
+		return FALSE;
+	}
+
+	pthread_mutex_lock(&m_rLock);
+
+	if(m_rRequestedSet.count(pMethod) > 0) {
+
+		// A method rejected by the compiler keeps getting hot, which ranks the cause
+		pthread_mutex_unlock(&m_rLock);
+		gDtcOutcomes.AddHit(pMethod);
+		return FALSE;
+	}
+
+
+	if(m_rQueue.size() >= DTC_COMPILE_QUEUE_SIZE ||
+		m_rRequestedSet.insert(pMethod).second == FALSE) {
+
+		// A method dropped by the full queue is requested again when its counter expires
+		pthread_mutex_unlock(&m_rLock);
+		return FALSE;
+	}
+
+	// The first request claims the start of the compiler thread
+	bool_t bStartThread = (m_bThreadStarted == FALSE);
+
+	if(bStartThread == TRUE) {
+
+		// The compiler exists before the thread so that the OSR entries can be looked up
+		if(m_pCompiler == NULL) m_pCompiler = new DtcJitCompiler();
+		m_bThreadStarted = TRUE;
+	}
+
+	m_rQueue.push_back(pMethod);
+
+	pthread_cond_signal(&m_rQueueCond);
+	pthread_mutex_unlock(&m_rLock);
+
+	// The thread is attached to the VM so that it takes part in the suspension, and it
+	// is created out of the lock, which the new thread takes as soon as it starts
+	if(bStartThread == TRUE &&
+		dvmCreateInternalThread(&m_rThread, "DtcCompiler", CompilerMain, this) == false) {
+
+		DTC_ERROR(DEX2C_TAG, "RequestCompile - Fail to create the compiler thread");
+
+		// The next request tries again, and the methods queued meanwhile wait for it
+		pthread_mutex_lock(&m_rLock);
+		m_bThreadStarted = FALSE;
+		m_rRequestedSet.erase(pMethod);
+		for(DtcCompileQueue_t::iterator it = m_rQueue.begin(); it != m_rQueue.end(); it++) {
+			if(*it == pMethod) {
+				m_rQueue.erase(it);
+				break;
+			}
+		}
+		pthread_mutex_unlock(&m_rLock);
+		return FALSE;
+	}
+
+	DTC_DEBUG(DEX2C_TAG, "RequestCompile - %s queued", pMethod->name);
+
+	return TRUE;
+}
+
+/**
+ * This function will add the given count to the execution count of the block at the
+ * given pc. The counts of a method are kept until the method is taken by the compiler.
+ *
+ * @param pMethod the method running in the interpreter
+ * @param nPc the dex pc in the block
+ * @param nCount the number of the executions
+ */
+void
+DtcProfiler::RecordBlockCount(const Method *pMethod, uint32_t nPc, uint32_t nCount) {
+
+	pthread_mutex_lock(&m_rLock);
+
+	if(m_rRequestedSet.count(pMethod) == 0) {
+		m_rBlockCountTable[pMethod][nPc] += nCount;
+	}
+
+	pthread_mutex_unlock(&m_rLock);
+}
+
+/**
+ * This function will compile the queued methods in batches. It runs on the
+ * compiler thread and never returns.
+ */
+void
+DtcProfiler::RunCompiler() {
+
+	vector<Method *> methods;
+	vector<DtcBlockCountTable_t> counts;
+
+	while(TRUE) {
+
+		pthread_mutex_lock(&m_rLock);
+
+		while(m_rQueue.empty()) {
+			pthread_cond_wait(&m_rQueueCond, &m_rLock);
+		}
+
+		// Take all the queued methods so that they can share the batches
+		methods.assign(m_rQueue.begin(), m_rQueue.end());
+		m_rQueue.clear();
+
+		// The block counts go with the methods, which are never recorded again
+		counts.assign(methods.size(), DtcBlockCountTable_t());
+
+		for(uint32_t i = 0; i < methods.size(); i++) {
+
+			DtcMethodCountTable_t::iterator iter = m_rBlockCountTable.find(methods[i]);
+
+			if(iter == m_rBlockCountTable.end()) continue;
+
+			counts[i].swap(iter->second);
+			m_rBlockCountTable.erase(iter);
+		}
+
+		pthread_mutex_unlock(&m_rLock);
+
+		uint32_t done = 0;
+
+		while(done < methods.size()) {
+
+			uint32_t consumed = 0;
+
+			// Stop here while the threads are suspended, e.g. by the debugger
+			dvmCheckSuspendPending(NULL);
+
+			m_pCompiler->CompileBatch(&methods[done], methods.size() - done, consumed, &counts[done]);
+
+			done += (consumed > 0) ? consumed : 1;
+		}
+
+		// The summary is printed by the compiler itself rather than at the exit of the
+		// VM, which may come in the middle of a batch, and the last one counts
+		if(m_bReport == TRUE) {
+			DtcStats::Report();
+		}
+	}
+}
+
+/**
+ * This function will return the OSR entry of a compiled method for the given loop header.
+ *
+ * @param pMethod the method running in the interpreter
+ * @param pPc the address of the loop header
+ * @return the OSR entry (NULL if the loop header cannot be entered)
+ */
+void *
+DtcProfiler::GetOsrEntry(Method *pMethod, const u2 *pPc) {
+
+	if(pMethod->compiledCode == NULL) return NULL;
+
+	pthread_mutex_lock(&m_rLock);
+	DtcJitCompiler *compiler = m_pCompiler;
+	pthread_mutex_unlock(&m_rLock);
+
+	if(compiler == NULL) return NULL;
+
+	return compiler->GetOsrEntry(pMethod, (uint32_t)(pPc - pMethod->insns));
+}
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function is the main function of the compiler thread.
+ *
+ * @param pArg the profiler
+ * @return NULL
+ */
+void *
+DtcProfiler::CompilerMain(void *pArg) {
+
+	// The compiler never touches the managed heap except for the installation, so
+	// the suspension of all the threads does not need to wait for the thread
+	dvmChangeStatus(NULL, THREAD_VMWAIT);
+
+	((DtcProfiler *)pArg)->RunCompiler();
+
+	return NULL;
+}
+
+/**
+ * This function will be called by the interpreter when a hotness counter of the
+ * given method reaches zero. It restarts the counter and queues the method.
+ *
+ * @param pMethod the method whose counter is expired
+ * @param pCounter the expired counter
+ */
+extern "C" void
+dtcProfileHotMethod(Method *pMethod, u2 *pCounter) {
+
+	DtcHotKind_t kind = (pCounter < &gDtcProfCounters[DTC_PROF_SIZE]) ? DTC_HOT_INVOKE : DTC_HOT_BRANCH;
+
+	*pCounter = gDtcProfiler.GetThreshold(kind);
+
+	// The invocations are counted on the entry block
+	if(kind == DTC_HOT_INVOKE) {
+		gDtcProfiler.RecordBlockCount(pMethod, 0, *pCounter);
+	}
+
+	gDtcProfiler.RequestCompile(pMethod);
+}
+
+/**
+ * This function will be called by the interpreter when the backward branch counter of
+ * the given method reaches zero at a loop header. If the method has been compiled, the
+ * interpreter continues the loop in the compiled code through the returned OSR entry.
+ *
+ * @param pMethod the method whose counter is expired
+ * @param pCounter the expired counter
+ * @param pPc the address of the loop header
+ * @return the OSR entry (NULL to keep interpreting the loop)
+ */
+extern "C" void *
+dtcProfileHotLoop(Method *pMethod, u2 *pCounter, const u2 *pPc) {
+
+	*pCounter = gDtcProfiler.GetThreshold(DTC_HOT_BRANCH);
+
+	// The loop header taking the expired counter is sampled for the whole loop
+	gDtcProfiler.RecordBlockCount(pMethod, (uint32_t)(pPc - pMethod->insns), *pCounter);
+
+	void *entry = gDtcProfiler.GetOsrEntry(pMethod, pPc);
+
+	if(entry == NULL && gDtcProfiler.IsBranchHot() == TRUE) {
+		gDtcProfiler.RequestCompile(pMethod);
+	}
+
+	return entry;
+}
+
+/**
+ * This function will set the thresholds of the hotness counters.
+ *
+ * @param nInvokeThreshold the number of the invocations making a method hot
+ * @param nBranchThreshold the number of the backward branches making a method hot
+ */
+extern "C" void
+dtcProfileSetThresholds(u4 nInvokeThreshold, u4 nBranchThreshold) {
+
+	gDtcProfiler.SetThresholds(nInvokeThreshold, nBranchThreshold);
+}
+
+/**
+ * This function will apply an option of the VM to the profiler. The option parser of
+ * the VM hands every option starting with -Xdex2c: to it before any method runs.
+ *
+ * @param pOption the option
+ * @return TRUE if the option is known
+ */
+extern "C" bool_t
+dtcProfileParseOption(const char *pOption) {
+
+	return gDtcProfiler.ParseOption(pOption);
+}
@@ -0,0 +1,161 @@
+/*********************************************************************
+*   DtcProfiler.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_PROFILER_H_
+#define _DTC_PROFILER_H_
+
+#include <deque>
+#include <pthread.h>
+
+#include "DtcCommon.h"
+#include "DtcJitCompiler.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// The number of the hotness counters of each kind
+#define DTC_PROF_SIZE			(1 << DTC_PROF_SIZE_LOG_2)
+
+// The kinds of the hotness counters, which index the halves of the counter table
+typedef enum {
+	DTC_HOT_INVOKE = 0,
+	DTC_HOT_BRANCH,
+	NUM_OF_DTC_HOT_KINDS
+} DtcHotKind_t;
+
+typedef deque<Method *> DtcCompileQueue_t;
+
+typedef set<const Method *> DtcMethodSet_t;
+
+typedef map<const Method *, DtcBlockCountTable_t> DtcMethodCountTable_t;
+
+/*
+ * The hotness counters updated by the interpreter, which are hashed by the address
+ * of the method like pJitProfTable is hashed by the dalvik PC. The invocation
+ * counters come first and the backward branch counters follow them. Each counter
+ * counts down from its threshold and the interpreter calls dtcProfileHotMethod,
+ * or dtcProfileHotLoop for a backward branch counter, when it reaches zero.
+ */
+extern "C" u2 gDtcProfCounters[NUM_OF_DTC_HOT_KINDS * DTC_PROF_SIZE];
+
+extern "C" void dtcProfileHotMethod(Method *pMethod, u2 *pCounter);
+
+extern "C" void *dtcProfileHotLoop(Method *pMethod, u2 *pCounter, const u2 *pPc);
+
+extern "C" void dtcProfileSetThresholds(u4 nInvokeThreshold, u4 nBranchThreshold);
+
+extern "C" bool_t dtcProfileParseOption(const char *pOption);
+
+///////////////////////////////////////////////////////////////////////
+// DtcProfiler Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * The profiler selects the methods to be compiled from their hotness and queues
+ * them to a compiler thread, so the interpreter never waits for a compilation.
+ * The compiler thread publishes ACC_COMPILE_TARGET only after the compiled code
+ * is installed, so the interpreter can jump to the code as soon as it sees the flag.
+ */
+class DtcProfiler {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The thresholds of the invocations and the backward branches
+	u2 m_pThresholds[NUM_OF_DTC_HOT_KINDS];
+
+	// The lock protecting the queue
+	pthread_mutex_t m_rLock;
+	pthread_cond_t m_rQueueCond;
+
+	// The methods waiting for the compiler thread
+	DtcCompileQueue_t m_rQueue;
+
+	// The methods queued so far, which are never queued again
+	DtcMethodSet_t m_rRequestedSet;
+
+	// The execution counts of the blocks of the methods not queued yet, which are
+	// sampled when the counters expire and select the regions of the large methods
+	DtcMethodCountTable_t m_rBlockCountTable;
+
+	// The compiler thread, which is started by the first request
+	pthread_t m_rThread;
+	bool_t m_bThreadStarted;
+
+	DtcJitCompiler *m_pCompiler;
+
+	// Whether the hot methods are compiled, which is cleared by -Xdex2c:off
+	// so that the interpreters can be measured alone
+	bool_t m_bEnabled;
+
+	// Whether the backward branches make a method hot, which is cleared by
+	// -Xdex2c:branch=off
+	bool_t m_bBranchHot;
+
+	// Whether the compiler thread prints out its summary, set by -Xdex2c:report
+	bool_t m_bReport;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcProfiler();
+
+	virtual ~DtcProfiler();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the threshold of the given kind of the counters.
+	 *
+	 * @param nKind the kind of the counters
+	 * @return the threshold
+	 */
+	inline u2 GetThreshold(DtcHotKind_t nKind)	{ return m_pThresholds[nKind];	}
+
+	/**
+	 * This function will tell whether the backward branches make a method hot.
+	 *
+	 * @return TRUE if an expired backward branch counter requests the compilation
+	 */
+	inline bool_t IsBranchHot()					{ return m_bBranchHot;			}
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	void SetThresholds(u4 nInvokeThreshold, u4 nBranchThreshold);
+
+	bool_t ParseOption(const char *pOption);
+
+	bool_t RequestCompile(Method *pMethod);
+
+	void RecordBlockCount(const Method *pMethod, uint32_t nPc, uint32_t nCount);
+
+	void *GetOsrEntry(Method *pMethod, const u2 *pPc);
+
+private:
+
+	void RunCompiler();
+
+	static void *CompilerMain(void *pArg);
+};
+
+extern DtcProfiler gDtcProfiler;
+
+#endif
@@ -0,0 +1,1184 @@
+/*********************************************************************
+*   DtcRuntime.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <math.h>
+
+#include "DtcRuntime.h"
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Declaration
+///////////////////////////////////////////////////////////////////////
+
+static s4 ExecuteArith(u4 *pFp, DecodedInstruction &rDec);
+
+static s4 ExecuteArray(u4 *pFp, DecodedInstruction &rDec);
+
+static s4 ExecuteField(const Method *pMethod, u4 *pFp, DecodedInstruction &rDec);
+
+static s4 ExecuteInvoke(Thread *pSelf, const Method *pMethod, u4 *pFp, DecodedInstruction &rDec);
+
+///////////////////////////////////////////////////////////////////////
+// Register Access Function Definition
+///////////////////////////////////////////////////////////////////////
+
+// The registers of the frame accessed like the interpreter
+#define GET_REGISTER(IDX)				(pFp[IDX])
+#define SET_REGISTER(IDX, VAL)			(pFp[IDX] = (u4)(VAL))
+#define GET_REGISTER_AS_OBJECT(IDX)		((Object *)(uintptr_t)pFp[IDX])
+#define SET_REGISTER_AS_OBJECT(IDX, VAL)	(pFp[IDX] = (u4)(uintptr_t)(VAL))
+
+static inline float
+GetRegisterFloat(const u4 *pFp, u4 nReg) {
+
+	union { u4 w; float f; } u;
+	u.w = pFp[nReg];
+	return u.f;
+}
+
+static inline void
+SetRegisterFloat(u4 *pFp, u4 nReg, float fVal) {
+
+	union { u4 w; float f; } u;
+	u.f = fVal;
+	pFp[nReg] = u.w;
+}
+
+static inline s8
+GetRegisterWide(const u4 *pFp, u4 nReg) {
+
+	union { u4 w[2]; s8 j; } u;
+	u.w[0] = pFp[nReg];
+	u.w[1] = pFp[nReg + 1];
+	return u.j;
+}
+
+static inline void
+SetRegisterWide(u4 *pFp, u4 nReg, s8 nVal) {
+
+	union { u4 w[2]; s8 j; } u;
+	u.j = nVal;
+	pFp[nReg] = u.w[0];
+	pFp[nReg + 1] = u.w[1];
+}
+
+static inline double
+GetRegisterDouble(const u4 *pFp, u4 nReg) {
+
+	union { s8 j; double d; } u;
+	u.j = GetRegisterWide(pFp, nReg);
+	return u.d;
+}
+
+static inline void
+SetRegisterDouble(u4 *pFp, u4 nReg, double dVal) {
+
+	union { s8 j; double d; } u;
+	u.d = dVal;
+	SetRegisterWide(pFp, nReg, u.j);
+}
+
+/**
+ * This function will convert a floating-point value into an integer with the
+ * semantics of Java, where NaN becomes zero and the value is saturated.
+ *
+ * @param fVal the floating-point value
+ * @param nMin the minimum value of the integer type
+ * @param nMax the maximum value of the integer type
+ * @return the converted integer
+ */
+template <typename FLOAT_T, typename INT_T>
+static inline INT_T
+ConvertToInteger(FLOAT_T fVal, INT_T nMin, INT_T nMax) {
+
+	if(fVal != fVal) return 0;
+	if(fVal >= (FLOAT_T)nMax) return nMax;
+	if(fVal <= (FLOAT_T)nMin) return nMin;
+
+	return (INT_T)fVal;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Resolution Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will return the class of the given index, resolving it if needed.
+ *
+ * @param pMethod the method referring to the class
+ * @param nIdx the class index
+ * @param bFromUnverifiedConstant whether the reference is from an unverified constant
+ * @return the class (NULL with an exception pending)
+ */
+static ClassObject *
+ResolveClass(const Method *pMethod, u4 nIdx, bool bFromUnverifiedConstant) {
+
+	ClassObject *clazz = dvmDexGetResolvedClass(pMethod->clazz->pDvmDex, nIdx);
+
+	if(clazz == NULL) {
+		clazz = dvmResolveClass(pMethod->clazz, nIdx, bFromUnverifiedConstant);
+	}
+
+	return clazz;
+}
+
+/**
+ * This function will return the method of the given index, resolving it if needed.
+ *
+ * @param pMethod the method referring to the method
+ * @param nIdx the method index
+ * @param nMethodType the kind of the method
+ * @return the method (NULL with an exception pending)
+ */
+static Method *
+ResolveMethod(const Method *pMethod, u4 nIdx, MethodType nMethodType) {
+
+	Method *method = dvmDexGetResolvedMethod(pMethod->clazz->pDvmDex, nIdx);
+
+	if(method == NULL) {
+		method = dvmResolveMethod(pMethod->clazz, nIdx, nMethodType);
+	}
+
+	return method;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Runtime Helper Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will return the frame of the interpreter for the running compiled
+ * method. The invoke bridge sets up the frame before it calls the compiled code, and
+ * dtc_push_frame does before a direct call from the compiled code.
+ *
+ * @return the frame of the method
+ */
+extern "C" u4 *
+dtc_frame(void) {
+
+	return dvmThreadSelf()->interpSave.curFrame;
+}
+
+/**
+ * This function will be called by the compiled code at a deoptimization point after
+ * the registers are stored into the given frame. It marks the save area of the frame
+ * with the dex pc to be resumed, and the interpreter resumes the method at the pc
+ * when the compiled code returns instead of taking the return value.
+ *
+ * @param pFp the frame of the method
+ * @param nPc the dex pc where the interpreter resumes
+ * @return the value returned by the compiled code, which is ignored
+ */
+extern "C" s8
+dtc_deoptimize(u4 *pFp, u4 nPc) {
+
+	StackSaveArea *saveArea = SAVEAREA_FROM_FP(pFp);
+
+	saveArea->xtra.currentPc = saveArea->method->insns + nPc;
+
+	DTC_TRACE(DEX2C_TAG, "dtc_deoptimize - %s resumes at 0x%04X", saveArea->method->name, nPc);
+
+	return 0;
+}
+
+/**
+ * This function will push the frame of a callee for a direct call from the compiled
+ * code, in the same layout as the interpreter pushes it. The arguments are passed in
+ * the C parameters, so the registers of the frame are stored only when the callee
+ * deoptimizes or calls a runtime helper.
+ *
+ * @param pFp the frame of the caller
+ * @param pCallee the callee
+ * @param nPc the dex pc of the invoke in the caller, where the interpreter returns to
+ * @return the frame of the callee (NULL if the stack would overflow)
+ */
+extern "C" u4 *
+dtc_push_frame(u4 *pFp, const Method *pCallee, u4 nPc) {
+
+	Thread *self = dvmThreadSelf();
+	StackSaveArea *saveArea = SAVEAREA_FROM_FP(pFp);
+
+	u4 *newFp = (u4 *)saveArea - pCallee->registersSize;
+	StackSaveArea *newSaveArea = SAVEAREA_FROM_FP(newFp);
+
+	// The invoke through the helper throws the StackOverflowError
+	if((u1 *)newSaveArea - pCallee->outsSize * sizeof(u4) < self->interpStackEnd) {
+		return NULL;
+	}
+
+	newSaveArea->prevFrame = pFp;
+	newSaveArea->savedPc = saveArea->method->insns + nPc;
+	newSaveArea->method = pCallee;
+	newSaveArea->xtra.currentPc = NULL;
+
+	self->interpSave.curFrame = newFp;
+
+	return newFp;
+}
+
+/**
+ * This function will pop the frame of a callee after a direct call from the compiled
+ * code. The frame is left on the stack if the callee has deoptimized, and the caller
+ * deoptimizes in turn, so the interpreter resumes the callee and returns to the caller
+ * at the invoke. Otherwise the result is also kept in the return value of the thread
+ * for a move-result executed by the helper.
+ *
+ * @param pFp the frame of the callee
+ * @param nResult the value returned by the callee
+ * @return 0 if the callee has returned, or nonzero if it has deoptimized
+ */
+extern "C" s4
+dtc_pop_frame(u4 *pFp, s8 nResult) {
+
+	StackSaveArea *saveArea = SAVEAREA_FROM_FP(pFp);
+
+	if(saveArea->xtra.currentPc != NULL) return 1;
+
+	Thread *self = dvmThreadSelf();
+
+	self->interpSave.retval.j = nResult;
+	self->interpSave.curFrame = saveArea->prevFrame;
+
+	return 0;
+}
+
+/**
+ * This function will execute the dex instruction at the given pc on the frame with
+ * the same semantics as the interpreter. The compiled code calls it for the instructions
+ * without any inline lowering, after it stores the registers used by the instruction into
+ * the frame, and loads the registers defined by the instruction from the frame after it.
+ * An instruction which cannot be completed, because it throws an exception or transfers
+ * the control, is left to the interpreter, which resumes at the instruction and throws the
+ * pending exception if any.
+ *
+ * @param pFp the frame of the method
+ * @param nPc the dex pc of the instruction
+ * @return 0 if the instruction is completed, or nonzero to leave it to the interpreter
+ */
+extern "C" s4
+dtc_execute(u4 *pFp, u4 nPc) {
+
+	Thread *self = dvmThreadSelf();
+	const Method *method = SAVEAREA_FROM_FP(pFp)->method;
+	const u2 *insns = method->insns + nPc;
+
+	DecodedInstruction dec;
+	dexDecodeInstruction(insns, &dec);
+
+	switch(dec.opcode) {
+
+		case OP_NOP:
+			return 0;
+
+		case OP_MOVE: case OP_MOVE_FROM16: case OP_MOVE_16:
+		case OP_MOVE_OBJECT: case OP_MOVE_OBJECT_FROM16: case OP_MOVE_OBJECT_16:
+			SET_REGISTER(dec.vA, GET_REGISTER(dec.vB));
+			return 0;
+
+		case OP_MOVE_WIDE: case OP_MOVE_WIDE_FROM16: case OP_MOVE_WIDE_16:
+			SetRegisterWide(pFp, dec.vA, GetRegisterWide(pFp, dec.vB));
+			return 0;
+
+		case OP_MOVE_RESULT:
+			SET_REGISTER(dec.vA, self->interpSave.retval.i);
+			return 0;
+
+		case OP_MOVE_RESULT_WIDE:
+			SetRegisterWide(pFp, dec.vA, self->interpSave.retval.j);
+			return 0;
+
+		case OP_MOVE_RESULT_OBJECT:
+			SET_REGISTER_AS_OBJECT(dec.vA, self->interpSave.retval.l);
+			return 0;
+
+		case OP_MOVE_EXCEPTION:
+			SET_REGISTER_AS_OBJECT(dec.vA, dvmGetException(self));
+			dvmClearException(self);
+			return 0;
+
+		case OP_CONST_4: case OP_CONST_16: case OP_CONST:
+			SET_REGISTER(dec.vA, dec.vB);
+			return 0;
+
+		case OP_CONST_HIGH16:
+			SET_REGISTER(dec.vA, dec.vB << 16);
+			return 0;
+
+		case OP_CONST_WIDE_16: case OP_CONST_WIDE_32:
+			SetRegisterWide(pFp, dec.vA, (s4)dec.vB);
+			return 0;
+
+		case OP_CONST_WIDE:
+			SetRegisterWide(pFp, dec.vA, (s8)dec.vB_wide);
+			return 0;
+
+		case OP_CONST_WIDE_HIGH16:
+			SetRegisterWide(pFp, dec.vA, ((s8)dec.vB) << 48);
+			return 0;
+
+		case OP_CONST_STRING: case OP_CONST_STRING_JUMBO: {
+
+			StringObject *str = dvmDexGetResolvedString(method->clazz->pDvmDex, dec.vB);
+
+			if(str == NULL && (str = dvmResolveString(method->clazz, dec.vB)) == NULL) return 1;
+
+			SET_REGISTER_AS_OBJECT(dec.vA, str);
+			return 0;
+		}
+
+		case OP_CONST_CLASS: {
+
+			ClassObject *clazz = ResolveClass(method, dec.vB, true);
+
+			if(clazz == NULL) return 1;
+
+			SET_REGISTER_AS_OBJECT(dec.vA, clazz);
+			return 0;
+		}
+
+		case OP_MONITOR_ENTER: {
+
+			Object *obj = GET_REGISTER_AS_OBJECT(dec.vA);
+
+			if(obj == NULL) {
+				dvmThrowNullPointerException(NULL);
+				return 1;
+			}
+
+			dvmLockObject(self, obj);
+			return 0;
+		}
+
+		case OP_MONITOR_EXIT: {
+
+			Object *obj = GET_REGISTER_AS_OBJECT(dec.vA);
+
+			if(obj == NULL) {
+				dvmThrowNullPointerException(NULL);
+				return 1;
+			}
+
+			return dvmUnlockObject(self, obj) ? 0 : 1;
+		}
+
+		case OP_CHECK_CAST: {
+
+			Object *obj = GET_REGISTER_AS_OBJECT(dec.vA);
+
+			if(obj == NULL) return 0;
+
+			ClassObject *clazz = ResolveClass(method, dec.vB, false);
+
+			if(clazz == NULL) return 1;
+
+			if(!dvmInstanceof(obj->clazz, clazz)) {
+				dvmThrowClassCastException(obj->clazz, clazz);
+				return 1;
+			}
+
+			return 0;
+		}
+
+		case OP_INSTANCE_OF: {
+
+			Object *obj = GET_REGISTER_AS_OBJECT(dec.vB);
+
+			if(obj == NULL) {
+				SET_REGISTER(dec.vA, 0);
+				return 0;
+			}
+
+			ClassObject *clazz = ResolveClass(method, dec.vC, true);
+
+			if(clazz == NULL) return 1;
+
+			SET_REGISTER(dec.vA, dvmInstanceof(obj->clazz, clazz));
+			return 0;
+		}
+
+		case OP_NEW_INSTANCE: {
+
+			ClassObject *clazz = ResolveClass(method, dec.vB, false);
+
+			if(clazz == NULL) return 1;
+
+			if(!dvmIsClassInitialized(clazz) && !dvmInitClass(clazz)) return 1;
+
+			if(dvmIsInterfaceClass(clazz) || dvmIsAbstractClass(clazz)) {
+				dvmThrowInstantiationException(clazz, NULL);
+				return 1;
+			}
+
+			Object *obj = dvmAllocObject(clazz, ALLOC_DONT_TRACK);
+
+			if(obj == NULL) return 1;
+
+			SET_REGISTER_AS_OBJECT(dec.vA, obj);
+			return 0;
+		}
+
+		case OP_NEW_ARRAY: {
+
+			s4 length = (s4)GET_REGISTER(dec.vB);
+
+			if(length < 0) {
+				dvmThrowNegativeArraySizeException(length);
+				return 1;
+			}
+
+			ClassObject *clazz = ResolveClass(method, dec.vC, false);
+
+			if(clazz == NULL) return 1;
+
+			ArrayObject *array = dvmAllocArrayByClass(clazz, length, ALLOC_DONT_TRACK);
+
+			if(array == NULL) return 1;
+
+			SET_REGISTER_AS_OBJECT(dec.vA, array);
+			return 0;
+		}
+
+		case OP_FILLED_NEW_ARRAY: case OP_FILLED_NEW_ARRAY_RANGE: {
+
+			ClassObject *clazz = ResolveClass(method, dec.vB, false);
+
+			if(clazz == NULL) return 1;
+
+			// Only the arrays of the int and reference types can be filled
+			char typeCh = clazz->descriptor[1];
+
+			if(typeCh == 'D' || typeCh == 'J') {
+				dvmThrowRuntimeException("bad filled array req");
+				return 1;
+			}
+			else if(typeCh != 'L' && typeCh != '[' && typeCh != 'I') {
+				dvmThrowInternalError("unsupported filled-new-array type");
+				return 1;
+			}
+
+			ArrayObject *array = dvmAllocArrayByClass(clazz, dec.vA, ALLOC_DONT_TRACK);
+
+			if(array == NULL) return 1;
+
+			u4 *contents = (u4 *)(void *)array->contents;
+
+			for(u4 i = 0; i < dec.vA; i++) {
+				contents[i] = GET_REGISTER((dec.opcode == OP_FILLED_NEW_ARRAY) ? dec.arg[i] : dec.vC + i);
+			}
+
+			self->interpSave.retval.l = (Object *)array;
+
+			if(typeCh == 'L' || typeCh == '[') {
+				dvmWriteBarrierArray(array, 0, array->length);
+			}
+
+			return 0;
+		}
+
+		case OP_FILL_ARRAY_DATA: {
+
+			const u2 *data = insns + (s4)dec.vB;
+
+			return dvmInterpHandleFillArrayData((ArrayObject *)GET_REGISTER_AS_OBJECT(dec.vA), data) ? 0 : 1;
+		}
+
+		case OP_THROW: {
+
+			Object *obj = GET_REGISTER_AS_OBJECT(dec.vA);
+
+			if(obj == NULL) {
+				dvmThrowNullPointerException(NULL);
+			}
+			else {
+				dvmSetException(self, obj);
+			}
+
+			return 1;
+		}
+
+		case OP_THROW_VERIFICATION_ERROR: {
+
+			dvmThrowVerificationError(method, dec.vA, dec.vB);
+			return 1;
+		}
+
+		case OP_ARRAY_LENGTH: {
+
+			ArrayObject *array = (ArrayObject *)GET_REGISTER_AS_OBJECT(dec.vB);
+
+			if(array == NULL) {
+				dvmThrowNullPointerException(NULL);
+				return 1;
+			}
+
+			SET_REGISTER(dec.vA, array->length);
+			return 0;
+		}
+
+		case OP_AGET: case OP_AGET_WIDE: case OP_AGET_OBJECT: case OP_AGET_BOOLEAN:
+		case OP_AGET_BYTE: case OP_AGET_CHAR: case OP_AGET_SHORT:
+		case OP_APUT: case OP_APUT_WIDE: case OP_APUT_OBJECT: case OP_APUT_BOOLEAN:
+		case OP_APUT_BYTE: case OP_APUT_CHAR: case OP_APUT_SHORT:
+			return ExecuteArray(pFp, dec);
+
+		case OP_IGET: case OP_IGET_WIDE: case OP_IGET_OBJECT: case OP_IGET_BOOLEAN:
+		case OP_IGET_BYTE: case OP_IGET_CHAR: case OP_IGET_SHORT:
+		case OP_IPUT: case OP_IPUT_WIDE: case OP_IPUT_OBJECT: case OP_IPUT_BOOLEAN:
+		case OP_IPUT_BYTE: case OP_IPUT_CHAR: case OP_IPUT_SHORT:
+		case OP_SGET: case OP_SGET_WIDE: case OP_SGET_OBJECT: case OP_SGET_BOOLEAN:
+		case OP_SGET_BYTE: case OP_SGET_CHAR: case OP_SGET_SHORT:
+		case OP_SPUT: case OP_SPUT_WIDE: case OP_SPUT_OBJECT: case OP_SPUT_BOOLEAN:
+		case OP_SPUT_BYTE: case OP_SPUT_CHAR: case OP_SPUT_SHORT:
+		case OP_IGET_VOLATILE: case OP_IGET_WIDE_VOLATILE: case OP_IGET_OBJECT_VOLATILE:
+		case OP_IPUT_VOLATILE: case OP_IPUT_WIDE_VOLATILE: case OP_IPUT_OBJECT_VOLATILE:
+		case OP_SGET_VOLATILE: case OP_SGET_WIDE_VOLATILE: case OP_SGET_OBJECT_VOLATILE:
+		case OP_SPUT_VOLATILE: case OP_SPUT_WIDE_VOLATILE: case OP_SPUT_OBJECT_VOLATILE:
+		case OP_IGET_QUICK: case OP_IGET_WIDE_QUICK: case OP_IGET_OBJECT_QUICK:
+		case OP_IPUT_QUICK: case OP_IPUT_WIDE_QUICK: case OP_IPUT_OBJECT_QUICK:
+			return ExecuteField(method, pFp, dec);
+
+		case OP_INVOKE_VIRTUAL: case OP_INVOKE_SUPER: case OP_INVOKE_DIRECT:
+		case OP_INVOKE_STATIC: case OP_INVOKE_INTERFACE:
+		case OP_INVOKE_VIRTUAL_RANGE: case OP_INVOKE_SUPER_RANGE: case OP_INVOKE_DIRECT_RANGE:
+		case OP_INVOKE_STATIC_RANGE: case OP_INVOKE_INTERFACE_RANGE:
+		case OP_INVOKE_VIRTUAL_QUICK: case OP_INVOKE_VIRTUAL_QUICK_RANGE:
+		case OP_INVOKE_SUPER_QUICK: case OP_INVOKE_SUPER_QUICK_RANGE:
+		case OP_INVOKE_OBJECT_INIT_RANGE:
+		case OP_EXECUTE_INLINE: case OP_EXECUTE_INLINE_RANGE:
+			return ExecuteInvoke(self, method, pFp, dec);
+
+		// The control transfers are lowered inline or left to the interpreter
+		case OP_RETURN_VOID: case OP_RETURN: case OP_RETURN_WIDE: case OP_RETURN_OBJECT:
+		case OP_RETURN_VOID_BARRIER:
+		case OP_GOTO: case OP_GOTO_16: case OP_GOTO_32:
+		case OP_PACKED_SWITCH: case OP_SPARSE_SWITCH:
+		case OP_IF_EQ: case OP_IF_NE: case OP_IF_LT: case OP_IF_GE: case OP_IF_GT: case OP_IF_LE:
+		case OP_IF_EQZ: case OP_IF_NEZ: case OP_IF_LTZ: case OP_IF_GEZ: case OP_IF_GTZ: case OP_IF_LEZ:
+		case OP_BREAKPOINT:
+			return 1;
+
+		default:
+			return ExecuteArith(pFp, dec);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will execute an arithmetic, a conversion, or a comparison instruction.
+ *
+ * @param pFp the frame of the method
+ * @param rDec the decoded instruction
+ * @return 0 if the instruction is completed, or nonzero to leave it to the interpreter
+ */
+static s4
+ExecuteArith(u4 *pFp, DecodedInstruction &rDec) {
+
+	Opcode op = rDec.opcode;
+
+	// The binary operations are ordered as add, sub, mul, div, rem, and, or, xor, shl, shr, ushr
+	typedef enum { ADD = 0, SUB, MUL, DIV, REM, AND, OR, XOR, SHL, SHR, USHR, RSUB } BinaryOp_t;
+
+	BinaryOp_t kind;
+	u4 lhs, rhs;
+	bool lit = false;
+
+	if(op >= OP_ADD_INT && op <= OP_REM_DOUBLE) {
+
+		// binop vA, vB, vC
+		lhs = rDec.vB;
+		rhs = rDec.vC;
+	}
+	else if(op >= OP_ADD_INT_2ADDR && op <= OP_REM_DOUBLE_2ADDR) {
+
+		// binop/2addr vA, vB
+		op = (Opcode)(op - OP_ADD_INT_2ADDR + OP_ADD_INT);
+		lhs = rDec.vA;
+		rhs = rDec.vB;
+	}
+	else if(op >= OP_ADD_INT_LIT16 && op <= OP_USHR_INT_LIT8) {
+
+		// binop/lit16 vA, vB, #+CCCC and binop/lit8 vA, vB, #+CC
+		const BinaryOp_t lit16Kinds[] = { ADD, RSUB, MUL, DIV, REM, AND, OR, XOR };
+		const BinaryOp_t lit8Kinds[] = { ADD, RSUB, MUL, DIV, REM, AND, OR, XOR, SHL, SHR, USHR };
+
+		kind = (op <= OP_XOR_INT_LIT16) ? lit16Kinds[op - OP_ADD_INT_LIT16] : lit8Kinds[op - OP_ADD_INT_LIT8];
+		op = OP_ADD_INT;
+		lhs = rDec.vB;
+		rhs = rDec.vC;
+		lit = true;
+	}
+	else {
+
+		switch(op) {
+
+			case OP_CMPL_FLOAT: case OP_CMPG_FLOAT: {
+
+				float x = GetRegisterFloat(pFp, rDec.vB), y = GetRegisterFloat(pFp, rDec.vC);
+				s4 nan = (op == OP_CMPL_FLOAT) ? -1 : 1;
+				SET_REGISTER(rDec.vA, (x < y) ? -1 : ((x > y) ? 1 : ((x == y) ? 0 : nan)));
+				return 0;
+			}
+
+			case OP_CMPL_DOUBLE: case OP_CMPG_DOUBLE: {
+
+				double x = GetRegisterDouble(pFp, rDec.vB), y = GetRegisterDouble(pFp, rDec.vC);
+				s4 nan = (op == OP_CMPL_DOUBLE) ? -1 : 1;
+				SET_REGISTER(rDec.vA, (x < y) ? -1 : ((x > y) ? 1 : ((x == y) ? 0 : nan)));
+				return 0;
+			}
+
+			case OP_CMP_LONG: {
+
+				s8 x = GetRegisterWide(pFp, rDec.vB), y = GetRegisterWide(pFp, rDec.vC);
+				SET_REGISTER(rDec.vA, (x < y) ? -1 : ((x > y) ? 1 : 0));
+				return 0;
+			}
+
+			case OP_NEG_INT:
+				SET_REGISTER(rDec.vA, -(s4)GET_REGISTER(rDec.vB));
+				return 0;
+			case OP_NOT_INT:
+				SET_REGISTER(rDec.vA, ~GET_REGISTER(rDec.vB));
+				return 0;
+			case OP_NEG_LONG:
+				SetRegisterWide(pFp, rDec.vA, -GetRegisterWide(pFp, rDec.vB));
+				return 0;
+			case OP_NOT_LONG:
+				SetRegisterWide(pFp, rDec.vA, ~GetRegisterWide(pFp, rDec.vB));
+				return 0;
+			case OP_NEG_FLOAT:
+				SetRegisterFloat(pFp, rDec.vA, -GetRegisterFloat(pFp, rDec.vB));
+				return 0;
+			case OP_NEG_DOUBLE:
+				SetRegisterDouble(pFp, rDec.vA, -GetRegisterDouble(pFp, rDec.vB));
+				return 0;
+			case OP_INT_TO_LONG:
+				SetRegisterWide(pFp, rDec.vA, (s4)GET_REGISTER(rDec.vB));
+				return 0;
+			case OP_INT_TO_FLOAT:
+				SetRegisterFloat(pFp, rDec.vA, (float)(s4)GET_REGISTER(rDec.vB));
+				return 0;
+			case OP_INT_TO_DOUBLE:
+				SetRegisterDouble(pFp, rDec.vA, (double)(s4)GET_REGISTER(rDec.vB));
+				return 0;
+			case OP_LONG_TO_INT:
+				SET_REGISTER(rDec.vA, (s4)GetRegisterWide(pFp, rDec.vB));
+				return 0;
+			case OP_LONG_TO_FLOAT:
+				SetRegisterFloat(pFp, rDec.vA, (float)GetRegisterWide(pFp, rDec.vB));
+				return 0;
+			case OP_LONG_TO_DOUBLE:
+				SetRegisterDouble(pFp, rDec.vA, (double)GetRegisterWide(pFp, rDec.vB));
+				return 0;
+			case OP_FLOAT_TO_INT:
+				SET_REGISTER(rDec.vA, ConvertToInteger(GetRegisterFloat(pFp, rDec.vB), 
+					(s4)0x80000000, (s4)0x7fffffff));
+				return 0;
+			case OP_FLOAT_TO_LONG:
+				SetRegisterWide(pFp, rDec.vA, ConvertToInteger(GetRegisterFloat(pFp, rDec.vB), 
+					(s8)0x8000000000000000ULL, (s8)0x7fffffffffffffffULL));
+				return 0;
+			case OP_FLOAT_TO_DOUBLE:
+				SetRegisterDouble(pFp, rDec.vA, (double)GetRegisterFloat(pFp, rDec.vB));
+				return 0;
+			case OP_DOUBLE_TO_INT:
+				SET_REGISTER(rDec.vA, ConvertToInteger(GetRegisterDouble(pFp, rDec.vB), 
+					(s4)0x80000000, (s4)0x7fffffff));
+				return 0;
+			case OP_DOUBLE_TO_LONG:
+				SetRegisterWide(pFp, rDec.vA, ConvertToInteger(GetRegisterDouble(pFp, rDec.vB), 
+					(s8)0x8000000000000000ULL, (s8)0x7fffffffffffffffULL));
+				return 0;
+			case OP_DOUBLE_TO_FLOAT:
+				SetRegisterFloat(pFp, rDec.vA, (float)GetRegisterDouble(pFp, rDec.vB));
+				return 0;
+			case OP_INT_TO_BYTE:
+				SET_REGISTER(rDec.vA, (s1)GET_REGISTER(rDec.vB));
+				return 0;
+			case OP_INT_TO_CHAR:
+				SET_REGISTER(rDec.vA, (u2)GET_REGISTER(rDec.vB));
+				return 0;
+			case OP_INT_TO_SHORT:
+				SET_REGISTER(rDec.vA, (s2)GET_REGISTER(rDec.vB));
+				return 0;
+
+			default:
+				return 1;
+		}
+	}
+
+	if(op >= OP_ADD_INT && op <= OP_USHR_INT) {
+
+		if(lit == false) kind = (BinaryOp_t)(op - OP_ADD_INT);
+
+		s4 x = (s4)GET_REGISTER(lhs);
+		s4 y = (lit == true) ? (s4)rhs : (s4)GET_REGISTER(rhs);
+		s4 result;
+
+		switch(kind) {
+			case ADD:	result = (s4)((u4)x + (u4)y);	break;
+			case SUB:	result = (s4)((u4)x - (u4)y);	break;
+			case RSUB:	result = (s4)((u4)y - (u4)x);	break;
+			case MUL:	result = (s4)((u4)x * (u4)y);	break;
+			case DIV:
+			case REM:
+				if(y == 0) {
+					dvmThrowArithmeticException("divide by zero");
+					return 1;
+				}
+				// The overflow of the minimum integer divided by -1 is defined in Java
+				if(x == (s4)0x80000000 && y == -1) {
+					result = (kind == DIV) ? x : 0;
+				}
+				else {
+					result = (kind == DIV) ? (x / y) : (x % y);
+				}
+				break;
+			case AND:	result = x & y;					break;
+			case OR:	result = x | y;					break;
+			case XOR:	result = x ^ y;					break;
+			case SHL:	result = (s4)((u4)x << (y & 0x1f));	break;
+			case SHR:	result = x >> (y & 0x1f);			break;
+			default:	result = (s4)((u4)x >> (y & 0x1f));	break;
+		}
+
+		SET_REGISTER(rDec.vA, result);
+		return 0;
+	}
+
+	if(op >= OP_ADD_LONG && op <= OP_USHR_LONG) {
+
+		kind = (BinaryOp_t)(op - OP_ADD_LONG);
+
+		s8 x = GetRegisterWide(pFp, lhs);
+		s8 result;
+
+		// The shift distance is an int
+		if(kind >= SHL) {
+
+			s4 y = (s4)GET_REGISTER(rhs) & 0x3f;
+
+			if(kind == SHL)			result = (s8)((u8)x << y);
+			else if(kind == SHR)	result = x >> y;
+			else					result = (s8)((u8)x >> y);
+
+			SetRegisterWide(pFp, rDec.vA, result);
+			return 0;
+		}
+
+		s8 y = GetRegisterWide(pFp, rhs);
+
+		switch(kind) {
+			case ADD:	result = (s8)((u8)x + (u8)y);	break;
+			case SUB:	result = (s8)((u8)x - (u8)y);	break;
+			case MUL:	result = (s8)((u8)x * (u8)y);	break;
+			case DIV:
+			case REM:
+				if(y == 0) {
+					dvmThrowArithmeticException("divide by zero");
+					return 1;
+				}
+				if(x == (s8)0x8000000000000000ULL && y == -1) {
+					result = (kind == DIV) ? x : 0;
+				}
+				else {
+					result = (kind == DIV) ? (x / y) : (x % y);
+				}
+				break;
+			case AND:	result = x & y;					break;
+			case OR:	result = x | y;					break;
+			default:	result = x ^ y;					break;
+		}
+
+		SetRegisterWide(pFp, rDec.vA, result);
+		return 0;
+	}
+
+	if(op >= OP_ADD_FLOAT && op <= OP_REM_FLOAT) {
+
+		float x = GetRegisterFloat(pFp, lhs), y = GetRegisterFloat(pFp, rhs), result;
+
+		switch(op - OP_ADD_FLOAT) {
+			case ADD:	result = x + y;				break;
+			case SUB:	result = x - y;				break;
+			case MUL:	result = x * y;				break;
+			case DIV:	result = x / y;				break;
+			default:	result = fmodf(x, y);		break;
+		}
+
+		SetRegisterFloat(pFp, rDec.vA, result);
+		return 0;
+	}
+
+	if(op >= OP_ADD_DOUBLE && op <= OP_REM_DOUBLE) {
+
+		double x = GetRegisterDouble(pFp, lhs), y = GetRegisterDouble(pFp, rhs), result;
+
+		switch(op - OP_ADD_DOUBLE) {
+			case ADD:	result = x + y;				break;
+			case SUB:	result = x - y;				break;
+			case MUL:	result = x * y;				break;
+			case DIV:	result = x / y;				break;
+			default:	result = fmod(x, y);		break;
+		}
+
+		SetRegisterDouble(pFp, rDec.vA, result);
+		return 0;
+	}
+
+	return 1;
+}
+
+/**
+ * This function will execute an array access instruction.
+ *
+ * @param pFp the frame of the method
+ * @param rDec the decoded instruction
+ * @return 0 if the instruction is completed, or nonzero to leave it to the interpreter
+ */
+static s4
+ExecuteArray(u4 *pFp, DecodedInstruction &rDec) {
+
+	ArrayObject *array = (ArrayObject *)GET_REGISTER_AS_OBJECT(rDec.vB);
+	u4 index = GET_REGISTER(rDec.vC);
+
+	if(array == NULL) {
+		dvmThrowNullPointerException(NULL);
+		return 1;
+	}
+
+	if(index >= array->length) {
+		dvmThrowArrayIndexOutOfBoundsException(array->length, index);
+		return 1;
+	}
+
+	void *contents = (void *)array->contents;
+
+	switch(rDec.opcode) {
+		case OP_AGET:			SET_REGISTER(rDec.vA, ((s4 *)contents)[index]);	return 0;
+		case OP_AGET_WIDE:		SetRegisterWide(pFp, rDec.vA, ((s8 *)contents)[index]);	return 0;
+		case OP_AGET_OBJECT:	SET_REGISTER(rDec.vA, ((u4 *)contents)[index]);	return 0;
+		case OP_AGET_BOOLEAN:	SET_REGISTER(rDec.vA, ((u1 *)contents)[index]);	return 0;
+		case OP_AGET_BYTE:		SET_REGISTER(rDec.vA, ((s1 *)contents)[index]);	return 0;
+		case OP_AGET_CHAR:		SET_REGISTER(rDec.vA, ((u2 *)contents)[index]);	return 0;
+		case OP_AGET_SHORT:		SET_REGISTER(rDec.vA, ((s2 *)contents)[index]);	return 0;
+
+		case OP_APUT:			((s4 *)contents)[index] = GET_REGISTER(rDec.vA);	return 0;
+		case OP_APUT_WIDE:		((s8 *)contents)[index] = GetRegisterWide(pFp, rDec.vA);	return 0;
+		case OP_APUT_BOOLEAN:	((u1 *)contents)[index] = GET_REGISTER(rDec.vA);	return 0;
+		case OP_APUT_BYTE:		((s1 *)contents)[index] = GET_REGISTER(rDec.vA);	return 0;
+		case OP_APUT_CHAR:		((u2 *)contents)[index] = GET_REGISTER(rDec.vA);	return 0;
+		case OP_APUT_SHORT:		((s2 *)contents)[index] = GET_REGISTER(rDec.vA);	return 0;
+
+		case OP_APUT_OBJECT: {
+
+			Object *obj = GET_REGISTER_AS_OBJECT(rDec.vA);
+
+			if(obj != NULL && !dvmCanPutArrayElement(obj->clazz, array->clazz)) {
+				dvmThrowArrayStoreExceptionIncompatibleElement(obj->clazz, array->clazz);
+				return 1;
+			}
+
+			dvmSetObjectArrayElement(array, index, obj);
+			return 0;
+		}
+
+		default:
+			return 1;
+	}
+}
+
+/**
+ * This function will execute an instance or a static field access instruction.
+ *
+ * @param pMethod the method running the instruction
+ * @param pFp the frame of the method
+ * @param rDec the decoded instruction
+ * @return 0 if the instruction is completed, or nonzero to leave it to the interpreter
+ */
+static s4
+ExecuteField(const Method *pMethod, u4 *pFp, DecodedInstruction &rDec) {
+
+	DvmDex *dvmDex = pMethod->clazz->pDvmDex;
+
+	switch(rDec.opcode) {
+
+		case OP_SGET: case OP_SGET_WIDE: case OP_SGET_OBJECT: case OP_SGET_BOOLEAN:
+		case OP_SGET_BYTE: case OP_SGET_CHAR: case OP_SGET_SHORT:
+		case OP_SPUT: case OP_SPUT_WIDE: case OP_SPUT_OBJECT: case OP_SPUT_BOOLEAN:
+		case OP_SPUT_BYTE: case OP_SPUT_CHAR: case OP_SPUT_SHORT:
+		case OP_SGET_VOLATILE: case OP_SGET_WIDE_VOLATILE: case OP_SGET_OBJECT_VOLATILE:
+		case OP_SPUT_VOLATILE: case OP_SPUT_WIDE_VOLATILE: case OP_SPUT_OBJECT_VOLATILE: {
+
+			StaticField *field = (StaticField *)dvmDexGetResolvedField(dvmDex, rDec.vB);
+
+			if(field == NULL && (field = dvmResolveStaticField(pMethod->clazz, rDec.vB)) == NULL) {
+				return 1;
+			}
+
+			switch(rDec.opcode) {
+				case OP_SGET:					SET_REGISTER(rDec.vA, dvmGetStaticFieldInt(field));	break;
+				case OP_SGET_WIDE:				SetRegisterWide(pFp, rDec.vA, dvmGetStaticFieldLong(field));	break;
+				case OP_SGET_OBJECT:			SET_REGISTER_AS_OBJECT(rDec.vA, dvmGetStaticFieldObject(field));	break;
+				case OP_SGET_BOOLEAN:			SET_REGISTER(rDec.vA, dvmGetStaticFieldBoolean(field));	break;
+				case OP_SGET_BYTE:				SET_REGISTER(rDec.vA, dvmGetStaticFieldByte(field));	break;
+				case OP_SGET_CHAR:				SET_REGISTER(rDec.vA, dvmGetStaticFieldChar(field));	break;
+				case OP_SGET_SHORT:				SET_REGISTER(rDec.vA, dvmGetStaticFieldShort(field));	break;
+				case OP_SGET_VOLATILE:			SET_REGISTER(rDec.vA, dvmGetStaticFieldIntVolatile(field));	break;
+				case OP_SGET_WIDE_VOLATILE:		SetRegisterWide(pFp, rDec.vA, dvmGetStaticFieldLongVolatile(field));	break;
+				case OP_SGET_OBJECT_VOLATILE:	SET_REGISTER_AS_OBJECT(rDec.vA, dvmGetStaticFieldObjectVolatile(field));	break;
+				case OP_SPUT:					dvmSetStaticFieldInt(field, GET_REGISTER(rDec.vA));	break;
+				case OP_SPUT_WIDE:				dvmSetStaticFieldLong(field, GetRegisterWide(pFp, rDec.vA));	break;
+				case OP_SPUT_OBJECT:			dvmSetStaticFieldObject(field, GET_REGISTER_AS_OBJECT(rDec.vA));	break;
+				case OP_SPUT_BOOLEAN:			dvmSetStaticFieldBoolean(field, GET_REGISTER(rDec.vA));	break;
+				case OP_SPUT_BYTE:				dvmSetStaticFieldByte(field, GET_REGISTER(rDec.vA));	break;
+				case OP_SPUT_CHAR:				dvmSetStaticFieldChar(field, GET_REGISTER(rDec.vA));	break;
+				case OP_SPUT_SHORT:				dvmSetStaticFieldShort(field, GET_REGISTER(rDec.vA));	break;
+				case OP_SPUT_VOLATILE:			dvmSetStaticFieldIntVolatile(field, GET_REGISTER(rDec.vA));	break;
+				case OP_SPUT_WIDE_VOLATILE:		dvmSetStaticFieldLongVolatile(field, GetRegisterWide(pFp, rDec.vA));	break;
+				default:						dvmSetStaticFieldObjectVolatile(field, GET_REGISTER_AS_OBJECT(rDec.vA));	break;
+			}
+
+			return 0;
+		}
+
+		default:
+			break;
+	}
+
+	// The quickened instructions have the byte offset of the field instead of the field index
+	int offset;
+
+	switch(rDec.opcode) {
+
+		case OP_IGET_QUICK: case OP_IGET_WIDE_QUICK: case OP_IGET_OBJECT_QUICK:
+		case OP_IPUT_QUICK: case OP_IPUT_WIDE_QUICK: case OP_IPUT_OBJECT_QUICK: {
+
+			offset = rDec.vC;
+			break;
+		}
+
+		default: {
+
+			InstField *field = (InstField *)dvmDexGetResolvedField(dvmDex, rDec.vC);
+
+			if(field == NULL && (field = dvmResolveInstField(pMethod->clazz, rDec.vC)) == NULL) {
+				return 1;
+			}
+
+			offset = field->byteOffset;
+			break;
+		}
+	}
+
+	Object *obj = GET_REGISTER_AS_OBJECT(rDec.vB);
+
+	if(obj == NULL) {
+		dvmThrowNullPointerException(NULL);
+		return 1;
+	}
+
+	switch(rDec.opcode) {
+		case OP_IGET: case OP_IGET_QUICK:		SET_REGISTER(rDec.vA, dvmGetFieldInt(obj, offset));	break;
+		case OP_IGET_WIDE: case OP_IGET_WIDE_QUICK:	SetRegisterWide(pFp, rDec.vA, dvmGetFieldLong(obj, offset));	break;
+		case OP_IGET_OBJECT: case OP_IGET_OBJECT_QUICK:	SET_REGISTER_AS_OBJECT(rDec.vA, dvmGetFieldObject(obj, offset));	break;
+		case OP_IGET_BOOLEAN:					SET_REGISTER(rDec.vA, dvmGetFieldBoolean(obj, offset));	break;
+		case OP_IGET_BYTE:						SET_REGISTER(rDec.vA, dvmGetFieldByte(obj, offset));	break;
+		case OP_IGET_CHAR:						SET_REGISTER(rDec.vA, dvmGetFieldChar(obj, offset));	break;
+		case OP_IGET_SHORT:						SET_REGISTER(rDec.vA, dvmGetFieldShort(obj, offset));	break;
+		case OP_IGET_VOLATILE:					SET_REGISTER(rDec.vA, dvmGetFieldIntVolatile(obj, offset));	break;
+		case OP_IGET_WIDE_VOLATILE:				SetRegisterWide(pFp, rDec.vA, dvmGetFieldLongVolatile(obj, offset));	break;
+		case OP_IGET_OBJECT_VOLATILE:			SET_REGISTER_AS_OBJECT(rDec.vA, dvmGetFieldObjectVolatile(obj, offset));	break;
+		case OP_IPUT: case OP_IPUT_QUICK:		dvmSetFieldInt(obj, offset, GET_REGISTER(rDec.vA));	break;
+		case OP_IPUT_WIDE: case OP_IPUT_WIDE_QUICK:	dvmSetFieldLong(obj, offset, GetRegisterWide(pFp, rDec.vA));	break;
+		case OP_IPUT_OBJECT: case OP_IPUT_OBJECT_QUICK:	dvmSetFieldObject(obj, offset, GET_REGISTER_AS_OBJECT(rDec.vA));	break;
+		case OP_IPUT_BOOLEAN:					dvmSetFieldBoolean(obj, offset, GET_REGISTER(rDec.vA));	break;
+		case OP_IPUT_BYTE:						dvmSetFieldByte(obj, offset, GET_REGISTER(rDec.vA));	break;
+		case OP_IPUT_CHAR:						dvmSetFieldChar(obj, offset, GET_REGISTER(rDec.vA));	break;
+		case OP_IPUT_SHORT:						dvmSetFieldShort(obj, offset, GET_REGISTER(rDec.vA));	break;
+		case OP_IPUT_VOLATILE:					dvmSetFieldIntVolatile(obj, offset, GET_REGISTER(rDec.vA));	break;
+		case OP_IPUT_WIDE_VOLATILE:				dvmSetFieldLongVolatile(obj, offset, GetRegisterWide(pFp, rDec.vA));	break;
+		default:								dvmSetFieldObjectVolatile(obj, offset, GET_REGISTER_AS_OBJECT(rDec.vA));	break;
+	}
+
+	return 0;
+}
+
+/**
+ * This function will execute an invoke instruction. The callee is called through the
+ * interpreter stack on top of the frame of the method, and the result is kept in the
+ * thread for the following move-result like the interpreter.
+ *
+ * @param pSelf the running thread
+ * @param pMethod the method running the instruction
+ * @param pFp the frame of the method
+ * @param rDec the decoded instruction
+ * @return 0 if the instruction is completed, or nonzero to leave it to the interpreter
+ */
+static s4
+ExecuteInvoke(Thread *pSelf, const Method *pMethod, u4 *pFp, DecodedInstruction &rDec) {
+
+	bool range;
+
+	switch(rDec.opcode) {
+		case OP_INVOKE_VIRTUAL_RANGE: case OP_INVOKE_SUPER_RANGE: case OP_INVOKE_DIRECT_RANGE:
+		case OP_INVOKE_STATIC_RANGE: case OP_INVOKE_INTERFACE_RANGE:
+		case OP_INVOKE_VIRTUAL_QUICK_RANGE: case OP_INVOKE_SUPER_QUICK_RANGE:
+		case OP_INVOKE_OBJECT_INIT_RANGE: case OP_EXECUTE_INLINE_RANGE:
+			range = true;
+			break;
+		default:
+			range = false;
+			break;
+	}
+
+	// The registers of the arguments
+	u4 regs[256];
+
+	for(u4 i = 0; i < rDec.vA; i++) {
+		regs[i] = (range == true) ? (rDec.vC + i) : rDec.arg[i];
+	}
+
+	if(rDec.opcode == OP_EXECUTE_INLINE || rDec.opcode == OP_EXECUTE_INLINE_RANGE) {
+
+		u4 args[4] = { 0, 0, 0, 0 };
+
+		for(u4 i = 0; i < rDec.vA && i < 4; i++) {
+			args[i] = GET_REGISTER(regs[i]);
+		}
+
+		return dvmPerformInlineOp4Std(args[0], args[1], args[2], args[3], 
+			&pSelf->interpSave.retval, rDec.vB) ? 0 : 1;
+	}
+
+	Object *thisPtr = (rDec.opcode == OP_INVOKE_STATIC || rDec.opcode == OP_INVOKE_STATIC_RANGE) ? 
+		NULL : GET_REGISTER_AS_OBJECT(regs[0]);
+
+	if(rDec.opcode == OP_INVOKE_OBJECT_INIT_RANGE) {
+
+		// Object.<init> does nothing but marking a finalizable object
+		if(thisPtr != NULL && IS_CLASS_FLAG_SET(thisPtr->clazz, CLASS_ISFINALIZABLE)) {
+			dvmSetFinalizable(thisPtr);
+		}
+
+		return (dvmCheckException(pSelf)) ? 1 : 0;
+	}
+
+	Method *callee = NULL;
+
+	switch(rDec.opcode) {
+
+		case OP_INVOKE_STATIC: case OP_INVOKE_STATIC_RANGE: {
+
+			if((callee = ResolveMethod(pMethod, rDec.vB, METHOD_STATIC)) == NULL) return 1;
+			break;
+		}
+
+		case OP_INVOKE_DIRECT: case OP_INVOKE_DIRECT_RANGE: {
+
+			if((callee = ResolveMethod(pMethod, rDec.vB, METHOD_DIRECT)) == NULL) return 1;
+			break;
+		}
+
+		case OP_INVOKE_VIRTUAL: case OP_INVOKE_VIRTUAL_RANGE: {
+
+			Method *base = ResolveMethod(pMethod, rDec.vB, METHOD_VIRTUAL);
+
+			if(base == NULL) return 1;
+			if(thisPtr == NULL) break;
+
+			callee = thisPtr->clazz->vtable[base->methodIndex];
+			break;
+		}
+
+		case OP_INVOKE_SUPER: case OP_INVOKE_SUPER_RANGE: {
+
+			Method *base = ResolveMethod(pMethod, rDec.vB, METHOD_VIRTUAL);
+
+			if(base == NULL) return 1;
+
+			if(base->methodIndex >= pMethod->clazz->super->vtableCount) {
+				dvmThrowNoSuchMethodError(base->name);
+				return 1;
+			}
+
+			callee = pMethod->clazz->super->vtable[base->methodIndex];
+			break;
+		}
+
+		case OP_INVOKE_INTERFACE: case OP_INVOKE_INTERFACE_RANGE: {
+
+			if(thisPtr == NULL) break;
+
+			callee = dvmFindInterfaceMethodInCache(thisPtr->clazz, rDec.vB, pMethod, 
+				pMethod->clazz->pDvmDex);
+
+			if(callee == NULL) return 1;
+			break;
+		}
+
+		case OP_INVOKE_VIRTUAL_QUICK: case OP_INVOKE_VIRTUAL_QUICK_RANGE: {
+
+			if(thisPtr == NULL) break;
+
+			callee = thisPtr->clazz->vtable[rDec.vB];
+			break;
+		}
+
+		default: {
+
+			// invoke-super-quick
+			callee = pMethod->clazz->super->vtable[rDec.vB];
+			break;
+		}
+	}
+
+	if(callee == NULL || (thisPtr == NULL && !dvmIsStaticMethod(callee))) {
+		dvmThrowNullPointerException(NULL);
+		return 1;
+	}
+
+	if(dvmIsAbstractMethod(callee)) {
+		dvmThrowAbstractMethodError(callee->name);
+		return 1;
+	}
+
+	// The arguments following the receiver are passed in the order of the shorty
+	jvalue args[256];
+	u4 reg = (thisPtr != NULL) ? 1 : 0;
+	u4 nargs = 0;
+
+	for(const char *shorty = callee->shorty + 1; *shorty != '\0'; shorty++, nargs++) {
+
+		switch(*shorty) {
+			case 'J': args[nargs].j = GetRegisterWide(pFp, regs[reg]);		reg += 2;	break;
+			case 'D': args[nargs].d = GetRegisterDouble(pFp, regs[reg]);	reg += 2;	break;
+			case 'F': args[nargs].f = GetRegisterFloat(pFp, regs[reg]);		reg += 1;	break;
+			case 'L': args[nargs].l = (jobject)GET_REGISTER_AS_OBJECT(regs[reg]);	reg += 1;	break;
+			case 'Z': args[nargs].z = (jboolean)GET_REGISTER(regs[reg]);	reg += 1;	break;
+			case 'B': args[nargs].b = (jbyte)GET_REGISTER(regs[reg]);		reg += 1;	break;
+			case 'C': args[nargs].c = (jchar)GET_REGISTER(regs[reg]);		reg += 1;	break;
+			case 'S': args[nargs].s = (jshort)GET_REGISTER(regs[reg]);		reg += 1;	break;
+			default:  args[nargs].i = (jint)GET_REGISTER(regs[reg]);		reg += 1;	break;
+		}
+	}
+
+	JValue result;
+
+	dvmCallMethodA(pSelf, callee, thisPtr, false, &result, args);
+
+	pSelf->interpSave.retval = result;
+
+	return (dvmCheckException(pSelf)) ? 1 : 0;
+}
@@ -0,0 +1,36 @@
+/*********************************************************************
+*   DtcRuntime.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_RUNTIME_H_
+#define _DTC_RUNTIME_H_
+
+#include "DtcCommon.h"
+
+///////////////////////////////////////////////////////////////////////
+// Runtime Helper Declaration
+///////////////////////////////////////////////////////////////////////
+
+/*
+ * The helpers called by the compiled code, which are looked up by the dynamic
+ * linker when the compiled code is loaded.
+ */
+extern "C" u4 *dtc_frame(void);
+
+extern "C" s8 dtc_deoptimize(u4 *pFp, u4 nPc);
+
+extern "C" s4 dtc_execute(u4 *pFp, u4 nPc);
+
+extern "C" u4 *dtc_push_frame(u4 *pFp, const Method *pCallee, u4 nPc);
+
+extern "C" s4 dtc_pop_frame(u4 *pFp, s8 nResult);
+
+#endif
@@ -0,0 +1,303 @@
+/*********************************************************************
+*   DtcStats.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "DtcStats.h"
+
+///////////////////////////////////////////////////////////////////////
+// Static Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+// The key of the statistics bound to each thread
+static pthread_key_t s_nStatsKey;
+static pthread_once_t s_nStatsKeyOnce = PTHREAD_ONCE_INIT;
+
+// The list of the statistics of all the threads
+static DtcStats * volatile s_pStatsList = NULL;
+
+// The names of the phases
+static const char *s_pPhaseNames[NUM_OF_DTC_PHASES] = {
+	"resolve-locals",
+	"resolve-blocks",
+	"resolve-dexcodes",
+	"analyse-liveness",
+	"translate",
+	"emit",
+	"backend",
+	"load",
+};
+
+// The time the VM is loaded, and the time the first compiled method is installed
+static uint64_t s_nLoadNs = DtcStats::GetTime();
+static volatile uint64_t s_nFirstInstallNs = 0;
+
+// The number of the installed methods
+static volatile uint32_t s_nInstalls = 0;
+
+static void
+SumPhases(DtcPhaseStats_t *pTotal);
+
+static void
+CreateStatsKey() {
+
+	pthread_key_create(&s_nStatsKey, NULL);
+}
+
+///////////////////////////////////////////////////////////////////////
+// Constructor & Destructor Definition
+///////////////////////////////////////////////////////////////////////
+
+DtcStats::DtcStats() {
+
+	memset(m_pPhases, 0, sizeof(m_pPhases));
+	memset(m_pRecords, 0, sizeof(m_pRecords));
+
+	m_nRecords = 0;
+
+	m_nThreadId = (pid_t)syscall(__NR_gettid);
+
+	m_pNext = NULL;
+}
+
+DtcStats::~DtcStats() {
+}
+
+///////////////////////////////////////////////////////////////////////
+// Member Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will return the statistics of the calling thread. The statistics are
+ * made on the first call of the thread and pushed to the global list.
+ *
+ * @return the statistics of the calling thread
+ */
+DtcStats *
+DtcStats::GetCurrent() {
+
+	pthread_once(&s_nStatsKeyOnce, CreateStatsKey);
+
+	DtcStats *stats = (DtcStats *)pthread_getspecific(s_nStatsKey);
+
+	if(stats != NULL) return stats;
+
+	stats = new DtcStats();
+
+	// The block is complete before it is published to the dumper
+	do {
+		stats->m_pNext = s_pStatsList;
+	} while(!__sync_bool_compare_and_swap(&s_pStatsList, stats->m_pNext, stats));
+
+	pthread_setspecific(s_nStatsKey, stats);
+
+	return stats;
+}
+
+/**
+ * This function will return the current time of the monotonic clock.
+ *
+ * @return the time in nanoseconds
+ */
+uint64_t
+DtcStats::GetTime() {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/**
+ * This function will add a sample of the given phase, which started at the given time
+ * and ends now.
+ *
+ * @param nPhase the phase
+ * @param nStart the start time of the phase in nanoseconds
+ */
+void
+DtcStats::AddPhase(DtcPhase_t nPhase, uint64_t nStart) {
+
+	uint64_t elapsed = GetTime() - nStart;
+	uint32_t us = (uint32_t)(elapsed / 1000);
+	uint32_t bucket = 0;
+
+	while(us > 0 && bucket < DTC_STATS_BUCKETS - 1) {
+		us >>= 1;
+		bucket++;
+	}
+
+	DtcPhaseStats_t &phase = m_pPhases[nPhase];
+
+	phase.nTotalNs += elapsed;
+	phase.nCount++;
+	phase.pHistogram[bucket]++;
+}
+
+/**
+ * This function will record the outcome of a compiled method in the ring of the latest
+ * methods.
+ *
+ * @param pMethod the compiled method
+ * @param nInsns the number of the dex code units
+ * @param nBlocks the number of the basic blocks
+ * @param nBytes the number of the bytes emitted
+ * @param bNative whether the machine code is emitted directly
+ */
+void
+DtcStats::AddMethod(const Method *pMethod, uint32_t nInsns, uint32_t nBlocks, uint32_t nBytes,
+	bool_t bNative) {
+
+	DtcMethodRecord_t &record = m_pRecords[m_nRecords % DTC_STATS_RECORDS];
+
+	record.pMethod = pMethod;
+	record.nInsns = nInsns;
+	record.nBlocks = nBlocks;
+	record.nBytes = nBytes;
+	record.bNative = bNative;
+
+	m_nRecords++;
+}
+
+/**
+ * This function will print out the aggregated time of the phases over all the threads,
+ * and the latest methods of each thread.
+ */
+void
+DtcStats::Dump() {
+
+	DtcPhaseStats_t total[NUM_OF_DTC_PHASES];
+	DtcStats *stats;
+
+	SumPhases(total);
+
+	DtcDebugPrintln(DEX2C_TAG, "Compile statistics (phase: count, total us, mean us, log2 us histogram)");
+
+	for(uint32_t i = 0; i < NUM_OF_DTC_PHASES; i++) {
+
+		char buf[BUF_LEN];
+		uint32_t len = 0;
+
+		if(total[i].nCount == 0) continue;
+
+		for(uint32_t j = 0; j < DTC_STATS_BUCKETS && len < sizeof(buf); j++) {
+			len += snprintf(buf + len, sizeof(buf) - len, " %u", total[i].pHistogram[j]);
+		}
+
+		DtcDebugPrintln(DEX2C_TAG, "  %-16s: %u, %llu, %llu,%s", s_pPhaseNames[i], total[i].nCount,
+			(unsigned long long)(total[i].nTotalNs / 1000),
+			(unsigned long long)(total[i].nTotalNs / 1000 / total[i].nCount), buf);
+	}
+
+	for(stats = s_pStatsList; stats != NULL; stats = stats->m_pNext) {
+
+		uint32_t count = (stats->m_nRecords < DTC_STATS_RECORDS) ? stats->m_nRecords : DTC_STATS_RECORDS;
+
+		DtcDebugPrintln(DEX2C_TAG, "Thread %d - %u methods compiled", stats->m_nThreadId, stats->m_nRecords);
+
+		for(uint32_t i = 0; i < count; i++) {
+
+			DtcMethodRecord_t &record = stats->m_pRecords[(stats->m_nRecords - 1 - i) % DTC_STATS_RECORDS];
+
+			DtcDebugPrintln(DEX2C_TAG, "  %s.%s: %u insns, %u blocks, %u bytes (%s)",
+				(record.pMethod != NULL) ? record.pMethod->clazz->descriptor : "?",
+				(record.pMethod != NULL) ? record.pMethod->name : "?",
+				record.nInsns, record.nBlocks, record.nBytes, record.bNative ? "native" : "C");
+		}
+	}
+}
+
+/**
+ * This function will count an installed method, and keep the time of the first one.
+ * It is called on the compiler threads only after the code of the method is published.
+ */
+void
+DtcStats::AddInstall() {
+
+	__sync_fetch_and_add(&s_nInstalls, 1);
+
+	__sync_bool_compare_and_swap(&s_nFirstInstallNs, 0, GetTime());
+}
+
+/**
+ * This function will print out a one-line summary of the compilations to the standard
+ * error, which the end-to-end benchmark reads from each run. The time of the first
+ * installed method is taken from the time the VM is loaded, and the compile overhead
+ * is the total time of all the phases over all the threads.
+ */
+void
+DtcStats::Report() {
+
+	DtcPhaseStats_t total[NUM_OF_DTC_PHASES];
+	uint64_t compileNs = 0;
+	uint64_t firstNs = s_nFirstInstallNs;
+
+	SumPhases(total);
+
+	// The blocks analysed by the pool are counted on each helping thread, so the
+	// overhead is the time of the processors rather than the elapsed time
+	for(uint32_t i = 0; i < NUM_OF_DTC_PHASES; i++) {
+		compileNs += total[i].nTotalNs;
+	}
+
+	fprintf(stderr, "dex2c-report: installs=%u first-install-us=%lld compile-us=%llu\n",
+		s_nInstalls, (firstNs != 0) ? (long long)((firstNs - s_nLoadNs) / 1000) : -1LL,
+		(unsigned long long)(compileNs / 1000));
+}
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will sum up the time of the phases over all the threads.
+ *
+ * @param pTotal the time of the phases to be filled
+ */
+static void
+SumPhases(DtcPhaseStats_t *pTotal) {
+
+	memset(pTotal, 0, sizeof(DtcPhaseStats_t) * NUM_OF_DTC_PHASES);
+
+	for(DtcStats *stats = s_pStatsList; stats != NULL; stats = stats->GetNext()) {
+
+		for(uint32_t i = 0; i < NUM_OF_DTC_PHASES; i++) {
+
+			const DtcPhaseStats_t &phase = stats->GetPhase((DtcPhase_t)i);
+
+			pTotal[i].nTotalNs += phase.nTotalNs;
+			pTotal[i].nCount += phase.nCount;
+
+			for(uint32_t j = 0; j < DTC_STATS_BUCKETS; j++) {
+				pTotal[i].pHistogram[j] += phase.pHistogram[j];
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////
+// Global Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will print out the compile statistics on demand. The signal catcher
+ * calls it on SIGQUIT next to the statistics of the trace JIT.
+ */
+extern "C" void
+dtcDumpCompileStats(void) {
+
+	DtcStats::Dump();
+}
@@ -0,0 +1,182 @@
+/*********************************************************************
+*   DtcStats.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_STATS_H_
+#define _DTC_STATS_H_
+
+#include "DtcCommon.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// The number of the histogram buckets, where the bucket i counts the samples taking
+// [2^(i-1), 2^i) microseconds and the last bucket counts all the longer ones
+#define DTC_STATS_BUCKETS			16
+
+// The number of the latest methods recorded by each thread
+#define DTC_STATS_RECORDS			64
+
+// The phases of a compilation
+typedef enum {
+	DTC_PHASE_RESOLVE_LOCALS = 0,
+	DTC_PHASE_RESOLVE_BLOCKS,
+	DTC_PHASE_RESOLVE_DEXCODES,
+	DTC_PHASE_ANALYSE_LIVENESS,
+	DTC_PHASE_TRANSLATE,
+	DTC_PHASE_EMIT,
+	DTC_PHASE_BACKEND,
+	DTC_PHASE_LOAD,
+	NUM_OF_DTC_PHASES
+} DtcPhase_t;
+
+// The time spent in a phase
+typedef struct {
+
+	// The total time in nanoseconds and the number of the samples
+	uint64_t nTotalNs;
+	uint32_t nCount;
+
+	// The samples by their time in log2 microseconds
+	uint32_t pHistogram[DTC_STATS_BUCKETS];
+
+} DtcPhaseStats_t;
+
+// The outcome of a compiled method
+typedef struct {
+
+	// The compiled method (NULL for the methods of a dex file)
+	const Method *pMethod;
+
+	// The number of the dex code units and the basic blocks
+	uint32_t nInsns;
+	uint32_t nBlocks;
+
+	// The number of the bytes emitted for the method (C source or machine code)
+	uint32_t nBytes;
+
+	// Whether the machine code is emitted directly
+	bool_t bNative;
+
+} DtcMethodRecord_t;
+
+///////////////////////////////////////////////////////////////////////
+// DtcStats Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * The statistics of the compilations on a thread. Each compiling thread owns a block
+ * which only the thread writes, so the phases are counted without any lock. The blocks
+ * are linked into a global list when they are made and never released, so the dumper
+ * can walk them at any time while the compilers are running. A sample read by the
+ * dumper in the middle of an update may be off by one, which is fine for statistics.
+ */
+class DtcStats {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The time spent in each phase
+	DtcPhaseStats_t m_pPhases[NUM_OF_DTC_PHASES];
+
+	// The ring of the latest methods, and the number of the methods ever recorded
+	DtcMethodRecord_t m_pRecords[DTC_STATS_RECORDS];
+	uint32_t m_nRecords;
+
+	// The thread owning the block
+	pid_t m_nThreadId;
+
+	// The next block in the global list
+	DtcStats *m_pNext;
+
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcStats();
+
+	virtual ~DtcStats();
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the time spent by the thread in the given phase.
+	 *
+	 * @param nPhase the phase
+	 * @return the time of the phase
+	 */
+	inline const DtcPhaseStats_t &GetPhase(DtcPhase_t nPhase)	{ return m_pPhases[nPhase];	}
+
+	/**
+	 * This function will return the statistics of the next thread in the global list.
+	 *
+	 * @return the next statistics, or NULL at the end of the list
+	 */
+	inline DtcStats *GetNext()									{ return m_pNext;			}
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	static DtcStats *GetCurrent();
+
+	static uint64_t GetTime();
+
+	void AddPhase(DtcPhase_t nPhase, uint64_t nStart);
+
+	void AddMethod(const Method *pMethod, uint32_t nInsns, uint32_t nBlocks, uint32_t nBytes,
+		bool_t bNative);
+
+	static void Dump();
+
+	static void AddInstall();
+
+	static void Report();
+};
+
+///////////////////////////////////////////////////////////////////////
+// Global Function Declaration
+///////////////////////////////////////////////////////////////////////
+
+extern "C" void dtcDumpCompileStats(void);
+
+///////////////////////////////////////////////////////////////////////
+// Interface Macros for the Compile Statistics
+///////////////////////////////////////////////////////////////////////
+
+#if defined(DTC_ENABLE_STATS)
+
+#define DTC_PHASE_BEGIN(PHASE)		uint64_t __dtcPhase##PHASE = DtcStats::GetTime()
+#define DTC_PHASE_END(PHASE)			DtcStats::GetCurrent()->AddPhase(DTC_PHASE_##PHASE, __dtcPhase##PHASE)
+
+#define DTC_METHOD_RECORD(METHOD, INSNS, BLOCKS, BYTES, NATIVE)	\
+	DtcStats::GetCurrent()->AddMethod(METHOD, INSNS, BLOCKS, BYTES, NATIVE)
+
+#define DTC_INSTALL_RECORD()		DtcStats::AddInstall()
+
+#else
+
+#define DTC_PHASE_BEGIN(PHASE)		//
+#define DTC_PHASE_END(PHASE)			//
+
+#define DTC_METHOD_RECORD(METHOD, INSNS, BLOCKS, BYTES, NATIVE)	//
+
+#define DTC_INSTALL_RECORD()		//
+
+#endif
+
+#endif
@@ -0,0 +1,280 @@
+/*********************************************************************
+*   DtcThreadPool.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include "DtcThreadPool.h"
+
+///////////////////////////////////////////////////////////////////////
+// Constructor & Destructor Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * Constructor of DtcThreadPool class
+ *
+ * @param nThreads the number of the worker threads (0 for the number of the online cores)
+ */
+DtcThreadPool::DtcThreadPool(uint32_t nThreads /* = 0 */) {
+
+	if(nThreads == 0) {
+
+		long ncores = sysconf(_SC_NPROCESSORS_ONLN);
+		nThreads = (ncores > 0) ? (uint32_t)ncores : 1;
+	}
+
+	pthread_mutex_init(&m_rLock, NULL);
+	pthread_cond_init(&m_rWorkCond, NULL);
+	pthread_cond_init(&m_rDoneCond, NULL);
+
+	m_nPending = 0;
+	m_nQueued = 0;
+	m_nNextWorker = 0;
+	m_bShutdown = FALSE;
+
+	// The workers must exist before any of them starts stealing
+	for(uint32_t i = 0; i < nThreads; i++) {
+
+		DtcWorker_t *worker = new DtcWorker_t;
+
+		worker->pPool = this;
+		worker->nIndex = i;
+		pthread_mutex_init(&worker->rLock, NULL);
+
+		m_rWorkerList.push_back(worker);
+	}
+
+	for(uint32_t i = 0; i < nThreads; i++) {
+
+		DtcWorker_t *worker = m_rWorkerList[i];
+
+		if(pthread_create(&worker->rThread, NULL, WorkerMain, worker) != 0) {
+			DTC_ERROR(DEX2C_TAG, "DtcThreadPool - Fail to create worker %d", i);
+		}
+	}
+}
+
+DtcThreadPool::~DtcThreadPool() {
+
+	pthread_mutex_lock(&m_rLock);
+	m_bShutdown = TRUE;
+	pthread_cond_broadcast(&m_rWorkCond);
+	pthread_mutex_unlock(&m_rLock);
+
+	DtcWorkerList_t::iterator iter;
+
+	for(iter = m_rWorkerList.begin(); iter != m_rWorkerList.end(); iter++) {
+
+		pthread_join((*iter)->rThread, NULL);
+		pthread_mutex_destroy(&(*iter)->rLock);
+		delete *iter;
+	}
+
+	m_rWorkerList.clear();
+
+	pthread_cond_destroy(&m_rDoneCond);
+	pthread_cond_destroy(&m_rWorkCond);
+	pthread_mutex_destroy(&m_rLock);
+}
+
+///////////////////////////////////////////////////////////////////////
+// Member Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will submit a task to the pool. The tasks are distributed over the
+ * queues of the workers in a round-robin manner, and the idle workers steal them.
+ *
+ * @param pFunc the function of the task
+ * @param pArg the argument passed to the function
+ * @param pGroup the group including the task
+ */
+void
+DtcThreadPool::Submit(DtcTaskFunc_t pFunc, void *pArg, DtcTaskGroup_t *pGroup /* = NULL */) {
+
+	DtcTask_t task = { pFunc, pArg, pGroup };
+
+	pthread_mutex_lock(&m_rLock);
+
+	if(pGroup != NULL) {
+		pGroup->nPending++;
+	}
+
+	DtcWorker_t *worker = m_rWorkerList[m_nNextWorker++ % m_rWorkerList.size()];
+
+	pthread_mutex_lock(&worker->rLock);
+	worker->rQueue.push_back(task);
+	pthread_mutex_unlock(&worker->rLock);
+
+	m_nPending++;
+	m_nQueued++;
+
+	pthread_cond_signal(&m_rWorkCond);
+
+	// Wake up the waiting thread as well so that it can help with the new task
+	pthread_cond_broadcast(&m_rDoneCond);
+
+	pthread_mutex_unlock(&m_rLock);
+}
+
+/**
+ * This function will wait until all the tasks of the given group are finished. The 
+ * calling thread steals and runs the queued tasks instead of just sleeping, so a task
+ * can wait for the group of its own subtasks without blocking a worker.
+ *
+ * @param pGroup the group to be waited for (NULL for all the submitted tasks)
+ */
+void
+DtcThreadPool::Wait(DtcTaskGroup_t *pGroup /* = NULL */) {
+
+	DtcTask_t task;
+
+	while(TRUE) {
+
+		if(TakeTask(GetNumThreads(), task)) {
+
+			task.pFunc(task.pArg);
+			FinishTask(task);
+			continue;
+		}
+
+		pthread_mutex_lock(&m_rLock);
+
+		if((pGroup != NULL) ? (pGroup->nPending == 0) : (m_nPending == 0)) {
+			pthread_mutex_unlock(&m_rLock);
+			break;
+		}
+
+		if(m_nQueued == 0) {
+			pthread_cond_wait(&m_rDoneCond, &m_rLock);
+		}
+
+		pthread_mutex_unlock(&m_rLock);
+	}
+}
+
+/**
+ * This function is the main loop of the worker threads.
+ *
+ * @param pArg the worker
+ * @return NULL
+ */
+void *
+DtcThreadPool::WorkerMain(void *pArg) {
+
+	DtcWorker_t *worker = (DtcWorker_t *)pArg;
+	DtcThreadPool *pool = worker->pPool;
+
+	DtcTask_t task;
+
+	while(TRUE) {
+
+		if(pool->TakeTask(worker->nIndex, task)) {
+
+			task.pFunc(task.pArg);
+			pool->FinishTask(task);
+			continue;
+		}
+
+		pthread_mutex_lock(&pool->m_rLock);
+
+		while(pool->m_nQueued == 0 && pool->m_bShutdown == FALSE) {
+			pthread_cond_wait(&pool->m_rWorkCond, &pool->m_rLock);
+		}
+
+		bool_t done = (pool->m_bShutdown && pool->m_nQueued == 0);
+
+		pthread_mutex_unlock(&pool->m_rLock);
+
+		if(done) break;
+	}
+
+	return NULL;
+}
+
+/**
+ * This function will take a task from the queue of the given worker, or steal one
+ * from the other workers if the queue is empty.
+ *
+ * @param nIndex the index of the worker (an out-of-range index only steals)
+ * @param rTask the task taken (output)
+ * @return TRUE if a task is taken
+ */
+bool_t
+DtcThreadPool::TakeTask(uint32_t nIndex, DtcTask_t &rTask) {
+
+	uint32_t nworkers = GetNumThreads();
+	bool_t found = FALSE;
+
+	// Take the most recent task of its own for the locality
+	if(nIndex < nworkers) {
+
+		DtcWorker_t *worker = m_rWorkerList[nIndex];
+
+		pthread_mutex_lock(&worker->rLock);
+
+		if(!worker->rQueue.empty()) {
+
+			rTask = worker->rQueue.back();
+			worker->rQueue.pop_back();
+			found = TRUE;
+		}
+
+		pthread_mutex_unlock(&worker->rLock);
+	}
+
+	// Steal the oldest task of the others
+	for(uint32_t i = 1; i <= nworkers && found == FALSE; i++) {
+
+		DtcWorker_t *victim = m_rWorkerList[(nIndex + i) % nworkers];
+
+		pthread_mutex_lock(&victim->rLock);
+
+		if(!victim->rQueue.empty()) {
+
+			rTask = victim->rQueue.front();
+			victim->rQueue.pop_front();
+			found = TRUE;
+		}
+
+		pthread_mutex_unlock(&victim->rLock);
+	}
+
+	if(found) {
+
+		pthread_mutex_lock(&m_rLock);
+		m_nQueued--;
+		pthread_mutex_unlock(&m_rLock);
+	}
+
+	return found;
+}
+
+/**
+ * This function will account a finished task and wake up the waiting threads.
+ *
+ * @param rTask the finished task
+ */
+void
+DtcThreadPool::FinishTask(DtcTask_t &rTask) {
+
+	pthread_mutex_lock(&m_rLock);
+
+	bool_t done = (--m_nPending == 0);
+
+	if(rTask.pGroup != NULL && --rTask.pGroup->nPending == 0) {
+		done = TRUE;
+	}
+
+	if(done) {
+		pthread_cond_broadcast(&m_rDoneCond);
+	}
+
+	pthread_mutex_unlock(&m_rLock);
+}
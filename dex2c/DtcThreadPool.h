@@ -0,0 +1,138 @@
+/*********************************************************************
+*   DtcThreadPool.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#ifndef _DTC_THREAD_POOL_H_
+#define _DTC_THREAD_POOL_H_
+
+#include <deque>
+#include <pthread.h>
+
+#include "DtcCommon.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+class DtcThreadPool;
+
+typedef void (*DtcTaskFunc_t)(void *pArg);
+
+// A group of the tasks which can be waited for independently of the others
+typedef struct {
+
+	// The number of the tasks of the group not finished yet
+	uint32_t nPending;
+
+} DtcTaskGroup_t;
+
+// A unit of work to be run by the pool
+typedef struct {
+
+	DtcTaskFunc_t pFunc;
+	void *pArg;
+
+	// The group including the task (NULL if it does not belong to any group)
+	DtcTaskGroup_t *pGroup;
+
+} DtcTask_t;
+
+typedef deque<DtcTask_t> DtcTaskQueue_t;
+
+// A worker thread owning its own task queue
+typedef struct {
+
+	// The pool including the worker
+	DtcThreadPool *pPool;
+
+	// The index of the worker in the pool
+	uint32_t nIndex;
+
+	pthread_t rThread;
+
+	// The lock protecting the task queue
+	pthread_mutex_t rLock;
+
+	// The owner pops from the back and the thieves steal from the front
+	DtcTaskQueue_t rQueue;
+
+} DtcWorker_t;
+
+typedef vector<DtcWorker_t *> DtcWorkerList_t;
+
+///////////////////////////////////////////////////////////////////////
+// DtcThreadPool Class Declaration
+///////////////////////////////////////////////////////////////////////
+
+class DtcThreadPool {
+
+private:
+	///////////////////////////////////////////////////////////////////
+	// Member Variable Declaration
+	///////////////////////////////////////////////////////////////////
+
+	// The worker threads
+	DtcWorkerList_t m_rWorkerList;
+
+	// The lock and conditions protecting the counters below
+	pthread_mutex_t m_rLock;
+	pthread_cond_t m_rWorkCond;
+	pthread_cond_t m_rDoneCond;
+
+	// The number of the tasks submitted but not finished yet
+	uint32_t m_nPending;
+
+	// The number of the tasks waiting in the queues
+	uint32_t m_nQueued;
+
+	// The worker receiving the next submitted task
+	uint32_t m_nNextWorker;
+
+	bool_t m_bShutdown;
+
+public:
+	///////////////////////////////////////////////////////////////////
+	// Constructor & Destructor Declaration
+	///////////////////////////////////////////////////////////////////
+
+	DtcThreadPool(uint32_t nThreads = 0);
+
+	virtual ~DtcThreadPool();
+
+	///////////////////////////////////////////////////////////////////
+	// Accessor & Mutator Declaration/Definition
+	///////////////////////////////////////////////////////////////////
+
+	/**
+	 * This function will return the number of the worker threads.
+	 *
+	 * @return the number of the worker threads
+	 */
+	inline uint32_t GetNumThreads()		{ return (uint32_t)m_rWorkerList.size();	}
+
+	///////////////////////////////////////////////////////////////////
+	// Member Function Declaration
+	///////////////////////////////////////////////////////////////////
+
+	void Submit(DtcTaskFunc_t pFunc, void *pArg, DtcTaskGroup_t *pGroup = NULL);
+
+	void Wait(DtcTaskGroup_t *pGroup = NULL);
+
+private:
+
+	static void *WorkerMain(void *pArg);
+
+	bool_t TakeTask(uint32_t nIndex, DtcTask_t &rTask);
+
+	void FinishTask(DtcTask_t &rTask);
+};
+
+#endif
@@ -0,0 +1,57 @@
+# Copyright (C) 2014 Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+#
+# Host-side microbenchmark of the dex2c phases, which synthesizes the methods
+# of several shapes and sizes and reports the time of each phase per method.
+#
+# This makefile must be included from dalvik/vm/Android.mk with
+#   include $(LOCAL_PATH)/dex2c/bench/Android.mk
+#
+
+ifeq ($(WITH_HOST_DALVIK),true)
+
+LOCAL_PATH := $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE := dex2c-bench
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := \
+	DtcBenchMain.cpp \
+	../DtcThreadPool.cpp \
+	../DtcArena.cpp \
+	../DtcCompilerContext.cpp \
+	../DtcDexBasicBlock.cpp \
+	../DtcDexLiveWeb.cpp \
+	../DtcDexMethod.cpp \
+	../DtcDexcode.cpp \
+	../DtcDexInsnTable.cpp \
+	../DtcDexOpcode.cpp \
+	../DtcCExpression.cpp \
+	../DtcCStatement.cpp \
+	../DtcCSymbol.cpp \
+	../DtcCSymbolTable.cpp \
+	../DtcCBasicBlock.cpp \
+	../DtcCMethod.cpp \
+	../DtcCallCell.cpp \
+	../DtcCodeBuffer.cpp \
+	../DtcDebug.cpp \
+	../DtcStats.cpp \
+	../DtcNode.cpp
+
+LOCAL_C_INCLUDES := \
+	$(JNI_H_INCLUDE) \
+	dalvik \
+	dalvik/vm \
+	dalvik/vm/dex2c \
+	external/zlib \
+	libcore/include
+
+LOCAL_CFLAGS += -Wno-unused-parameter -DDEX2C_SUPPORT
+
+LOCAL_STATIC_LIBRARIES := libdex liblog libcutils libz
+LOCAL_LDLIBS += -lpthread -ldl
+
+include $(BUILD_HOST_EXECUTABLE)
+
+endif
@@ -0,0 +1,715 @@
+/*********************************************************************
+*   DtcBenchMain.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <new>
+
+#include "DtcCommon.h"
+#include "DtcCMethod.h"
+#include "DtcDexMethod.h"
+#include "DtcCompilerContext.h"
+#include "DtcStats.h"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// The largest method synthesized by default, which is the limit of the 16-bit offsets
+#define DTC_BENCH_MAX_UNITS			65535
+#define DTC_BENCH_MIN_UNITS			256
+
+// The number of the code units translated for each measurement
+#define DTC_BENCH_WORK_UNITS		(1 << 20)
+
+// The growth of the time per code unit from the smallest to the largest method,
+// which is reported as a super-linear behavior
+#define DTC_BENCH_SUPERLINEAR		2.0
+
+typedef vector<u2> DtcBenchInsns_t;
+
+// A synthesized method body
+typedef struct {
+
+	DtcBenchInsns_t rInsns;
+
+	// The try blocks and the registers
+	vector<DexTry> rTries;
+	uint16_t nRegisters;
+
+} DtcBenchCode_t;
+
+typedef void (*DtcBenchShapeFunc_t)(DtcBenchCode_t &rCode, uint32_t nUnits);
+
+// A shape of the synthesized methods
+typedef struct {
+
+	const char *pName;
+
+	DtcBenchShapeFunc_t pGenerate;
+
+} DtcBenchShape_t;
+
+// The phases reported by the benchmark
+typedef struct {
+
+	const char *pName;
+
+	DtcPhase_t nPhase;
+
+} DtcBenchPhase_t;
+
+///////////////////////////////////////////////////////////////////////
+// Static Variable Definition
+///////////////////////////////////////////////////////////////////////
+
+// The heap allocations made by the compiler
+static uint64_t s_nAllocCount = 0;
+static uint64_t s_nAllocBytes = 0;
+
+// The decoding of the instructions is fused with the leader scan, and the type
+// resolution is done by the liveness analysis for each instruction
+static const DtcBenchPhase_t s_pPhases[] = {
+	{ "locals", DTC_PHASE_RESOLVE_LOCALS },
+	{ "blocks+decode", DTC_PHASE_RESOLVE_BLOCKS },
+	{ "dexcodes", DTC_PHASE_RESOLVE_DEXCODES },
+	{ "liveness+types", DTC_PHASE_ANALYSE_LIVENESS },
+	{ "translate", DTC_PHASE_TRANSLATE },
+	{ "emit", DTC_PHASE_EMIT },
+};
+
+#define NUM_OF_BENCH_PHASES		(sizeof(s_pPhases) / sizeof(s_pPhases[0]))
+
+///////////////////////////////////////////////////////////////////////
+// Allocation Counting
+///////////////////////////////////////////////////////////////////////
+
+void *
+operator new(size_t nSize) throw(std::bad_alloc) {
+
+	s_nAllocCount++;
+	s_nAllocBytes += nSize;
+
+	void *ptr = malloc(nSize > 0 ? nSize : 1);
+
+	if(ptr == NULL) throw std::bad_alloc();
+
+	return ptr;
+}
+
+void *
+operator new[](size_t nSize) throw(std::bad_alloc) {
+
+	return operator new(nSize);
+}
+
+void
+operator delete(void *pPtr) throw() {
+
+	free(pPtr);
+}
+
+void
+operator delete[](void *pPtr) throw() {
+
+	free(pPtr);
+}
+
+///////////////////////////////////////////////////////////////////////
+// Instruction Encoding
+///////////////////////////////////////////////////////////////////////
+
+static inline void
+Emit10x(DtcBenchInsns_t &rInsns, uint8_t nOp) {
+	rInsns.push_back(nOp);
+}
+
+static inline void
+Emit21s(DtcBenchInsns_t &rInsns, uint8_t nOp, uint8_t nA, int16_t nB) {
+	rInsns.push_back(nOp | (nA << 8));
+	rInsns.push_back((u2)nB);
+}
+
+static inline void
+Emit22b(DtcBenchInsns_t &rInsns, uint8_t nOp, uint8_t nA, uint8_t nB, int8_t nC) {
+	rInsns.push_back(nOp | (nA << 8));
+	rInsns.push_back(nB | ((uint8_t)nC << 8));
+}
+
+static inline void
+Emit22t(DtcBenchInsns_t &rInsns, uint8_t nOp, uint8_t nA, uint8_t nB, int16_t nC) {
+	rInsns.push_back(nOp | (nA << 8) | (nB << 12));
+	rInsns.push_back((u2)nC);
+}
+
+static inline void
+Emit23x(DtcBenchInsns_t &rInsns, uint8_t nOp, uint8_t nA, uint8_t nB, uint8_t nC) {
+	rInsns.push_back(nOp | (nA << 8));
+	rInsns.push_back(nB | (nC << 8));
+}
+
+static inline void
+Emit32(DtcBenchInsns_t &rInsns, uint32_t nValue) {
+	rInsns.push_back((u2)nValue);
+	rInsns.push_back((u2)(nValue >> 16));
+}
+
+static inline void
+Emit31t(DtcBenchInsns_t &rInsns, uint8_t nOp, uint8_t nA, int32_t nB) {
+	rInsns.push_back(nOp | (nA << 8));
+	Emit32(rInsns, (uint32_t)nB);
+}
+
+static inline void
+Emit30t(DtcBenchInsns_t &rInsns, uint8_t nOp, int32_t nA) {
+	rInsns.push_back(nOp);
+	Emit32(rInsns, (uint32_t)nA);
+}
+
+///////////////////////////////////////////////////////////////////////
+// Shape Generation
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will synthesize a single block of the arithmetic instructions.
+ *
+ * @param rCode the synthesized code (output)
+ * @param nUnits the number of the code units
+ */
+static void
+GenerateStraight(DtcBenchCode_t &rCode, uint32_t nUnits) {
+
+	DtcBenchInsns_t &insns = rCode.rInsns;
+
+	for(uint8_t i = 0; i < 4; i++) {
+		Emit21s(insns, OP_CONST_16, i, i + 1);
+	}
+
+	for(uint32_t i = 0; insns.size() + 2 < nUnits; i++) {
+		Emit23x(insns, OP_ADD_INT, i % 4, (i + 1) % 4, (i + 2) % 4);
+	}
+
+	Emit10x(insns, OP_RETURN_VOID);
+
+	rCode.nRegisters = 4;
+}
+
+/**
+ * This function will synthesize a chain of the conditional branches, each of which
+ * skips an instruction, so every other instruction is a leader.
+ *
+ * @param rCode the synthesized code (output)
+ * @param nUnits the number of the code units
+ */
+static void
+GenerateIfChain(DtcBenchCode_t &rCode, uint32_t nUnits) {
+
+	DtcBenchInsns_t &insns = rCode.rInsns;
+
+	Emit21s(insns, OP_CONST_16, 0, 0);
+	Emit21s(insns, OP_CONST_16, 1, 0);
+
+	while(insns.size() + 5 < nUnits) {
+
+		Emit21s(insns, OP_IF_EQZ, 0, 4);
+		Emit22b(insns, OP_ADD_INT_LIT8, 1, 1, 1);
+	}
+
+	Emit10x(insns, OP_RETURN_VOID);
+
+	rCode.nRegisters = 2;
+}
+
+/**
+ * This function will synthesize a switch whose cases join at the end of the method.
+ *
+ * @param rCode the synthesized code (output)
+ * @param nUnits the number of the code units
+ * @param bSparse whether the switch is a sparse-switch
+ */
+static void
+GenerateSwitch(DtcBenchCode_t &rCode, uint32_t nUnits, bool_t bSparse) {
+
+	DtcBenchInsns_t &insns = rCode.rInsns;
+
+	// A case takes 5 units and its entry of the payload takes 2 or 4 units
+	uint32_t perCase = bSparse ? 9 : 7;
+	uint32_t ncase = (nUnits > 16) ? (nUnits - 16) / perCase : 1;
+
+	Emit21s(insns, OP_CONST_16, 0, 0);
+	Emit21s(insns, OP_CONST_16, 1, 0);
+
+	uint32_t switchPc = insns.size();
+	uint32_t firstCase = switchPc + 3 + 3;
+	uint32_t endPc = firstCase + ncase * 5;
+	uint32_t payloadPc = (endPc + 1 + 1) & ~1U;
+
+	Emit31t(insns, bSparse ? OP_SPARSE_SWITCH : OP_PACKED_SWITCH, 0, payloadPc - switchPc);
+	Emit30t(insns, OP_GOTO_32, endPc - insns.size());
+
+	for(uint32_t i = 0; i < ncase; i++) {
+
+		Emit22b(insns, OP_ADD_INT_LIT8, 1, 1, (int8_t)i);
+		Emit30t(insns, OP_GOTO_32, endPc - insns.size());
+	}
+
+	Emit10x(insns, OP_RETURN_VOID);
+
+	// The payload must be aligned to 4 bytes
+	if(insns.size() & 1) Emit10x(insns, OP_NOP);
+
+	// The signatures of the sparse-switch and packed-switch payloads
+	insns.push_back(bSparse ? 0x0200 : 0x0100);
+	insns.push_back((u2)ncase);
+
+	if(bSparse) {
+
+		for(uint32_t i = 0; i < ncase; i++) {
+			Emit32(insns, i * 3);
+		}
+	}
+	else {
+		Emit32(insns, 0);
+	}
+
+	for(uint32_t i = 0; i < ncase; i++) {
+		Emit32(insns, firstCase + i * 5 - switchPc);
+	}
+
+	rCode.nRegisters = 2;
+}
+
+static void
+GeneratePackedSwitch(DtcBenchCode_t &rCode, uint32_t nUnits) {
+	GenerateSwitch(rCode, nUnits, FALSE);
+}
+
+static void
+GenerateSparseSwitch(DtcBenchCode_t &rCode, uint32_t nUnits) {
+	GenerateSwitch(rCode, nUnits, TRUE);
+}
+
+/**
+ * This function will synthesize a sequence of the doubly nested loops.
+ *
+ * @param rCode the synthesized code (output)
+ * @param nUnits the number of the code units
+ */
+static void
+GenerateNestedLoops(DtcBenchCode_t &rCode, uint32_t nUnits) {
+
+	DtcBenchInsns_t &insns = rCode.rInsns;
+
+	Emit21s(insns, OP_CONST_16, 0, 16);
+	Emit21s(insns, OP_CONST_16, 1, 0);
+
+	// A nest takes 18 units
+	while(insns.size() + 19 < nUnits) {
+
+		Emit21s(insns, OP_CONST_16, 2, 0);
+		Emit22t(insns, OP_IF_GE, 2, 0, 16);
+		Emit21s(insns, OP_CONST_16, 3, 0);
+		Emit22t(insns, OP_IF_GE, 3, 0, 8);
+		Emit23x(insns, OP_ADD_INT, 1, 1, 3);
+		Emit22b(insns, OP_ADD_INT_LIT8, 3, 3, 1);
+		Emit21s(insns, OP_GOTO_16, 0, -6);
+		Emit22b(insns, OP_ADD_INT_LIT8, 2, 2, 1);
+		Emit21s(insns, OP_GOTO_16, 0, -14);
+	}
+
+	Emit10x(insns, OP_RETURN_VOID);
+
+	rCode.nRegisters = 4;
+}
+
+/**
+ * This function will synthesize a sequence of the try blocks, each of which covers
+ * a division.
+ *
+ * @param rCode the synthesized code (output)
+ * @param nUnits the number of the code units
+ */
+static void
+GenerateTryBlocks(DtcBenchCode_t &rCode, uint32_t nUnits) {
+
+	DtcBenchInsns_t &insns = rCode.rInsns;
+
+	Emit21s(insns, OP_CONST_16, 0, 7);
+
+	while(insns.size() + 5 < nUnits && rCode.rTries.size() < 0xFFFF) {
+
+		DexTry dexTry;
+
+		dexTry.startAddr = insns.size();
+		dexTry.insnCount = 2;
+		dexTry.handlerOff = 1;
+
+		rCode.rTries.push_back(dexTry);
+
+		Emit22b(insns, OP_DIV_INT_LIT8, 0, 0, 3);
+		Emit22b(insns, OP_ADD_INT_LIT8, 0, 0, 1);
+	}
+
+	Emit10x(insns, OP_RETURN_VOID);
+
+	rCode.nRegisters = 1;
+}
+
+static const DtcBenchShape_t s_pShapes[] = {
+	{ "straight", GenerateStraight },
+	{ "if-chain", GenerateIfChain },
+	{ "packed-switch", GeneratePackedSwitch },
+	{ "sparse-switch", GenerateSparseSwitch },
+	{ "nested-loops", GenerateNestedLoops },
+	{ "try-blocks", GenerateTryBlocks },
+};
+
+#define NUM_OF_BENCH_SHAPES		(sizeof(s_pShapes) / sizeof(s_pShapes[0]))
+
+///////////////////////////////////////////////////////////////////////
+// Dex Image Building
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will append a value to the image at the given alignment.
+ *
+ * @param rImage the image
+ * @param pData the value
+ * @param nSize the size of the value
+ * @param nAlign the alignment
+ * @return the offset of the value
+ */
+static uint32_t
+Append(vector<u1> &rImage, const void *pData, uint32_t nSize, uint32_t nAlign = 1) {
+
+	while(rImage.size() % nAlign) rImage.push_back(0);
+
+	uint32_t offset = rImage.size();
+
+	rImage.insert(rImage.end(), (const u1 *)pData, (const u1 *)pData + nSize);
+
+	return offset;
+}
+
+/**
+ * This function will build a dex image including a static method "void bench()" with
+ * the given code. Only the sections read by the translator are filled.
+ *
+ * @param rImage the image (output)
+ * @param rCode the code of the method
+ * @return the offset of the code item
+ */
+static uint32_t
+BuildImage(vector<u1> &rImage, DtcBenchCode_t &rCode) {
+
+	static const char *strings[] = { "LDtcBench;", "V", "bench" };
+
+	DexHeader header;
+	memset(&header, 0, sizeof(header));
+
+	rImage.assign(sizeof(DexHeader), 0);
+
+	// The string ids follow the header, and they are filled after the string data
+	header.stringIdsSize = 3;
+	header.stringIdsOff = rImage.size();
+	rImage.resize(rImage.size() + sizeof(DexStringId) * 3);
+
+	DexTypeId typeIds[2] = { { 0 }, { 1 } };
+	header.typeIdsSize = 2;
+	header.typeIdsOff = Append(rImage, typeIds, sizeof(typeIds), 4);
+
+	DexProtoId protoId = { 1, 1, 0 };
+	header.protoIdsSize = 1;
+	header.protoIdsOff = Append(rImage, &protoId, sizeof(protoId), 4);
+
+	DexMethodId methodId = { 0, 0, 2 };
+	header.methodIdsSize = 1;
+	header.methodIdsOff = Append(rImage, &methodId, sizeof(methodId), 4);
+
+	// The string data, which are short enough for a single byte of the length
+	for(uint32_t i = 0; i < 3; i++) {
+
+		DexStringId stringId;
+		u1 length = (u1)strlen(strings[i]);
+
+		stringId.stringDataOff = Append(rImage, &length, 1);
+		Append(rImage, strings[i], length + 1);
+
+		memcpy(&rImage[header.stringIdsOff + sizeof(DexStringId) * i], &stringId, sizeof(stringId));
+	}
+
+	// The code item followed by the tries and a catch-all handler
+	DexCode code;
+
+	code.registersSize = rCode.nRegisters;
+	code.insSize = 0;
+	code.outsSize = 0;
+	code.triesSize = (u2)rCode.rTries.size();
+	code.debugInfoOff = 0;
+	code.insnsSize = rCode.rInsns.size();
+
+	uint32_t codeOff = Append(rImage, &code, offsetof(DexCode, insns), 4);
+
+	Append(rImage, &rCode.rInsns[0], rCode.rInsns.size() * sizeof(u2));
+
+	if(!rCode.rTries.empty()) {
+
+		// A list of a single handler, which only has the catch-all at the return-void
+		uint32_t catchAll = rCode.rInsns.size() - 1;
+		u1 handlers[8] = { 1, 0 };
+		uint32_t length = 2;
+
+		do {
+			handlers[length++] = (catchAll & 0x7F) | ((catchAll > 0x7F) ? 0x80 : 0);
+			catchAll >>= 7;
+		} while(catchAll != 0);
+
+		Append(rImage, &rCode.rTries[0], rCode.rTries.size() * sizeof(DexTry), 4);
+		Append(rImage, handlers, length);
+	}
+
+	memcpy(header.magic, DEX_MAGIC DEX_MAGIC_VERS, sizeof(header.magic));
+
+	header.fileSize = rImage.size();
+	header.headerSize = sizeof(DexHeader);
+	header.endianTag = kDexEndianConstant;
+
+	memcpy(&rImage[0], &header, sizeof(header));
+
+	return codeOff;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Measurement
+///////////////////////////////////////////////////////////////////////
+
+// The result of a measurement
+typedef struct {
+
+	uint32_t nUnits;
+	uint32_t nBlocks;
+	uint32_t nIterations;
+
+	// The time of each phase per iteration in nanoseconds
+	double pPhaseNs[NUM_OF_BENCH_PHASES];
+	double nTotalNs;
+
+	// The heap allocations per iteration
+	double nAllocCount;
+	double nAllocBytes;
+
+	DtcError_t nError;
+
+} DtcBenchResult_t;
+
+/**
+ * This function will translate the given method repeatedly and measure each phase.
+ *
+ * @param pShape the shape of the method
+ * @param nUnits the number of the code units
+ * @param rResult the result (output)
+ */
+static void
+Measure(const DtcBenchShape_t *pShape, uint32_t nUnits, DtcBenchResult_t &rResult) {
+
+	DtcBenchCode_t code;
+	vector<u1> image;
+
+	memset(&rResult, 0, sizeof(rResult));
+
+	pShape->pGenerate(code, nUnits);
+
+	uint32_t codeOff = BuildImage(image, code);
+
+	DexFile dexFile;
+	memset(&dexFile, 0, sizeof(dexFile));
+
+	dexFileSetupBasicPointers(&dexFile, &image[0]);
+
+	DexMethod dexMethod = { 0, ACC_STATIC | ACC_PUBLIC, codeOff };
+
+	DtcCompilerContext *context = DtcCompilerContext::Acquire();
+	DtcStats *stats = DtcStats::GetCurrent();
+
+	rResult.nUnits = code.rInsns.size();
+	rResult.nIterations = DTC_BENCH_WORK_UNITS / rResult.nUnits + 1;
+
+	// Warm up the arena of the context
+	DtcCMethod *cMethod = NULL;
+	rResult.nError = context->Translate(&dexFile, &dexMethod, NULL, cMethod);
+
+	if(rResult.nError != DTC_SUCCESS) {
+		DtcCompilerContext::Release(context);
+		return;
+	}
+
+	rResult.nBlocks = context->GetLastDexMethod()->GetBasicBlocks().size();
+
+	context->Reset();
+
+	uint64_t phaseStart[NUM_OF_BENCH_PHASES];
+
+	for(uint32_t i = 0; i < NUM_OF_BENCH_PHASES; i++) {
+		phaseStart[i] = stats->GetPhase(s_pPhases[i].nPhase).nTotalNs;
+	}
+
+	uint64_t allocCount = s_nAllocCount;
+	uint64_t allocBytes = s_nAllocBytes;
+	uint64_t start = DtcStats::GetTime();
+
+	for(uint32_t n = 0; n < rResult.nIterations; n++) {
+
+		context->Translate(&dexFile, &dexMethod, NULL, cMethod);
+
+		// The emission is timed here since the JIT compiler emits into a file
+		DtcCodeBuffer out;
+
+		uint64_t emitStart = DtcStats::GetTime();
+		out << cMethod;
+		stats->AddPhase(DTC_PHASE_EMIT, emitStart);
+
+		context->Reset();
+	}
+
+	rResult.nTotalNs = (double)(DtcStats::GetTime() - start) / rResult.nIterations;
+	rResult.nAllocCount = (double)(s_nAllocCount - allocCount) / rResult.nIterations;
+	rResult.nAllocBytes = (double)(s_nAllocBytes - allocBytes) / rResult.nIterations;
+
+	for(uint32_t i = 0; i < NUM_OF_BENCH_PHASES; i++) {
+
+		uint64_t elapsed = stats->GetPhase(s_pPhases[i].nPhase).nTotalNs - phaseStart[i];
+
+		rResult.pPhaseNs[i] = (double)elapsed / rResult.nIterations;
+	}
+
+	DtcCompilerContext::Release(context);
+}
+
+/**
+ * This function will print out the result of a measurement, with the throughput of
+ * each phase in millions of the code units per second.
+ *
+ * @param pShape the shape of the method
+ * @param rResult the result
+ */
+static void
+Report(const DtcBenchShape_t *pShape, DtcBenchResult_t &rResult) {
+
+	if(rResult.nError != DTC_SUCCESS) {
+		printf("%-14s %6u  failed (error:%d)\n", pShape->pName, rResult.nUnits, rResult.nError);
+		return;
+	}
+
+	printf("%-14s %6u %6u", pShape->pName, rResult.nUnits, rResult.nBlocks);
+
+	for(uint32_t i = 0; i < NUM_OF_BENCH_PHASES; i++) {
+		printf(" %9.1f/%6.2f", rResult.pPhaseNs[i] / 1000, rResult.nUnits * 1000.0 / rResult.pPhaseNs[i]);
+	}
+
+	printf(" %9.1f %8.0f %10.0f\n", rResult.nTotalNs / 1000, rResult.nAllocCount, rResult.nAllocBytes);
+}
+
+/**
+ * This function will print out the usage of the benchmark.
+ */
+static void
+Usage() {
+
+	fprintf(stderr,
+		"Usage: dex2c-bench [-s shape] [-m max units]\n"
+		"  -s  the shape of the methods (default: all)\n"
+		"  -m  the largest method in code units (default: %d)\n",
+		DTC_BENCH_MAX_UNITS);
+}
+
+///////////////////////////////////////////////////////////////////////
+// Main Function Definition
+///////////////////////////////////////////////////////////////////////
+
+int
+main(int argc, char **argv) {
+
+	const char *shapeName = NULL;
+	uint32_t maxUnits = DTC_BENCH_MAX_UNITS;
+	int opt;
+
+	while((opt = getopt(argc, argv, "s:m:")) != -1) {
+
+		switch(opt) {
+			case 's':
+				shapeName = optarg;
+				break;
+			case 'm':
+				maxUnits = atoi(optarg);
+				break;
+			default:
+				Usage();
+				return 2;
+		}
+	}
+
+	if(maxUnits < DTC_BENCH_MIN_UNITS || maxUnits > DTC_BENCH_MAX_UNITS) {
+		Usage();
+		return 2;
+	}
+
+	printf("%-14s %6s %6s", "shape", "units", "blocks");
+
+	for(uint32_t i = 0; i < NUM_OF_BENCH_PHASES; i++) {
+		printf(" %16s", s_pPhases[i].pName);
+	}
+
+	printf(" %9s %8s %10s\n", "total(us)", "allocs", "bytes");
+	printf("%-14s %6s %6s", "", "", "");
+
+	for(uint32_t i = 0; i < NUM_OF_BENCH_PHASES; i++) {
+		printf(" %16s", "us/Mcu/s");
+	}
+
+	printf("\n");
+
+	int result = 0;
+
+	for(uint32_t i = 0; i < NUM_OF_BENCH_SHAPES; i++) {
+
+		const DtcBenchShape_t *shape = &s_pShapes[i];
+
+		if(shapeName != NULL && strcmp(shapeName, shape->pName) != 0) continue;
+
+		double firstNsPerUnit = 0;
+		double lastNsPerUnit = 0;
+
+		for(uint32_t units = DTC_BENCH_MIN_UNITS; units <= maxUnits; units = (units < maxUnits / 4) ? units * 4 : maxUnits) {
+
+			DtcBenchResult_t res;
+
+			Measure(shape, units, res);
+			Report(shape, res);
+
+			if(res.nError == DTC_SUCCESS) {
+
+				lastNsPerUnit = res.nTotalNs / res.nUnits;
+				if(firstNsPerUnit == 0) firstNsPerUnit = lastNsPerUnit;
+			}
+
+			if(units == maxUnits) break;
+		}
+
+		// The time per code unit should stay flat as the methods grow
+		if(firstNsPerUnit > 0 && lastNsPerUnit > firstNsPerUnit * DTC_BENCH_SUPERLINEAR) {
+
+			printf("%-14s super-linear: %.1f ns/unit -> %.1f ns/unit\n", shape->pName,
+				firstNsPerUnit, lastNsPerUnit);
+			result = 1;
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,413 @@
+/*********************************************************************
+*   Kernels.java:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+/**
+ * The kernels of the end-to-end benchmark. Each kernel runs in rounds of a fixed
+ * amount of work, and the time of every round is measured so that the warm-up
+ * (interpretation, compilation and installation) can be told from the steady state.
+ *
+ * Usage: dalvikvm -cp kernels.dex Kernels <kernel> [rounds]
+ *
+ * The result is printed in one line:
+ *   kernel=<name> rounds=<n> first-us=<us> steady-us=<us> steady-rps=<rounds/s> warm-ms=<ms> unit-ns=<ns> check=<value>
+ * where steady-us is the median of the last half of the rounds, warm-ms is the
+ * time until the first round within 1.25x of the steady state, and unit-ns is the
+ * steady time of a unit of the work in a round (a call for the call kernels).
+ *
+ * The call kernels (call-<shorty>) measure the cost of a call to a small static
+ * method by the shorty of the callee, which is dominated by the invoke bridge when
+ * the callee is compiled and the caller is interpreted, and by the direct call of
+ * the compiled callee once the caller is compiled as well.
+ */
+public class Kernels {
+
+	///////////////////////////////////////////////////////////////////
+	// Kernel Definition
+	///////////////////////////////////////////////////////////////////
+
+	static abstract class Kernel {
+
+		abstract String name();
+
+		// Run one round and return a value depending on all of its work
+		abstract int round();
+
+		// The number of the units of the work in a round
+		int units() { return 1; }
+	}
+
+	static class Sieve extends Kernel {
+
+		private final boolean[] composite = new boolean[1 << 16];
+
+		String name() { return "sieve"; }
+
+		int round() {
+
+			boolean[] flags = composite;
+			int count = 0;
+
+			for(int i = 0; i < flags.length; i++) flags[i] = false;
+
+			for(int i = 2; i < flags.length; i++) {
+
+				if(flags[i]) continue;
+
+				count++;
+
+				for(int j = i + i; j < flags.length; j += i) flags[j] = true;
+			}
+
+			return count;
+		}
+	}
+
+	static class MatMul extends Kernel {
+
+		private static final int N = 48;
+
+		private final double[][] a = new double[N][N];
+		private final double[][] b = new double[N][N];
+		private final double[][] c = new double[N][N];
+
+		MatMul() {
+
+			for(int i = 0; i < N; i++) {
+				for(int j = 0; j < N; j++) {
+					a[i][j] = (i * 31 + j) % 17;
+					b[i][j] = (i + j * 7) % 13;
+				}
+			}
+		}
+
+		String name() { return "matmul"; }
+
+		int round() {
+
+			for(int i = 0; i < N; i++) {
+
+				double[] ai = a[i];
+				double[] ci = c[i];
+
+				for(int j = 0; j < N; j++) {
+
+					double sum = 0;
+
+					for(int k = 0; k < N; k++) sum += ai[k] * b[k][j];
+
+					ci[j] = sum;
+				}
+			}
+
+			return (int)c[N - 1][N - 1];
+		}
+	}
+
+	static class Crc32 extends Kernel {
+
+		private final int[] table = new int[256];
+		private final byte[] data = new byte[1 << 15];
+
+		Crc32() {
+
+			for(int i = 0; i < 256; i++) {
+
+				int crc = i;
+
+				for(int k = 0; k < 8; k++) {
+					crc = ((crc & 1) != 0) ? (crc >>> 1) ^ 0xEDB88320 : crc >>> 1;
+				}
+
+				table[i] = crc;
+			}
+
+			for(int i = 0; i < data.length; i++) data[i] = (byte)(i * 131 + 7);
+		}
+
+		String name() { return "crc32"; }
+
+		int round() {
+
+			int crc = 0xFFFFFFFF;
+
+			for(int i = 0; i < data.length; i++) {
+				crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >>> 8);
+			}
+
+			return ~crc;
+		}
+	}
+
+	static class StringHash extends Kernel {
+
+		private final String[] words = new String[1024];
+
+		StringHash() {
+
+			StringBuilder sb = new StringBuilder();
+
+			for(int i = 0; i < words.length; i++) {
+
+				sb.setLength(0);
+
+				for(int k = 0; k < 8 + (i % 24); k++) sb.append((char)('a' + (i * 7 + k * 3) % 26));
+
+				words[i] = sb.toString();
+			}
+		}
+
+		String name() { return "strhash"; }
+
+		int round() {
+
+			int total = 0;
+
+			for(int i = 0; i < words.length; i++) {
+
+				String word = words[i];
+				int hash = 0;
+
+				// The hash is computed here rather than by String.hashCode, which is cached
+				for(int k = 0; k < word.length(); k++) hash = hash * 31 + word.charAt(k);
+
+				total ^= hash;
+			}
+
+			return total;
+		}
+	}
+
+	static class ObjectGraph extends Kernel {
+
+		static class Node {
+
+			Node left;
+			Node right;
+			int value;
+
+			Node(int value) { this.value = value; }
+		}
+
+		private final Node root = build(12, 1);
+
+		private static Node build(int depth, int value) {
+
+			Node node = new Node(value);
+
+			if(depth > 0) {
+				node.left = build(depth - 1, value * 2);
+				node.right = build(depth - 1, value * 2 + 1);
+			}
+
+			return node;
+		}
+
+		private static int walk(Node node) {
+
+			int sum = 0;
+
+			while(node != null) {
+				sum += node.value + walk(node.left);
+				node = node.right;
+			}
+
+			return sum;
+		}
+
+		String name() { return "objgraph"; }
+
+		int round() {
+			return walk(root);
+		}
+	}
+
+	static class SwitchParse extends Kernel {
+
+		private final char[] input;
+
+		SwitchParse() {
+
+			String line = "let x1 = (a + 42) * b_2 - 0x1F / c; if(x1 >= 10) { y = \"s\"; }\n";
+			StringBuilder sb = new StringBuilder();
+
+			while(sb.length() < (1 << 14)) sb.append(line);
+
+			input = sb.toString().toCharArray();
+		}
+
+		String name() { return "switch"; }
+
+		int round() {
+
+			int idents = 0, numbers = 0, ops = 0, others = 0;
+			int state = 0;
+
+			for(int i = 0; i < input.length; i++) {
+
+				char ch = input[i];
+
+				switch(ch) {
+				case 'a': case 'b': case 'c': case 'e': case 'f': case 'i': case 'l':
+				case 's': case 't': case 'x': case 'y': case '_':
+					if(state != 1) idents++;
+					state = 1;
+					break;
+				case '0': case '1': case '2': case '4': case '6': case '8': case '9':
+					if(state == 0) numbers++;
+					if(state != 1) state = 2;
+					break;
+				case '+': case '-': case '*': case '/': case '=': case '<': case '>':
+					ops++;
+					state = 0;
+					break;
+				case ' ': case '\n': case '\t':
+					state = 0;
+					break;
+				default:
+					others++;
+					state = 0;
+					break;
+				}
+			}
+
+			return idents * 1000003 + numbers * 1009 + ops * 31 + others;
+		}
+	}
+
+	static class Call extends Kernel {
+
+		private static final int CALLS = 1 << 16;
+
+		private final String shorty;
+
+		Call(String shorty) { this.shorty = shorty; }
+
+		static int callV() { return 1; }
+		static int callI(int a) { return a + 1; }
+		static int callII(int a, int b) { return a + b; }
+		static int callIIII(int a, int b, int c, int d) { return a + b - c + d; }
+		static int callIIIIII(int a, int b, int c, int d, int e, int f) { return a + b - c + d - e + f; }
+		static int callJ(long a) { return (int)(a >> 3); }
+		static int callJJ(long a, long b) { return (int)(a - b); }
+		static int callD(double a) { return (int)(a * 0.5); }
+		static int callLIJ(Object a, int b, long c) { return ((a != null) ? b : 0) + (int)c; }
+
+		String name() { return "call-" + shorty; }
+
+		int units() { return CALLS; }
+
+		int round() {
+
+			int sum = 0;
+
+			// Each loop calls a single callee so that the bridge of the shorty is measured alone.
+			// The method must stay in the interpreter, since its compiled code would call the
+			// compiled callees directly. run-e2e.sh keeps its loops from making it hot and
+			// raises the invocation threshold above the number of the rounds, which the
+			// callees still reach in the first round
+			if(shorty.equals("V")) {
+				for(int i = 0; i < CALLS; i++) sum += callV();
+			}
+			else if(shorty.equals("I")) {
+				for(int i = 0; i < CALLS; i++) sum += callI(i);
+			}
+			else if(shorty.equals("II")) {
+				for(int i = 0; i < CALLS; i++) sum += callII(i, sum);
+			}
+			else if(shorty.equals("IIII")) {
+				for(int i = 0; i < CALLS; i++) sum += callIIII(i, sum, 3, i);
+			}
+			else if(shorty.equals("IIIIII")) {
+				for(int i = 0; i < CALLS; i++) sum += callIIIIII(i, sum, 3, i, 5, sum);
+			}
+			else if(shorty.equals("J")) {
+				for(int i = 0; i < CALLS; i++) sum += callJ((long)i << 20);
+			}
+			else if(shorty.equals("JJ")) {
+				for(int i = 0; i < CALLS; i++) sum += callJJ((long)i << 20, sum);
+			}
+			else if(shorty.equals("D")) {
+				for(int i = 0; i < CALLS; i++) sum += callD(i);
+			}
+			else if(shorty.equals("LIJ")) {
+				for(int i = 0; i < CALLS; i++) sum += callLIJ(this, i, sum);
+			}
+
+			return sum;
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// Harness Definition
+	///////////////////////////////////////////////////////////////////
+
+	private static Kernel create(String name) {
+
+		if(name.equals("sieve")) return new Sieve();
+		if(name.equals("matmul")) return new MatMul();
+		if(name.equals("crc32")) return new Crc32();
+		if(name.equals("strhash")) return new StringHash();
+		if(name.equals("objgraph")) return new ObjectGraph();
+		if(name.equals("switch")) return new SwitchParse();
+		if(name.startsWith("call-")) return new Call(name.substring(5));
+
+		return null;
+	}
+
+	public static void main(String[] args) {
+
+		if(args.length < 1) {
+			System.err.println("Usage: Kernels <sieve|matmul|crc32|strhash|objgraph|switch|call-<shorty>> [rounds]");
+			System.exit(2);
+		}
+
+		Kernel kernel = create(args[0]);
+		int rounds = (args.length > 1) ? Integer.parseInt(args[1]) : 400;
+
+		if(kernel == null) {
+			System.err.println("Unknown kernel: " + args[0]);
+			System.exit(2);
+		}
+
+		long[] times = new long[rounds];
+		int check = 0;
+
+		for(int i = 0; i < rounds; i++) {
+
+			long start = System.nanoTime();
+			check ^= kernel.round();
+			times[i] = System.nanoTime() - start;
+		}
+
+		// The steady state is the median of the last half of the rounds
+		long[] tail = new long[rounds - rounds / 2];
+
+		System.arraycopy(times, rounds / 2, tail, 0, tail.length);
+		java.util.Arrays.sort(tail);
+
+		long steady = tail[tail.length / 2];
+		long warm = 0;
+
+		for(int i = 0; i < rounds; i++) {
+
+			if(times[i] * 4 <= steady * 5) break;
+
+			warm += times[i];
+		}
+
+		System.out.println("kernel=" + kernel.name() + " rounds=" + rounds +
+			" first-us=" + times[0] / 1000 + " steady-us=" + steady / 1000 +
+			" steady-rps=" + ((steady > 0) ? 1000000000L / steady : 0) +
+			" warm-ms=" + warm / 1000000 + " unit-ns=" + steady / kernel.units() +
+			" check=" + check);
+	}
+}
@@ -0,0 +1,136 @@
+#!/bin/bash
+#
+# Copyright (C) 2014 Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+#
+# End-to-end benchmark of the compiled methods on the host dalvikvm. Each kernel of
+# Kernels.java runs in three modes:
+#
+#   mterp  the fast interpreter alone       (-Xint:fast, -Xdex2c:off)
+#   jit    the trace JIT                    (-Xint:jit,  -Xdex2c:off)
+#   dex2c  the interpreter with dex2c       (-Xint:fast, -Xdex2c:report)
+#
+# and one line is printed for each run with the steady-state throughput, the time
+# of the warm-up, and for dex2c, the time of the first installed method from the VM
+# start and the total compile time, which the compiler thread of the VM reports
+# whenever it runs out of the queued methods.
+#
+# Usage: run-e2e.sh [-r rounds] [-k kernel] [-m mode]
+#
+# The kernel "calls" stands for the call kernels, which measure the cost of a call
+# from the interpreter by the shorty of the callee (see unit-ns). Only the callees
+# are compiled: the loops do not make a method hot (-Xdex2c:branch=off), and the
+# invocation threshold is above the number of the rounds calling the caller but
+# below the number of the calls in a round.
+#
+# The host build of dalvikvm must be on the PATH with its ANDROID_ROOT and
+# ANDROID_DATA set up (e.g. by envsetup.sh and lunch), and javac and dx are needed
+# to build the kernels.
+#
+
+ROUNDS=400
+KERNELS="sieve matmul crc32 strhash objgraph switch"
+CALLS="call-V call-I call-II call-IIII call-IIIIII call-J call-JJ call-D call-LIJ"
+MODES="mterp jit dex2c"
+
+# The invocation threshold of the call kernels (the calls in a round are 65536)
+CALL_THRESHOLD=50000
+
+while getopts "r:k:m:" opt; do
+	case $opt in
+	r) ROUNDS=$OPTARG ;;
+	k) KERNELS=$OPTARG ;;
+	m) MODES=$OPTARG ;;
+	*) echo "Usage: $0 [-r rounds] [-k kernel] [-m mode]"; exit 2 ;;
+	esac
+done
+
+KERNELS=${KERNELS/calls/$CALLS}
+
+SRC_DIR=$(cd "$(dirname "$0")" && pwd)
+OUT_DIR=${OUT_DIR:-/tmp/dex2c-e2e}
+DEX_FILE=$OUT_DIR/kernels.dex
+
+mkdir -p "$OUT_DIR/classes" || exit 1
+
+javac -source 1.6 -target 1.6 -d "$OUT_DIR/classes" "$SRC_DIR/Kernels.java" || exit 1
+dx --dex --output="$DEX_FILE" "$OUT_DIR/classes" || exit 1
+
+# The value of the given key in a line of key=value pairs
+field() {
+	echo "$1" | tr ' ' '\n' | sed -n "s/^$2=//p"
+}
+
+# The exit status, which is set when a run fails
+status=0
+
+printf "%-12s %-6s %10s %10s %10s %10s %8s %12s %12s\n" \
+	kernel mode first-us steady-us rounds/s warm-ms unit-ns install-us compile-us
+
+for kernel in $KERNELS; do
+
+	check=""
+
+	for mode in $MODES; do
+
+		case $mode in
+		mterp) opt="-Xint:fast -Xdex2c:off" ;;
+		jit)   opt="-Xint:jit -Xdex2c:off" ;;
+		dex2c) opt="-Xint:fast -Xdex2c:report" ;;
+		*)     echo "Unknown mode: $mode"; exit 2 ;;
+		esac
+
+		# The caller of a call kernel stays in the interpreter, so that every call goes
+		# through the bridge into the compiled callee rather than a direct C call
+		if [ $mode = dex2c ] && [ "${kernel#call-}" != "$kernel" ]; then
+
+			if [ $ROUNDS -ge $CALL_THRESHOLD ]; then
+				echo "$kernel $mode: too many rounds for the caller to stay interpreted"
+				status=1
+				continue
+			fi
+
+			opt="$opt -Xdex2c:branch=off -Xdex2c:invoke=$CALL_THRESHOLD"
+		fi
+
+		out=$(dalvikvm $opt -cp "$DEX_FILE" Kernels $kernel $ROUNDS 2>"$OUT_DIR/$kernel.$mode.err")
+
+		if [ $? -ne 0 ]; then
+			echo "$kernel $mode: failed (see $OUT_DIR/$kernel.$mode.err)"
+			status=1
+			continue
+		fi
+
+		report=$(grep "^dex2c-report:" "$OUT_DIR/$kernel.$mode.err" | tail -1)
+
+		# A dex2c run without any installed method measures the interpreter again, so
+		# it must not be taken as a speedup
+		if [ $mode = dex2c ]; then
+
+			installs=$(field "$report" installs)
+			first=$(field "$report" first-install-us)
+
+			if [ -z "$installs" ] || [ "$installs" = 0 ] || [ -z "$first" ] || [ "$first" = -1 ]; then
+				echo "$kernel $mode: no method installed (see $OUT_DIR/$kernel.$mode.err)"
+				status=1
+				continue
+			fi
+		fi
+
+		printf "%-12s %-6s %10s %10s %10s %10s %8s %12s %12s\n" $kernel $mode \
+			"$(field "$out" first-us)" "$(field "$out" steady-us)" \
+			"$(field "$out" steady-rps)" "$(field "$out" warm-ms)" "$(field "$out" unit-ns)" \
+			"$(field "$report" first-install-us)" "$(field "$report" compile-us)"
+
+		# The compiled code must compute the same result as the interpreters
+		value=$(field "$out" check)
+
+		if [ -n "$check" ] && [ "$check" != "$value" ]; then
+			echo "$kernel $mode: result mismatch ($value, expected $check)"
+			status=1
+		fi
+
+		check=$value
+	done
+done
+
+exit $status
@@ -0,0 +1,131 @@
+/*********************************************************************
+*   dtc_runtime.h:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+/*
+ * The helpers of the generated C code, which give the arithmetic the semantics of Java
+ * where the C operators differ: the division and the remainder of the minimum value by
+ * -1, the shift distances, the unsigned right shifts, the saturating conversions from
+ * the floating point values, and the comparisons with NaN. The helpers are written with
+ * selects rather than branches, which the C compiler turns into conditional moves where
+ * the target has them, and the checks throwing exceptions (the zero divisors) are left
+ * to the translator, which deoptimizes on a cold path before the helper is called. The
+ * wrapping of the signed overflow is given to the C compiler by -fwrapv.
+ *
+ * The header is written into the shared header of every translation unit, after the
+ * typedefs of the Java types. DtcCMethod.cpp defines DTC_RUNTIME_SOURCE to turn the
+ * helpers into a string, so no preprocessor directive may appear inside of it.
+ */
+
+#ifndef DTC_RUNTIME_SOURCE
+#define DTC_RUNTIME_SOURCE(...) __VA_ARGS__
+#endif
+
+DTC_RUNTIME_SOURCE(
+
+/* The minimum value divided by -1 overflows in C, so the divisor becomes 1 for it */
+static inline j_int dtc_div_int(j_int a, j_int b) {
+    j_int s = (a == (j_int)0x80000000) & (b == -1);
+    return a / (b + (s << 1));
+}
+
+static inline j_int dtc_rem_int(j_int a, j_int b) {
+    j_int s = (a == (j_int)0x80000000) & (b == -1);
+    return a % (b + (s << 1));
+}
+
+static inline j_long dtc_div_long(j_long a, j_long b) {
+    j_long s = (a == (j_long)0x8000000000000000ULL) & (b == -1);
+    return a / (b + (s << 1));
+}
+
+static inline j_long dtc_rem_long(j_long a, j_long b) {
+    j_long s = (a == (j_long)0x8000000000000000ULL) & (b == -1);
+    return a % (b + (s << 1));
+}
+
+/* The remainder of the floating point values truncates like fmod */
+static inline j_float dtc_rem_float(j_float a, j_float b) {
+    return __builtin_fmodf(a, b);
+}
+
+static inline j_double dtc_rem_double(j_double a, j_double b) {
+    return __builtin_fmod(a, b);
+}
+
+/* The shift distance takes the low 5 (or 6) bits only */
+static inline j_int dtc_shl_int(j_int a, j_int n) {
+    return (j_int)((uint32_t)a << (n & 31));
+}
+
+static inline j_int dtc_shr_int(j_int a, j_int n) {
+    return a >> (n & 31);
+}
+
+static inline j_int dtc_ushr_int(j_int a, j_int n) {
+    return (j_int)((uint32_t)a >> (n & 31));
+}
+
+static inline j_long dtc_shl_long(j_long a, j_int n) {
+    return (j_long)((uint64_t)a << (n & 63));
+}
+
+static inline j_long dtc_shr_long(j_long a, j_int n) {
+    return a >> (n & 63);
+}
+
+static inline j_long dtc_ushr_long(j_long a, j_int n) {
+    return (j_long)((uint64_t)a >> (n & 63));
+}
+
+/* NaN converts to 0 and the values out of the range saturate */
+static inline j_int dtc_f2i(j_float v) {
+    return (v != v) ? 0 : (v >= 2147483648.0f) ? (j_int)0x7FFFFFFF :
+        (v <= -2147483648.0f) ? (j_int)0x80000000 : (j_int)v;
+}
+
+static inline j_long dtc_f2l(j_float v) {
+    return (v != v) ? 0 : (v >= 9223372036854775808.0f) ? (j_long)0x7FFFFFFFFFFFFFFFULL :
+        (v <= -9223372036854775808.0f) ? (j_long)0x8000000000000000ULL : (j_long)v;
+}
+
+static inline j_int dtc_d2i(j_double v) {
+    return (v != v) ? 0 : (v >= 2147483648.0) ? (j_int)0x7FFFFFFF :
+        (v <= -2147483648.0) ? (j_int)0x80000000 : (j_int)v;
+}
+
+static inline j_long dtc_d2l(j_double v) {
+    return (v != v) ? 0 : (v >= 9223372036854775808.0) ? (j_long)0x7FFFFFFFFFFFFFFFULL :
+        (v <= -9223372036854775808.0) ? (j_long)0x8000000000000000ULL : (j_long)v;
+}
+
+/* The comparisons give -1 (cmpl) or 1 (cmpg) if either value is NaN */
+static inline j_int dtc_cmpl_float(j_float a, j_float b) {
+    return (a > b) - !(a >= b);
+}
+
+static inline j_int dtc_cmpg_float(j_float a, j_float b) {
+    return !(a <= b) - (a < b);
+}
+
+static inline j_int dtc_cmpl_double(j_double a, j_double b) {
+    return (a > b) - !(a >= b);
+}
+
+static inline j_int dtc_cmpg_double(j_double a, j_double b) {
+    return !(a <= b) - (a < b);
+}
+
+static inline j_int dtc_cmp_long(j_long a, j_long b) {
+    return (a > b) - (a < b);
+}
+
+)
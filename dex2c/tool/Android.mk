@@ -0,0 +1,57 @@
+# Copyright (C) 2014 Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+#
+# Host-side ahead-of-time dex2c tool, which translates all the methods of
+# dex files into C code in parallel and builds a shared object per dex file.
+#
+# This makefile must be included from dalvik/vm/Android.mk with
+#   include $(LOCAL_PATH)/dex2c/tool/Android.mk
+#
+
+ifeq ($(WITH_HOST_DALVIK),true)
+
+LOCAL_PATH := $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE := dex2c
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := \
+	Dex2cMain.cpp \
+	../DtcThreadPool.cpp \
+	../DtcArena.cpp \
+	../DtcCompilerContext.cpp \
+	../DtcDexBasicBlock.cpp \
+	../DtcDexLiveWeb.cpp \
+	../DtcDexMethod.cpp \
+	../DtcDexcode.cpp \
+	../DtcDexInsnTable.cpp \
+	../DtcDexOpcode.cpp \
+	../DtcCExpression.cpp \
+	../DtcCStatement.cpp \
+	../DtcCSymbol.cpp \
+	../DtcCSymbolTable.cpp \
+	../DtcCBasicBlock.cpp \
+	../DtcCMethod.cpp \
+	../DtcCallCell.cpp \
+	../DtcCodeBuffer.cpp \
+	../DtcDebug.cpp \
+	../DtcStats.cpp \
+	../DtcNode.cpp
+
+LOCAL_C_INCLUDES := \
+	$(JNI_H_INCLUDE) \
+	dalvik \
+	dalvik/vm \
+	dalvik/vm/dex2c \
+	external/zlib \
+	libcore/include
+
+LOCAL_CFLAGS += -Wno-unused-parameter -DDEX2C_SUPPORT
+
+LOCAL_STATIC_LIBRARIES := libdex liblog libcutils libz
+LOCAL_LDLIBS += -lpthread -ldl
+
+include $(BUILD_HOST_EXECUTABLE)
+
+endif
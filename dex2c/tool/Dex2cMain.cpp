@@ -0,0 +1,356 @@
+/*********************************************************************
+*   Dex2cMain.cpp:
+*
+*   Authors:
+*      Youngsun Han (youngsun@kiu.ac.kr)
+*      Minseong Kim (kim1144@naver.com)
+*
+*   Copyright (c) 2014
+*
+*   Compiler & Microarchitecture Laboratory (compiler.korea.ac.kr)
+**********************************************************************/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "DtcCommon.h"
+#include "DtcCMethod.h"
+#include "DtcDexMethod.h"
+#include "DtcThreadPool.h"
+#include "DtcCompilerContext.h"
+
+///////////////////////////////////////////////////////////////////////
+// Macro Definition
+///////////////////////////////////////////////////////////////////////
+
+// The suffix appended to the path of a dex file for the default output
+#define DTC_AOT_IMAGE_SUFFIX		".dtc.so"
+
+///////////////////////////////////////////////////////////////////////
+// User-defined Type Definition
+///////////////////////////////////////////////////////////////////////
+
+// A method to be translated ahead of time
+typedef struct {
+
+	// The dex file including the method
+	DexFile *pDexFile;
+
+	// The thread pool also used for the basic blocks of the large methods
+	DtcThreadPool *pPool;
+
+	// The method of the class data
+	DexMethod rDexMethod;
+
+	// The result of the translation
+	DtcError_t nError;
+
+	// The translated C code
+	DtcCodeBuffer *pCode;
+
+	// The name of the generated C function taking the argument words, which is entered
+	// through the shared entry stubs of the VM
+	string rFuncName;
+
+} DtcAotMethod_t;
+
+typedef vector<DtcAotMethod_t *> DtcAotMethodList_t;
+
+// Command line options
+typedef struct {
+
+	// The number of the worker threads (0 for the number of the online cores)
+	uint32_t nThreads;
+
+	// The output path, which is only allowed for a single input
+	const char *pOutPath;
+
+	// Stop after writing the C translation unit
+	bool_t bSourceOnly;
+
+} DtcAotOptions_t;
+
+///////////////////////////////////////////////////////////////////////
+// Static Function Definition
+///////////////////////////////////////////////////////////////////////
+
+/**
+ * This function will print out the usage of the tool.
+ */
+static void
+Usage() {
+
+	fprintf(stderr,
+		"Usage: dex2c [-j threads] [-S] [-o output] file.dex [file.dex ...]\n"
+		"  -j  the number of the worker threads (default: online cores)\n"
+		"  -S  write the C translation unit only\n"
+		"  -o  the output path (only for a single input)\n");
+}
+
+/**
+ * This function will translate a method into C code. It runs on the worker threads.
+ *
+ * @param pArg the method to be translated
+ */
+static void
+TranslateTask(void *pArg) {
+
+	DtcAotMethod_t *aotMethod = (DtcAotMethod_t *)pArg;
+
+	// Each worker reuses the arena of its own contexts over the methods
+	DtcCompilerContext *context = DtcCompilerContext::Acquire();
+	DtcCMethod *cMethod = NULL;
+
+	aotMethod->nError = context->Translate(aotMethod->pDexFile, &aotMethod->rDexMethod, 
+		aotMethod->pPool, cMethod);
+
+	if(aotMethod->nError == DTC_SUCCESS) {
+
+		aotMethod->pCode = new DtcCodeBuffer();
+		*aotMethod->pCode << cMethod;
+
+		aotMethod->rFuncName = cMethod->GetFuncName();
+	}
+
+	DtcCompilerContext::Release(context);
+}
+
+/**
+ * This function will collect all the methods having code in the given dex file.
+ *
+ * @param pDexFile the dex file
+ * @param pPool the thread pool translating the methods
+ * @param rMethods the collected methods (output)
+ */
+static void
+CollectMethods(DexFile *pDexFile, DtcThreadPool *pPool, DtcAotMethodList_t &rMethods) {
+
+	for(uint32_t i = 0; i < pDexFile->pHeader->classDefsSize; i++) {
+
+		const DexClassDef *classDef = dexGetClassDef(pDexFile, i);
+		const u1 *data = dexGetClassData(pDexFile, classDef);
+
+		if(data == NULL) continue;
+
+		DexClassData *classData = dexReadAndVerifyClassData(&data, NULL);
+
+		if(classData == NULL) {
+			DTC_ERROR(DEX2C_TAG, "CollectMethods - Invalid class data (class def: %d)", i);
+			continue;
+		}
+
+		uint32_t ndirect = classData->header.directMethodsSize;
+		uint32_t nvirtual = classData->header.virtualMethodsSize;
+
+		for(uint32_t j = 0; j < ndirect + nvirtual; j++) {
+
+			const DexMethod *dexMethod = (j < ndirect) ?
+				&classData->directMethods[j] : &classData->virtualMethods[j - ndirect];
+
+			// Abstract and native methods do not have any code
+			if(dexMethod->codeOff == 0) continue;
+
+			DtcAotMethod_t *aotMethod = new DtcAotMethod_t;
+
+			aotMethod->pDexFile = pDexFile;
+			aotMethod->pPool = pPool;
+			aotMethod->rDexMethod = *dexMethod;
+			aotMethod->nError = DTC_FAILURE;
+			aotMethod->pCode = NULL;
+
+			rMethods.push_back(aotMethod);
+		}
+
+		free(classData);
+	}
+}
+
+/**
+ * This function will write the translated methods into a C translation unit with
+ * a table mapping the dex method indices to the C functions. The checksum of the dex file
+ * tells a loader whether the image is built from the same version of the file. The VM
+ * does not load the images yet, since it needs a hook in the path opening dex files.
+ *
+ * @param pPath the path of the C translation unit
+ * @param pDexFile the dex file
+ * @param rMethods the translated methods
+ * @return the number of the methods written
+ */
+static uint32_t
+WriteUnit(const char *pPath, DexFile *pDexFile, DtcAotMethodList_t &rMethods) {
+
+	uint32_t count = 0;
+	DtcAotMethodList_t::iterator iter;
+
+	DtcCodeBuffer outFile;
+
+	if(outFile.OpenFile(pPath) != DTC_SUCCESS) {
+		return 0;
+	}
+
+	DtcCMethod::WriteHeader(outFile);
+
+	for(iter = rMethods.begin(); iter != rMethods.end(); iter++) {
+
+		if((*iter)->nError != DTC_SUCCESS) continue;
+
+		outFile << '\n' << *(*iter)->pCode;
+	}
+
+	outFile << "\nconst uint32_t dtc_dex_checksum = 0x";
+	outFile.AppendHex(pDexFile->pHeader->checksum, 8) << ";\n";
+
+	outFile << "\nconst struct { uint32_t idx; void *func; } dtc_method_table[] = {\n";
+
+	for(iter = rMethods.begin(); iter != rMethods.end(); iter++) {
+
+		if((*iter)->nError != DTC_SUCCESS) continue;
+
+		outFile << "    { " << (*iter)->rDexMethod.methodIdx << ", (void *)"
+			<< (*iter)->rFuncName.c_str() << " },\n";
+		count++;
+	}
+
+	outFile << "    { 0, 0 }\n};\n";
+	outFile << "const uint32_t dtc_method_count = " << count << ";\n";
+
+	if(outFile.CloseFile() != DTC_SUCCESS) {
+		return 0;
+	}
+
+	return count;
+}
+
+/**
+ * This function will translate all the methods of a dex file in parallel and build
+ * a shared object from them.
+ *
+ * @param pPath the path of the dex or odex file
+ * @param pPool the thread pool translating the methods
+ * @param rOptions the command line options
+ * @return error information
+ */
+static DtcError_t
+CompileDexFile(const char *pPath, DtcThreadPool *pPool, DtcAotOptions_t &rOptions) {
+
+	DtcError_t error = DTC_SUCCESS;
+
+	int fd = open(pPath, O_RDONLY);
+
+	if(fd < 0) {
+		fprintf(stderr, "dex2c: cannot open %s\n", pPath);
+		return DTC_ERROR_INVALID_PARAMETER;
+	}
+
+	struct stat st;
+
+	if(fstat(fd, &st) != 0) {
+		close(fd);
+		return DTC_ERROR_INVALID_PARAMETER;
+	}
+
+	void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if(data == MAP_FAILED) {
+		fprintf(stderr, "dex2c: cannot map %s\n", pPath);
+		return DTC_ERROR_MEMORY_ALLOC;
+	}
+
+	// The parser accepts both of the plain and the optimized dex files
+	DexFile *dexFile = dexFileParse((const u1 *)data, st.st_size, kDexParseDefault);
+
+	if(dexFile == NULL) {
+		fprintf(stderr, "dex2c: invalid dex file %s\n", pPath);
+		munmap(data, st.st_size);
+		return DTC_ERROR_INVALID_DEX_CODE;
+	}
+
+	DtcAotMethodList_t methods;
+
+	CollectMethods(dexFile, pPool, methods);
+
+	for(uint32_t i = 0; i < methods.size(); i++) {
+		pPool->Submit(TranslateTask, methods[i]);
+	}
+
+	pPool->Wait();
+
+	// Write the translation unit and build the shared object
+	string outPath = (rOptions.pOutPath != NULL) ? rOptions.pOutPath : string(pPath) + DTC_AOT_IMAGE_SUFFIX;
+	string srcPath = rOptions.bSourceOnly ? outPath : outPath + ".c";
+
+	uint32_t count = WriteUnit(srcPath.c_str(), dexFile, methods);
+
+	fprintf(stderr, "dex2c: %s - %d of %d methods translated\n", pPath, count, (uint32_t)methods.size());
+
+	if(rOptions.bSourceOnly == FALSE) {
+
+		if((error = DtcCMethod::BuildSharedObject(outPath.c_str(), srcPath.c_str())) != DTC_SUCCESS) {
+			fprintf(stderr, "dex2c: cannot compile %s\n", srcPath.c_str());
+		}
+		else {
+			unlink(srcPath.c_str());
+		}
+	}
+
+	for(uint32_t i = 0; i < methods.size(); i++) {
+		delete methods[i]->pCode;
+		delete methods[i];
+	}
+
+	dexFileFree(dexFile);
+	munmap(data, st.st_size);
+
+	return error;
+}
+
+///////////////////////////////////////////////////////////////////////
+// Main Function Definition
+///////////////////////////////////////////////////////////////////////
+
+int
+main(int argc, char **argv) {
+
+	DtcAotOptions_t options = { 0, NULL, FALSE };
+	int opt;
+
+	while((opt = getopt(argc, argv, "j:o:S")) != -1) {
+
+		switch(opt) {
+			case 'j':
+				options.nThreads = atoi(optarg);
+				break;
+			case 'o':
+				options.pOutPath = optarg;
+				break;
+			case 'S':
+				options.bSourceOnly = TRUE;
+				break;
+			default:
+				Usage();
+				return 2;
+		}
+	}
+
+	if(optind >= argc || (options.pOutPath != NULL && argc - optind > 1)) {
+		Usage();
+		return 2;
+	}
+
+	DtcThreadPool *pool = new DtcThreadPool(options.nThreads);
+
+	int result = 0;
+
+	for(int i = optind; i < argc; i++) {
+
+		if(CompileDexFile(argv[i], pool, options) != DTC_SUCCESS) {
+			result = 1;
+		}
+	}
+
+	delete pool;
+
+	return result;
+}